@@ -0,0 +1,118 @@
+//
+// simple benchmark harness for tiny_nmea
+// no external dependencies
+//
+
+#ifndef TINY_NMEA_BENCH_H
+#define TINY_NMEA_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// a benchmark body runs its operation iters times
+typedef void (*bench_fn_t)(void *arg, uint64_t iters);
+
+typedef struct {
+  char name[64];
+  uint64_t iters;          // iterations of the fastest repetition
+  double ns_per_op;        // best of BENCH_REPS
+  double mb_per_s;         // 0 if the op has no byte size, left out of the json
+  size_t bytes_per_op;
+} bench_result_t;
+
+#define BENCH_REPS 5
+#define BENCH_MAX_RESULTS 64
+
+// bench settings and results
+static uint64_t bench_min_ns = 50 * 1000 * 1000;
+static const char *bench_filter = NULL;
+static bench_result_t bench_results[BENCH_MAX_RESULTS];
+static size_t bench_result_count = 0;
+
+// keeps results alive so the compiler cannot drop the work
+static volatile uint32_t bench_sink;
+
+static inline uint64_t bench_now_ns(void) {
+  struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+  timespec_get(&ts, TIME_UTC);
+#endif
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t bench_time(bench_fn_t fn, void *arg, uint64_t iters) {
+  uint64_t start = bench_now_ns();
+  fn(arg, iters);
+  return bench_now_ns() - start;
+}
+
+// grow the iteration count until one run takes bench_min_ns,
+// then keep the fastest of BENCH_REPS runs
+// one iteration of fn may do several ops (e.g. all sentences of a stream)
+static inline void bench_run_ops(const char *name, bench_fn_t fn, void *arg,
+                                 size_t bytes_per_iter, uint32_t ops_per_iter) {
+  if (bench_filter && !strstr(name, bench_filter)) return;
+  if (bench_result_count == BENCH_MAX_RESULTS) return;
+
+  uint64_t iters = 1;
+  uint64_t elapsed = bench_time(fn, arg, iters);
+  while (elapsed < bench_min_ns) {
+    // aim a bit past the target from the last measurement
+    uint64_t next = elapsed > 0 ? iters * bench_min_ns / elapsed + iters / 2 : iters * 100;
+    if (next <= iters) next = iters * 2;
+    if (next > iters * 100) next = iters * 100;
+    iters = next;
+    elapsed = bench_time(fn, arg, iters);
+  }
+
+  uint64_t best = elapsed;
+  for (int r = 1; r < BENCH_REPS; r++) {
+    uint64_t t = bench_time(fn, arg, iters);
+    if (t < best) best = t;
+  }
+
+  bench_result_t *res = &bench_results[bench_result_count++];
+  snprintf(res->name, sizeof(res->name), "%s", name);
+  res->iters = iters;
+  res->ns_per_op = (double)best / (double)iters / ops_per_iter;
+  res->bytes_per_op = bytes_per_iter / ops_per_iter;
+  // bytes per ns is GB/s, scale to MB/s
+  res->mb_per_s = bytes_per_iter ? (double)bytes_per_iter * (double)iters / (double)best * 1000.0 : 0.0;
+
+  if (bytes_per_iter) {
+    fprintf(stderr, "  %-40s %10.1f ns/op %10.1f MB/s\n", name, res->ns_per_op, res->mb_per_s);
+  } else {
+    fprintf(stderr, "  %-40s %10.1f ns/op\n", name, res->ns_per_op);
+  }
+}
+
+static inline void bench_run(const char *name, bench_fn_t fn, void *arg, size_t bytes_per_op) {
+  bench_run_ops(name, fn, arg, bytes_per_op, 1);
+}
+
+static inline void bench_write_json(FILE *out, const char *scan_kernel) {
+  fprintf(out, "{\n");
+  fprintf(out, "  \"scan_kernel\": \"%s\",\n", scan_kernel);
+  fprintf(out, "  \"min_time_ms\": %llu,\n", (unsigned long long)(bench_min_ns / 1000000u));
+  fprintf(out, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < bench_result_count; i++) {
+    const bench_result_t *r = &bench_results[i];
+    fprintf(out, "    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f",
+            r->name, (unsigned long long)r->iters, r->ns_per_op);
+    // ops without a byte size have no throughput, leave it out rather than report 0
+    if (r->bytes_per_op) {
+      fprintf(out, ", \"bytes_per_op\": %zu, \"mb_per_s\": %.3f", r->bytes_per_op, r->mb_per_s);
+    }
+    fprintf(out, "}%s\n", i + 1 < bench_result_count ? "," : "");
+  }
+  fprintf(out, "  ]\n");
+  fprintf(out, "}\n");
+}
+
+#endif //TINY_NMEA_BENCH_H
@@ -0,0 +1,420 @@
+//
+// microbenchmarks for tiny_nmea
+// prints progress to stderr and the results as json to stdout (or -o file)
+//
+// usage: tiny_nmea_bench [-o results.json] [--min-ms 50] [--filter name] [--data dir]
+//
+
+// needed for clock_gettime
+#define _POSIX_C_SOURCE 199309L
+
+#include "bench.h"
+#include "tiny_nmea/tiny_nmea.h"
+#include "tiny_nmea/internal/delim_scan.h"
+#include "tiny_nmea/internal/parse_sentence_fields.h"
+#include "tiny_nmea/internal/ringbuf.h"
+#include "tiny_nmea/internal/sentences.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// synthetic corpus, one sentence per handler compiled in
+// X(name, handler, union member, sentence without checksum)
+// each entry is wrapped on its own so pruned builds drop it (see config.h)
+#if TINY_NMEA_ENABLE_RMC
+#define BENCH_RMC(X) X(rmc, handle_parse_rmc, rmc, "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W")
+#else
+#define BENCH_RMC(X)
+#endif
+#if TINY_NMEA_ENABLE_GGA
+#define BENCH_GGA(X) X(gga, handle_parse_gga, gga, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,")
+#else
+#define BENCH_GGA(X)
+#endif
+#if TINY_NMEA_ENABLE_GNS
+#define BENCH_GNS(X) X(gns, handle_parse_gns, gns, "$GNGNS,112257.00,3844.24011,N,00908.43828,W,AN,03,10.5,,,,")
+#else
+#define BENCH_GNS(X)
+#endif
+#if TINY_NMEA_ENABLE_GSA
+#define BENCH_GSA(X) X(gsa, handle_parse_gsa, gsa, "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1")
+#else
+#define BENCH_GSA(X)
+#endif
+#if TINY_NMEA_ENABLE_GSV
+#define BENCH_GSV(X) X(gsv, handle_parse_gsv, gsv, "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00")
+#else
+#define BENCH_GSV(X)
+#endif
+#if TINY_NMEA_ENABLE_VTG
+#define BENCH_VTG(X) X(vtg, handle_parse_vtg, vtg, "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K")
+#else
+#define BENCH_VTG(X)
+#endif
+#if TINY_NMEA_ENABLE_GLL
+#define BENCH_GLL(X) X(gll, handle_parse_gll, gll, "$GPGLL,4916.45,N,12311.12,W,225444,A")
+#else
+#define BENCH_GLL(X)
+#endif
+#if TINY_NMEA_ENABLE_ZDA
+#define BENCH_ZDA(X) X(zda, handle_parse_zda, zda, "$GPZDA,160012.71,11,03,2004,-1,00")
+#else
+#define BENCH_ZDA(X)
+#endif
+#if TINY_NMEA_ENABLE_GBS
+#define BENCH_GBS(X) X(gbs, handle_parse_gbs, gbs, "$GPGBS,235503.00,1.6,1.4,3.2,03,,-21.4,3.8")
+#else
+#define BENCH_GBS(X)
+#endif
+#if TINY_NMEA_ENABLE_GST
+#define BENCH_GST(X) X(gst, handle_parse_gst, gst, "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031")
+#else
+#define BENCH_GST(X)
+#endif
+// one handler serves both AIS sentences, take whichever is compiled in
+#if TINY_NMEA_ENABLE_VDM
+#define BENCH_AIS(X) X(ais, handle_parse_ais, ais, "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0")
+#elif TINY_NMEA_ENABLE_VDO
+#define BENCH_AIS(X) X(ais, handle_parse_ais, ais, "!AIVDO,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0")
+#else
+#define BENCH_AIS(X)
+#endif
+
+#define BENCH_SENTENCE_LIST(X) \
+    BENCH_RMC(X) BENCH_GGA(X) BENCH_GNS(X) BENCH_GSA(X) BENCH_GSV(X) BENCH_VTG(X) \
+    BENCH_GLL(X) BENCH_ZDA(X) BENCH_GBS(X) BENCH_GST(X) BENCH_AIS(X)
+
+// NULL terminated so the array is never empty, with every handler pruned
+// corpus_len is 0 and the corpus benches are skipped
+#define X_SENTENCE(name, handler, member, s) s,
+static const char *corpus[] = { BENCH_SENTENCE_LIST(X_SENTENCE) NULL };
+#undef X_SENTENCE
+static const size_t corpus_len = sizeof(corpus) / sizeof(corpus[0]) - 1;
+
+// corpus framed with checksums and CRLF, as a receiver would send it
+static char *corpus_stream;
+static size_t corpus_stream_len;
+
+static const char *recordings[] = {
+  "nmea_v23_gps_only.txt",
+  "nmea_v41_multi_gnss.txt",
+  "nmea_ais_mixed.txt",
+  "nmea_realistic_drive.txt",
+};
+
+// field level benches
+
+typedef struct {
+  const char *const *items;
+  size_t count;
+} str_set_t;
+
+// mean input bytes per op, the benches cycle through the whole set
+static size_t str_set_mean_len(const str_set_t *set) {
+  size_t total = 0;
+  for (size_t i = 0; i < set->count; i++) total += strlen(set->items[i]);
+  return total / set->count;
+}
+
+static void bench_tokenize(void *arg, uint64_t iters) {
+  (void)arg;
+  field_t fields[20];
+  uint32_t acc = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    const char *s = corpus[i % corpus_len];
+    acc += tokenize(s + 7, strlen(s + 7), fields, 20);
+  }
+  bench_sink = acc;
+}
+
+static const char *fixedpoint_fields[] = { "4807.038", "01131.000", "022.4", "545.4", "-21.4", "0.9", "10.5", "273.6" };
+static const char *time_fields[] = { "123519", "235503.00", "172814.0", "160012.71", "000000", "225444" };
+
+static void bench_fixedpoint(void *arg, uint64_t iters) {
+  const str_set_t *set = arg;
+  tiny_nmea_float_t out;
+  uint32_t acc = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    const char *s = set->items[i % set->count];
+    field_t f = { .ptr = s, .len = (uint8_t)strlen(s) };
+    parse_fixedpoint_float(&f, &out);
+    acc += (uint32_t)out.value;
+  }
+  bench_sink = acc;
+}
+
+static void bench_time_field(void *arg, uint64_t iters) {
+  const str_set_t *set = arg;
+  tiny_nmea_time_t out;
+  uint32_t acc = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    const char *s = set->items[i % set->count];
+    field_t f = { .ptr = s, .len = (uint8_t)strlen(s) };
+    parse_time(&f, &out);
+    acc += out.seconds;
+  }
+  bench_sink = acc;
+}
+
+// sentence handler benches, one per handler
+
+#define X_HANDLER_BENCH(name, handler, member, s)          \
+  static void bench_handle_##name(void *arg, uint64_t iters) { \
+    (void)arg;                                               \
+    const char *fields = (s) + 7;                            \
+    size_t len = strlen(fields);                             \
+    tiny_nmea_type_t out;                                    \
+    uint32_t acc = 0;                                        \
+    for (uint64_t i = 0; i < iters; i++) {                   \
+      acc += handler(fields, len, &out.data.member);         \
+    }                                                        \
+    bench_sink = acc;                                        \
+  }
+BENCH_SENTENCE_LIST(X_HANDLER_BENCH)
+#undef X_HANDLER_BENCH
+
+// ais payload benches, de-armor plus typed decode of each message
+
+static const char *ais_payloads[] = {
+  "15RTgt0PAso;90TKcjM8h6g208CQ",
+  "B5NJ;PP005l4ot5Isbl03wsUkP06",
+  "C5N3SRgPEnJGEBT>NhWAwwo862PaLELTBJ:V00000000S0D:R220",
+  "55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp888888888880",
+};
+
+static void bench_ais_decode(void *arg, uint64_t iters) {
+  const str_set_t *set = arg;
+  tiny_nmea_ais_bits_t bits;
+  tiny_nmea_ais_msg_t msg;
+  uint32_t acc = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    const char *s = set->items[i % set->count];
+    tiny_nmea_ais_dearmor(s, strlen(s), 0, &bits);
+    tiny_nmea_ais_decode_bits(&bits, &msg);
+    acc += msg.mmsi;
+  }
+  bench_sink = acc;
+}
+
+// ringbuf benches
+
+#define RING_CHUNK 64
+
+static void bench_ringbuf(void *arg, uint64_t iters) {
+  (void)arg;
+  static uint8_t storage[1024];
+  uint8_t chunk[RING_CHUNK] = {0};
+  ringbuf_t rb;
+  ringbuf_init(&rb, storage, sizeof(storage));
+
+  // keep the ring half full so every push and pop splits at the wrap sometimes
+  ringbuf_push(&rb, chunk, sizeof(storage) / 2, RINGBUF_PUSH_DROP);
+  uint32_t acc = 0;
+  for (uint64_t i = 0; i < iters; i++) {
+    acc += (uint32_t)ringbuf_push(&rb, chunk, RING_CHUNK, RINGBUF_PUSH_DROP);
+    acc += (uint32_t)ringbuf_pop(&rb, chunk, RING_CHUNK);
+  }
+  bench_sink = acc;
+}
+
+// end to end feed + work benches, one op is one pass over the stream
+
+typedef struct {
+  const uint8_t *data;
+  size_t len;
+  size_t chunk;                    // 0 for one tiny_nmea_parse_buffer() over all of data
+  tiny_nmea_framing_mode_t mode;
+} stream_arg_t;
+
+static uint32_t stream_parsed;
+
+static void on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)result;
+  (void)stats;
+  (void)user_data;
+  stream_parsed++;
+}
+
+static void bench_stream(void *arg, uint64_t iters) {
+  const stream_arg_t *s = arg;
+  static uint8_t ring[4096];
+  static tiny_nmea_ctx_t ctx;
+  tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+  tiny_nmea_set_framing_mode(&ctx, s->mode);
+
+  for (uint64_t i = 0; i < iters; i++) {
+    if (s->chunk == 0) {
+      tiny_nmea_parse_buffer(&ctx, s->data, s->len);
+      continue;
+    }
+    for (size_t off = 0; off < s->len; off += s->chunk) {
+      size_t n = s->len - off < s->chunk ? s->len - off : s->chunk;
+      tiny_nmea_feed(&ctx, s->data + off, n);
+      tiny_nmea_work(&ctx);
+    }
+  }
+  bench_sink = ctx.stats.sentences_parsed;
+}
+
+// count sentences in a stream once, to report per sentence numbers
+static uint32_t count_sentences(const stream_arg_t *s) {
+  stream_parsed = 0;
+  bench_stream((void *)s, 1);
+  return stream_parsed;
+}
+
+static void run_stream_bench(const char *name, stream_arg_t *s) {
+  uint32_t sentences = count_sentences(s);
+  if (sentences == 0) {
+    fprintf(stderr, "  %-40s no sentences parsed, skipped\n", name);
+    return;
+  }
+
+  // report per sentence rather than per pass
+  bench_run_ops(name, bench_stream, s, s->len, sentences);
+}
+
+static void build_corpus_stream(void) {
+  size_t cap = 0;
+  for (size_t i = 0; i < corpus_len; i++) cap += strlen(corpus[i]) + 5;
+
+  corpus_stream = malloc(cap + 1);
+  if (!corpus_stream) exit(1);
+
+  size_t pos = 0;
+  for (size_t i = 0; i < corpus_len; i++) {
+    const char *s = corpus[i];
+    size_t len = strlen(s);
+    uint8_t cs = 0;
+    for (size_t j = 1; j < len; j++) cs ^= (uint8_t)s[j];
+    pos += (size_t)sprintf(corpus_stream + pos, "%s*%02X\r\n", s, cs);
+  }
+  corpus_stream_len = pos;
+}
+
+static uint8_t *load_file(const char *dir, const char *name, size_t *len) {
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s", dir, name);
+  FILE *f = fopen(path, "rb");
+  if (!f) return NULL;
+
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *data = size > 0 ? malloc((size_t)size) : NULL;
+  if (data && fread(data, 1, (size_t)size, f) != (size_t)size) {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+
+  *len = data ? (size_t)size : 0;
+  return data;
+}
+
+// the corpus has to parse, or the numbers are measuring error paths
+static int check_corpus(void) {
+  for (size_t i = 0; i < corpus_len; i++) {
+    tiny_nmea_type_t result = {0};
+    tiny_nmea_res_t res = tiny_nmea_parse(corpus[i], &result);
+    if (res != TINY_NMEA_OK) {
+      fprintf(stderr, "corpus sentence does not parse (%d): %s\n", res, corpus[i]);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  const char *out_path = NULL;
+  const char *data_dir = "tests/data";
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+      out_path = argv[++i];
+    } else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+      bench_min_ns = strtoull(argv[++i], NULL, 10) * 1000000u;
+    } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      bench_filter = argv[++i];
+    } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+      data_dir = argv[++i];
+    } else {
+      fprintf(stderr, "usage: %s [-o results.json] [--min-ms 50] [--filter name] [--data dir]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  if (check_corpus() != 0) return 1;
+  build_corpus_stream();
+
+  size_t corpus_bytes = 0;
+  for (size_t i = 0; i < corpus_len; i++) corpus_bytes += strlen(corpus[i]) - 7;
+
+  fprintf(stderr, "tiny_nmea bench (scan kernel: %s)\n", delim_scan_kernel_name());
+
+  // fields
+  if (corpus_len > 0) {
+    bench_run("tokenize", bench_tokenize, NULL, corpus_bytes / corpus_len);
+  }
+
+  str_set_t fixedpoint_set = { fixedpoint_fields, sizeof(fixedpoint_fields) / sizeof(fixedpoint_fields[0]) };
+  bench_run("parse_fixedpoint_float", bench_fixedpoint, &fixedpoint_set, str_set_mean_len(&fixedpoint_set));
+
+  str_set_t time_set = { time_fields, sizeof(time_fields) / sizeof(time_fields[0]) };
+  bench_run("parse_time", bench_time_field, &time_set, str_set_mean_len(&time_set));
+
+  // handlers
+#define X_HANDLER_RUN(name, handler, member, s) \
+  bench_run("handle_parse_" #name, bench_handle_##name, NULL, strlen(s) - 7);
+  BENCH_SENTENCE_LIST(X_HANDLER_RUN)
+#undef X_HANDLER_RUN
+
+  // ais
+  str_set_t ais_set = { ais_payloads, sizeof(ais_payloads) / sizeof(ais_payloads[0]) };
+  bench_run("ais_decode", bench_ais_decode, &ais_set, str_set_mean_len(&ais_set));
+
+  // ringbuf, one op is one push and one pop of RING_CHUNK bytes
+  bench_run("ringbuf_push_pop", bench_ringbuf, NULL, RING_CHUNK);
+
+  // end to end over the synthetic corpus, an empty one parses nothing and is skipped
+  stream_arg_t copy = { (const uint8_t *)corpus_stream, corpus_stream_len, 256, TINY_NMEA_FRAMING_COPY };
+  run_stream_bench("feed_work/synthetic/copy", &copy);
+  stream_arg_t in_place = { (const uint8_t *)corpus_stream, corpus_stream_len, 256, TINY_NMEA_FRAMING_IN_PLACE };
+  run_stream_bench("feed_work/synthetic/in_place", &in_place);
+  stream_arg_t buffer = { (const uint8_t *)corpus_stream, corpus_stream_len, 0, TINY_NMEA_FRAMING_COPY };
+  run_stream_bench("parse_buffer/synthetic", &buffer);
+
+  // end to end over the recordings, when present
+  for (size_t i = 0; i < sizeof(recordings) / sizeof(recordings[0]); i++) {
+    size_t len;
+    uint8_t *data = load_file(data_dir, recordings[i], &len);
+    if (!data) {
+      fprintf(stderr, "  %-40s not found in %s, skipped\n", recordings[i], data_dir);
+      continue;
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "feed_work/%s", recordings[i]);
+    stream_arg_t rec = { data, len, 256, TINY_NMEA_FRAMING_COPY };
+    run_stream_bench(name, &rec);
+    snprintf(name, sizeof(name), "parse_buffer/%s", recordings[i]);
+    stream_arg_t rec_buffer = { data, len, 0, TINY_NMEA_FRAMING_COPY };
+    run_stream_bench(name, &rec_buffer);
+    free(data);
+  }
+
+  FILE *out = stdout;
+  if (out_path) {
+    out = fopen(out_path, "w");
+    if (!out) {
+      fprintf(stderr, "could not open %s\n", out_path);
+      return 1;
+    }
+  }
+  bench_write_json(out, delim_scan_kernel_name());
+  if (out != stdout) fclose(out);
+
+  free(corpus_stream);
+  return 0;
+}
@@ -0,0 +1,346 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// ais payload decoding
+// VDM/VDO sentences carry the ais message as 6-bit armored ascii, this
+// de-armors it into a packed bit buffer and unpacks the common message
+// types into typed structs. multi-fragment messages (type 5 usually is)
+// are joined by the reassembly table first
+
+#ifndef TINY_NMEA_AIS_H
+#define TINY_NMEA_AIS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "internal/config.h"
+#include "internal/nmea_0183_types.h"
+
+// longest ais message is 5 slots, 1008 bits or 168 armored chars
+#define TINY_NMEA_AIS_MAX_BITS 1008
+#define TINY_NMEA_AIS_MAX_CHARS (TINY_NMEA_AIS_MAX_BITS / 6)
+
+// VDM/VDO fragment count is a single digit
+#define TINY_NMEA_AIS_MAX_FRAGMENTS 9
+
+_Static_assert((TINY_NMEA_AIS_REASM_SLOTS & (TINY_NMEA_AIS_REASM_SLOTS - 1)) == 0 &&
+               TINY_NMEA_AIS_REASM_SLOTS <= 128,
+               "TINY_NMEA_AIS_REASM_SLOTS must be a power of two up to 128");
+
+// "not available" values of the position and motion fields
+#define TINY_NMEA_AIS_LON_NA      108600000  // 181 degrees in 1/10000 min
+#define TINY_NMEA_AIS_LAT_NA      54600000   // 91 degrees in 1/10000 min
+#define TINY_NMEA_AIS_SOG_NA      1023
+#define TINY_NMEA_AIS_COG_NA      3600
+#define TINY_NMEA_AIS_HEADING_NA  511
+#define TINY_NMEA_AIS_ROT_NA      (-128)
+
+// de-armored payload, bits are packed msb first
+// bytes past bit_len are zero so reads past the end give 0
+typedef struct {
+  uint8_t bytes[TINY_NMEA_AIS_MAX_BITS / 8 + 5];  // + room for the 5 byte reader window
+  uint16_t bit_len;
+} tiny_nmea_ais_bits_t;
+
+// ship dimensions from the reference point, in meters
+typedef struct {
+  uint16_t to_bow;
+  uint16_t to_stern;
+  uint8_t to_port;
+  uint8_t to_starboard;
+} tiny_nmea_ais_dims_t;
+
+// types 1, 2, 3 - class A position report
+typedef struct {
+  uint8_t nav_status;        // 0-15, 15 = not defined
+  int8_t rot;                // raw rate of turn indicator, TINY_NMEA_AIS_ROT_NA if not available
+  uint16_t sog;              // speed over ground in 1/10 knot
+  bool accuracy;             // true if better than 10 m
+  int32_t lon;               // 1/10000 minute, east positive
+  int32_t lat;               // 1/10000 minute, north positive
+  uint16_t cog;              // course over ground in 1/10 degree
+  uint16_t heading;          // true heading in degrees
+  uint8_t second;            // utc second of the report, 60-63 if not available
+  uint8_t maneuver;          // 0 = not available, 1 = none, 2 = special
+  bool raim;
+  uint32_t radio;            // 19 bit communication state
+} tiny_nmea_ais_pos_report_t;
+
+// type 5 - static and voyage related data
+typedef struct {
+  uint8_t ais_version;
+  uint32_t imo;
+  char callsign[8];
+  char shipname[21];
+  uint8_t ship_type;
+  tiny_nmea_ais_dims_t dims;
+  uint8_t epfd;              // position fix device type
+  uint8_t eta_month;         // 0 if not available
+  uint8_t eta_day;           // 0 if not available
+  uint8_t eta_hour;          // 24 if not available
+  uint8_t eta_minute;        // 60 if not available
+  uint8_t draught;           // 1/10 meter
+  char destination[21];
+  bool dte;                  // true if data terminal not ready
+} tiny_nmea_ais_static_voyage_t;
+
+// type 18 - standard class B position report
+typedef struct {
+  uint16_t sog;              // speed over ground in 1/10 knot
+  bool accuracy;
+  int32_t lon;               // 1/10000 minute
+  int32_t lat;               // 1/10000 minute
+  uint16_t cog;              // 1/10 degree
+  uint16_t heading;          // degrees
+  uint8_t second;
+  bool cs_unit;              // true if carrier sense unit
+  bool display;
+  bool dsc;
+  bool band;
+  bool msg22;
+  bool assigned;
+  bool raim;
+  uint32_t radio;            // 20 bit communication state
+} tiny_nmea_ais_class_b_pos_t;
+
+// type 19 - extended class B position report
+typedef struct {
+  uint16_t sog;
+  bool accuracy;
+  int32_t lon;
+  int32_t lat;
+  uint16_t cog;
+  uint16_t heading;
+  uint8_t second;
+  char shipname[21];
+  uint8_t ship_type;
+  tiny_nmea_ais_dims_t dims;
+  uint8_t epfd;
+  bool raim;
+  bool dte;
+  bool assigned;
+} tiny_nmea_ais_class_b_ext_t;
+
+// type 21 - aid to navigation report
+typedef struct {
+  uint8_t aid_type;
+  char name[35];             // 20 chars plus up to 14 from the name extension
+  bool accuracy;
+  int32_t lon;
+  int32_t lat;
+  tiny_nmea_ais_dims_t dims;
+  uint8_t epfd;
+  uint8_t second;
+  bool off_position;
+  bool raim;
+  bool virtual_aid;
+  bool assigned;
+} tiny_nmea_ais_aton_t;
+
+// type 24 - static data report, sent as part A and part B
+typedef struct {
+  uint8_t part_num;          // 0 = part A, 1 = part B
+  // part A
+  char shipname[21];
+  // part B
+  uint8_t ship_type;
+  char vendor_id[4];
+  uint8_t model;
+  uint32_t serial;
+  char callsign[8];
+  tiny_nmea_ais_dims_t dims;  // not set for auxiliary craft
+  uint32_t mothership_mmsi;   // only set for auxiliary craft (mmsi 98xxxxxxx)
+} tiny_nmea_ais_static_data_t;
+
+typedef struct {
+  uint8_t type;              // message id 1-27
+  uint8_t repeat;
+  uint32_t mmsi;
+
+  // only one will be valid based on type
+  union {
+    tiny_nmea_ais_pos_report_t pos;             // 1, 2, 3
+    tiny_nmea_ais_static_voyage_t voyage;       // 5
+    tiny_nmea_ais_class_b_pos_t class_b;        // 18
+    tiny_nmea_ais_class_b_ext_t class_b_ext;    // 19
+    tiny_nmea_ais_aton_t aton;                  // 21
+    tiny_nmea_ais_static_data_t static_data;    // 24
+  } data;
+} tiny_nmea_ais_msg_t;
+
+/**
+ * de-armor a 6-bit ascii payload into packed bits
+ * the payloads of a multi-fragment message can be passed one after the
+ * other, with the fill bits of the last one
+ *
+ * @param payload   armored payload chars
+ * @param len       num of chars, at most TINY_NMEA_AIS_MAX_CHARS
+ * @param fill_bits bits to drop at the end (0-5)
+ * @param out       packed bits
+ * @return          TINY_NMEA_OK, TINY_NMEA_ERR_INVALID_FORMAT on a char outside
+ *                  the armor alphabet, TINY_NMEA_ERR_OVERFLOW if too long
+ */
+tiny_nmea_res_t tiny_nmea_ais_dearmor(const char *payload, size_t len, uint8_t fill_bits,
+                                      tiny_nmea_ais_bits_t *out);
+
+/**
+ * read an unsigned field of width 1-32 bits starting at bit start
+ */
+static inline uint32_t tiny_nmea_ais_get_uint(const tiny_nmea_ais_bits_t *b, uint16_t start, uint8_t width) {
+  if (width == 0 || width > 32 || start + width > TINY_NMEA_AIS_MAX_BITS) return 0;
+
+  // 5 bytes cover any 32 bit field at any bit offset
+  const uint8_t *p = &b->bytes[start >> 3];
+  uint64_t w = ((uint64_t)p[0] << 32) | ((uint64_t)p[1] << 24) | ((uint64_t)p[2] << 16) |
+               ((uint64_t)p[3] << 8) | (uint64_t)p[4];
+  w >>= 40 - (start & 7) - width;
+  return (uint32_t)(w & ((1ULL << width) - 1));
+}
+
+/**
+ * read a two's complement field of width 1-32 bits starting at bit start
+ */
+static inline int32_t tiny_nmea_ais_get_int(const tiny_nmea_ais_bits_t *b, uint16_t start, uint8_t width) {
+  uint32_t u = tiny_nmea_ais_get_uint(b, start, width);
+  if (width > 0 && width < 32 && (u >> (width - 1))) {
+    u |= ~0u << width;  // sign extend
+  }
+  return (int32_t)u;
+}
+
+/**
+ * read a 6-bit text field of nchars chars into out
+ * stops at the first '@' terminator and strips trailing spaces
+ *
+ * @param b         packed bits
+ * @param start     first bit of the field
+ * @param nchars    num of 6-bit chars in the field
+ * @param out       output string, always null terminated
+ * @param out_size  size of out
+ * @return          length of the string
+ */
+size_t tiny_nmea_ais_get_text(const tiny_nmea_ais_bits_t *b, uint16_t start, uint8_t nchars,
+                              char *out, size_t out_size);
+
+/**
+ * decode a de-armored message into its typed struct
+ *
+ * @param bits      packed bits from tiny_nmea_ais_dearmor()
+ * @param out       decoded message, type/repeat/mmsi are set for any type
+ * @return          TINY_NMEA_OK, TINY_NMEA_ERR_TOO_FEW_FIELDS if the message is
+ *                  shorter than its type requires, TINY_NMEA_ERR_UNSUPPORTED
+ *                  for message types without a struct
+ */
+tiny_nmea_res_t tiny_nmea_ais_decode_bits(const tiny_nmea_ais_bits_t *bits, tiny_nmea_ais_msg_t *out);
+
+/**
+ * de-armor and decode a single-fragment VDM/VDO
+ *
+ * @param ais       parsed VDM/VDO sentence
+ * @param out       decoded message
+ * @return          as tiny_nmea_ais_decode_bits(), TINY_NMEA_ERR_INCOMPLETE
+ *                  for a fragment of a multi-fragment message
+ */
+tiny_nmea_res_t tiny_nmea_ais_decode(const tiny_nmea_ais_t *ais, tiny_nmea_ais_msg_t *out);
+
+// fragment reassembly
+// a fixed size open addressing table keyed by (talker, sentence type, channel,
+// sequential id) collects the fragments of multi-sentence messages and hands
+// out the joined payload once all of them arrived. no allocation, a full table
+// evicts the oldest message in flight
+
+// complete armored payload, joined from its fragments in fragment order
+typedef struct {
+  tiny_nmea_talker_t talker;
+  tiny_nmea_sentence_type_t type;   // VDM or VDO
+  char channel;
+  uint8_t fill_bits;                // of the last fragment
+  uint8_t len;
+  char payload[TINY_NMEA_AIS_MAX_CHARS + 1];
+} tiny_nmea_ais_payload_t;
+
+typedef struct {
+  bool used;
+  uint8_t home;                     // hashed slot index of the key
+  tiny_nmea_talker_t talker;
+  tiny_nmea_sentence_type_t type;
+  char channel;
+  uint8_t sequential_id;
+  uint8_t fragment_count;
+  uint16_t received;                // bit per fragment number - 1
+  uint8_t fill_bits;
+  uint8_t len;                      // chars stored in payload
+  uint8_t frag_off[TINY_NMEA_AIS_MAX_FRAGMENTS];
+  uint8_t frag_len[TINY_NMEA_AIS_MAX_FRAGMENTS];
+  uint32_t first_ms;                // time the first fragment arrived
+  char payload[TINY_NMEA_AIS_MAX_CHARS];  // fragments in arrival order
+} tiny_nmea_ais_reasm_slot_t;
+
+typedef struct {
+  uint32_t completed;               // payloads handed out, single fragment ones included
+  uint32_t timed_out;               // incomplete messages dropped after the timeout
+  uint32_t evicted;                 // incomplete messages dropped to make room
+  uint32_t dropped;                 // invalid, duplicate, inconsistent or overlong fragments
+} tiny_nmea_ais_reasm_stats_t;
+
+typedef struct {
+  tiny_nmea_ais_reasm_slot_t slots[TINY_NMEA_AIS_REASM_SLOTS];
+  uint32_t timeout_ms;
+  uint8_t active;
+  tiny_nmea_ais_reasm_stats_t stats;
+} tiny_nmea_ais_reasm_t;
+
+/**
+ * initialize a reassembly table
+ *
+ * @param r           table
+ * @param timeout_ms  time after the first fragment before giving up
+ *                    on a message, 0 for TINY_NMEA_AIS_REASM_TIMEOUT_MS
+ * @return            TINY_NMEA_OK if initialized successfully
+ */
+tiny_nmea_res_t tiny_nmea_ais_reasm_init(tiny_nmea_ais_reasm_t *r, uint32_t timeout_ms);
+
+/**
+ * add a parsed VDM/VDO sentence
+ * single-fragment messages are handed out straight away
+ *
+ * @param r         table
+ * @param sentence  parsed sentence, VDM or VDO
+ * @param now_ms    current time in milliseconds, wrap around is fine
+ * @param out       joined payload, only written when complete
+ * @return          TINY_NMEA_OK if out holds a complete payload,
+ *                  TINY_NMEA_ERR_INCOMPLETE if the fragment was stored,
+ *                  TINY_NMEA_INVALID_ARGS if not a VDM/VDO,
+ *                  TINY_NMEA_ERR_INVALID_FORMAT for bad fragment numbering,
+ *                  TINY_NMEA_ERR_OVERFLOW if the joined payload is too long
+ */
+tiny_nmea_res_t tiny_nmea_ais_reasm_add(tiny_nmea_ais_reasm_t *r, const tiny_nmea_type_t *sentence,
+                                        uint32_t now_ms, tiny_nmea_ais_payload_t *out);
+
+/**
+ * drop incomplete messages older than the timeout
+ * also done on every add, call it when the feed goes quiet
+ *
+ * @return          num of messages dropped
+ */
+uint8_t tiny_nmea_ais_reasm_expire(tiny_nmea_ais_reasm_t *r, uint32_t now_ms);
+
+/**
+ * de-armor and decode a joined payload
+ *
+ * @param payload   payload from tiny_nmea_ais_reasm_add()
+ * @param out       decoded message
+ * @return          as tiny_nmea_ais_decode_bits()
+ */
+tiny_nmea_res_t tiny_nmea_ais_decode_payload(const tiny_nmea_ais_payload_t *payload, tiny_nmea_ais_msg_t *out);
+
+/**
+ * convert an ais position in 1/10000 minute to decimal degrees
+ */
+static inline double tiny_nmea_ais_to_degrees(int32_t raw) {
+  return (double)raw / 600000.0;
+}
+
+#endif //TINY_NMEA_AIS_H
@@ -18,6 +18,116 @@
 #define TINY_NMEA_WORKING_BUF_LEN 128
 #endif
 
+// sentence types with a parser compiled in, 0 drops the handler and the
+// member of the tiny_nmea_type_t union, so results of a pruned build are
+// only as large as the biggest enabled sentence. disabled types are still
+// recognized by the framer and skipped like filtered ones
+// e.g. -DTINY_NMEA_ENABLE_ALL_SENTENCES=0 -DTINY_NMEA_ENABLE_RMC=1 for an RMC only build
+#ifndef TINY_NMEA_ENABLE_ALL_SENTENCES
+#define TINY_NMEA_ENABLE_ALL_SENTENCES 1
+#endif
+#ifndef TINY_NMEA_ENABLE_RMC
+#define TINY_NMEA_ENABLE_RMC TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GGA
+#define TINY_NMEA_ENABLE_GGA TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GNS
+#define TINY_NMEA_ENABLE_GNS TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GSA
+#define TINY_NMEA_ENABLE_GSA TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GSV
+#define TINY_NMEA_ENABLE_GSV TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_VTG
+#define TINY_NMEA_ENABLE_VTG TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GLL
+#define TINY_NMEA_ENABLE_GLL TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_ZDA
+#define TINY_NMEA_ENABLE_ZDA TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GBS
+#define TINY_NMEA_ENABLE_GBS TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_GST
+#define TINY_NMEA_ENABLE_GST TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_VDM
+#define TINY_NMEA_ENABLE_VDM TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+#ifndef TINY_NMEA_ENABLE_VDO
+#define TINY_NMEA_ENABLE_VDO TINY_NMEA_ENABLE_ALL_SENTENCES
+#endif
+
+// the framer classifies '$', '!', '*', CR and LF with a simd kernel
+// picked from the target isa at build time (avx2, sse2 or neon)
+// define this to force the portable SWAR kernel instead
+// #define TINY_NMEA_SCAN_PORTABLE
+
+// let several producer threads push into one ringbuf (and call tiny_nmea_feed())
+// without a lock. producers claim space with a CAS on a reservation index and
+// mark their reservation committed once the bytes are copied, the consumer side
+// is unchanged and still single threaded. rings are limited to 64 KiB on 32 bit
+// targets since half of each index word holds a reservation tag
+#ifndef TINY_NMEA_ENABLE_MULTI_PRODUCER
+#define TINY_NMEA_ENABLE_MULTI_PRODUCER 0
+#endif
+
+// commit markers per multi-producer ring, power of two. bounds the reservations
+// in flight, pushes fail like on a full ring while a stalled producer holds
+// up this many later ones
+#ifndef TINY_NMEA_RINGBUF_COMMIT_SLOTS
+#define TINY_NMEA_RINGBUF_COMMIT_SLOTS 16
+#endif
+
+// power of two ringbuf, indices run freely and are masked on access so the
+// whole buffer is usable and nothing is divided. head and tail sit on their own
+// cache lines next to a cached copy of the other side's index, so the producer
+// and consumer only touch each other's line when the cached view runs out.
+// init rounds the buffer size down to a power of two
+#ifndef TINY_NMEA_RINGBUF_POW2
+#define TINY_NMEA_RINGBUF_POW2 0
+#endif
+
+// cache line size for the ringbuf padding
+#ifndef TINY_NMEA_CACHE_LINE
+#define TINY_NMEA_CACHE_LINE 64
+#endif
+
+// hot path instrumentation in tiny_nmea_work(), time spent per FSM state,
+// per sentence type parse time histograms, discarded and memmoved bytes
+// and the ring occupancy high-water mark, read with tiny_nmea_get_instrumentation()
+// costs two clock reads per FSM step so leave it off in production builds
+#ifndef TINY_NMEA_ENABLE_INSTRUMENTATION
+#define TINY_NMEA_ENABLE_INSTRUMENTATION 0
+#endif
+
+// clock for the instrumentation, must expand to a uint64_t tick count
+// defaults to the cycle counter on x86 and aarch64, else timespec_get() in ns
+// e.g. -DTINY_NMEA_INSTR_NOW()=DWT->CYCCNT on a cortex-m
+// #define TINY_NMEA_INSTR_NOW() my_cycle_counter()
+
+// log2 buckets per sentence type in the parse time histogram, bucket i
+// counts parses of [2^(i-1), 2^i) ticks, the last one everything longer
+#ifndef TINY_NMEA_INSTR_HIST_BUCKETS
+#define TINY_NMEA_INSTR_HIST_BUCKETS 16
+#endif
+
+// ais fragment reassembly table size, power of two
+// one slot per multi-fragment message in flight (per talker, channel and sequential id)
+#ifndef TINY_NMEA_AIS_REASM_SLOTS
+#define TINY_NMEA_AIS_REASM_SLOTS 8
+#endif
+
+// default time after the first fragment before an incomplete message is dropped
+#ifndef TINY_NMEA_AIS_REASM_TIMEOUT_MS
+#define TINY_NMEA_AIS_REASM_TIMEOUT_MS 2000
+#endif
+
 // maximum satellites reported in GSV, usually 4 per message, up to 12 total
 #ifndef TINY_NMEA_MAX_SATS_PER_GSV
 #define TINY_NMEA_MAX_SATS_PER_GSV 4
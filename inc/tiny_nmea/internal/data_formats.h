@@ -25,6 +25,30 @@ typedef struct {
   bool valid;
 } tiny_nmea_date_t;
 
+// compact time: milliseconds since midnight in a single uint32_t
+// a leap second (23:59:60) packs to 86400000-86400999
+// sub-millisecond digits are dropped
+typedef uint32_t tiny_nmea_time_ms_t;
+#define TINY_NMEA_TIME_MS_INVALID UINT32_MAX
+
+// compact date: bitfields in a single uint32_t, 0 if invalid
+//   bits  0-4   day (1-31)
+//   bits  5-8   month (1-12)
+//   bits  9-15  year_yy (0-99)
+//   bits 16-31  full year (0 if century unknown)
+typedef uint32_t tiny_nmea_date_packed_t;
+#define TINY_NMEA_DATE_PACKED_INVALID 0u
+
+// compact coordinate exponent byte, the value itself stays an int32_t
+//   bits 0-3    decimal exponent (0-9), 0xF if there is no value
+//   bits 4-7    hemisphere, 0 for N/E, 1 for S/W, 0xF if missing
+// so a coordinate with neither packs to TINY_NMEA_FP_EXP_INVALID
+#define TINY_NMEA_COORD_EXP_MASK   0x0Fu
+#define TINY_NMEA_COORD_HEMI_SHIFT 4
+#define TINY_NMEA_COORD_HEMI_POS   0x0u
+#define TINY_NMEA_COORD_HEMI_NEG   0x1u
+#define TINY_NMEA_COORD_HEMI_NONE  0xFu
+
 // Internally stores raw NMEA format (DDMM.MMMM / DDDMM.MMMM) as fixed-point
 // use tiny_nmea_coord_to_degrees() to convert to decimal degrees
 
@@ -57,6 +81,55 @@ static inline bool tiny_nmea_coord_valid(const tiny_nmea_coord_t *coord) {
   return coord->hemisphere != '\0' && coord->raw.scale != 0;
 }
 
+/**
+ * pack a time into milliseconds since midnight
+ *
+ * @param t         parsed time
+ * @return          ms of day, TINY_NMEA_TIME_MS_INVALID if t is not valid
+ */
+tiny_nmea_time_ms_t tiny_nmea_time_pack(const tiny_nmea_time_t *t);
+
+/**
+ * unpack milliseconds since midnight into a time
+ * @return          time with valid == false if ms is out of range
+ */
+tiny_nmea_time_t tiny_nmea_time_unpack(tiny_nmea_time_ms_t ms);
+
+/**
+ * pack a date into its bitfield form, lossless for every date the parser produces
+ * @return          packed date, TINY_NMEA_DATE_PACKED_INVALID if d is not valid
+ */
+tiny_nmea_date_packed_t tiny_nmea_date_pack(const tiny_nmea_date_t *d);
+
+/**
+ * unpack a bitfield date
+ * @return          date with valid == false for TINY_NMEA_DATE_PACKED_INVALID
+ */
+tiny_nmea_date_t tiny_nmea_date_unpack(tiny_nmea_date_packed_t p);
+
+/**
+ * pack a coordinate into a signed raw value plus an exponent byte
+ * S and W are negative, the hemisphere is also kept in the exponent byte so
+ * 0 in S/W, a value without hemisphere or a hemisphere without value all
+ * unpack to what was packed
+ *
+ * @param coord     NMEA coordinate
+ * @param exp       out: exponent and hemisphere, see TINY_NMEA_COORD_EXP_MASK
+ * @return          signed raw DDMM.MMMM * 10^exp (0 if there is no value)
+ */
+int32_t tiny_nmea_coord_pack(const tiny_nmea_coord_t *coord, uint8_t *exp);
+
+/**
+ * unpack a coordinate packed by tiny_nmea_coord_pack()
+ *
+ * @param value     signed raw value
+ * @param exp       exponent and hemisphere byte
+ * @param is_lon    true for E/W, false for N/S
+ * @return          coordinate, scale 0 and / or hemisphere '\0' where the
+ *                  packed coordinate had none
+ */
+tiny_nmea_coord_t tiny_nmea_coord_unpack(int32_t value, uint8_t exp, bool is_lon);
+
 /**
  * convert speed from knots to m/s as fixed-point
  * @param knots     speed in knots (fixed-point)
@@ -0,0 +1,62 @@
+//
+// Created by Lin Yicheng on 2/9/26.
+//
+
+// single pass classification of the structural characters
+// of an nmea stream ('$', '!', '*', CR and LF) into a bitmask
+// so the framer does not need one memchr() per delimiter
+
+#ifndef TINY_NMEA_DELIM_SCAN_H
+#define TINY_NMEA_DELIM_SCAN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "config.h"
+
+// delimiter classes, one bit each so they can be or-ed into a search set
+#define DELIM_START   0x01  // '$' or '!'
+#define DELIM_STAR    0x02  // '*'
+#define DELIM_EOL     0x04  // CR or LF
+
+// max bytes classified per block, one bit per byte
+#define DELIM_BLOCK_LEN 64
+
+#define DELIM_NPOS ((size_t)-1)
+
+// class of every byte value, 0 for non-structural
+extern const uint8_t delim_class_table[256];
+
+static inline uint8_t delim_class(uint8_t c) {
+  return delim_class_table[c];
+}
+
+/**
+ * classify a block of bytes
+ * @param p     data
+ * @param len   num of bytes, at most DELIM_BLOCK_LEN
+ * @return      bit i is set if p[i] is any structural character
+ */
+uint64_t delim_scan_block(const uint8_t *p, size_t len);
+
+/**
+ * portable (SWAR) kernel, always available
+ * same contract as delim_scan_block()
+ */
+uint64_t delim_scan_block_portable(const uint8_t *p, size_t len);
+
+/**
+ * find the first byte belonging to any of the wanted classes
+ * @param p     data
+ * @param len   num of bytes
+ * @param want  or-ed DELIM_* classes
+ * @return      offset of the match, DELIM_NPOS if none
+ */
+size_t delim_find(const uint8_t *p, size_t len, uint8_t want);
+
+/**
+ * name of the kernel selected at build time ("avx2", "sse2", "neon", "swar")
+ */
+const char *delim_scan_kernel_name(void);
+
+#endif //TINY_NMEA_DELIM_SCAN_H
@@ -0,0 +1,16 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+#ifndef TINY_NMEA_FIELD_H
+#define TINY_NMEA_FIELD_H
+
+#include <stdint.h>
+
+// one comma separated field of a sentence, points into the sentence data
+typedef struct {
+  const char* ptr;
+  uint8_t len;
+} field_t;
+
+#endif //TINY_NMEA_FIELD_H
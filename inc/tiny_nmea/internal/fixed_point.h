@@ -26,6 +26,33 @@ typedef struct {
   int32_t scale;    // divisor
 } tiny_nmea_float_t;
 
+// every scale the parser produces is a power of ten, so it is also described
+// by a decimal exponent: scale == 10^exp. the math below works on exponents
+// through lookup tables so the hot paths never divide by a runtime scale.
+// the compact form keeps that exponent in one byte next to the value
+#define TINY_NMEA_FP_EXP_MAX     9     // 10^9 is the largest int32_t power of ten
+#define TINY_NMEA_FP_EXP_INVALID 0xFF  // no value (scale == 0)
+
+// 10^exp for exp 0..TINY_NMEA_FP_EXP_MAX
+extern const int32_t tiny_nmea_pow10[TINY_NMEA_FP_EXP_MAX + 1];
+
+// reciprocals for x / 10^exp == (x * mul) >> shift
+// exact for every 0 <= x <= 2^31, which covers the magnitude of any int32_t
+extern const uint32_t tiny_nmea_pow10_recip_mul[TINY_NMEA_FP_EXP_MAX + 1];
+extern const uint8_t tiny_nmea_pow10_recip_shift[TINY_NMEA_FP_EXP_MAX + 1];
+
+/**
+ * divide by a power of ten with a multiply and a shift
+ *
+ * @param x         dividend, at most 2^31
+ * @param exp       decimal exponent, anything above TINY_NMEA_FP_EXP_MAX gives 0
+ * @return          x / 10^exp, truncated
+ */
+static inline uint32_t tiny_nmea_div_pow10(uint32_t x, uint8_t exp) {
+  if (exp > TINY_NMEA_FP_EXP_MAX) return 0;  // x < 10^10
+  return (uint32_t)(((uint64_t)x * tiny_nmea_pow10_recip_mul[exp]) >> tiny_nmea_pow10_recip_shift[exp]);
+}
+
 /**
  * convert fixed-point to float
  * @param f         Fixed-point value
@@ -55,4 +82,22 @@ tiny_nmea_float_t tiny_nmea_fp_add(const tiny_nmea_float_t *a,
                                    const tiny_nmea_float_t *b);
 tiny_nmea_float_t tiny_nmea_fp_div_int(const tiny_nmea_float_t *f, int32_t n);
 
+/**
+ * get the decimal exponent of a fixed-point value's scale
+ *
+ * @param f         Fixed-point value
+ * @return          exp with scale == 10^exp, TINY_NMEA_FP_EXP_INVALID if the
+ *                  value is invalid or its scale is not a power of ten
+ */
+uint8_t tiny_nmea_fp_exponent(const tiny_nmea_float_t *f);
+
+/**
+ * rebuild a fixed-point value from its compact form
+ *
+ * @param value     scaled value
+ * @param exp       decimal exponent, TINY_NMEA_FP_EXP_INVALID for no value
+ * @return          {value, 10^exp}, or {0, 0} if exp is out of range
+ */
+tiny_nmea_float_t tiny_nmea_fp_from_exponent(int32_t value, uint8_t exp);
+
 #endif //TINY_NMEA_FIXED_POINT_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// nmea 0183 sentence field schemas
+// X(T, field index, kind, member of T, OPTIONAL/REQUIRED), in field index order
+// fields past the received field count are skipped, which covers the
+// trailing fields newer nmea versions add. see sentence_schema.h
+
+#ifndef TINY_NMEA_NMEA_0183_SCHEMA_H
+#define TINY_NMEA_NMEA_0183_SCHEMA_H
+
+#define TINY_NMEA_RMC_SCHEMA(X, T)                    \
+    X(T,  0, TIME,       time,          OPTIONAL)     \
+    X(T,  1, STATUS,     status_valid,  OPTIONAL)     \
+    X(T,  2, LATITUDE,   latitude,      OPTIONAL)     \
+    X(T,  4, LONGITUDE,  longitude,     OPTIONAL)     \
+    X(T,  6, FLOAT,      speed_knots,   OPTIONAL)     \
+    X(T,  7, FLOAT,      course_deg,    OPTIONAL)     \
+    X(T,  8, DATE,       date,          OPTIONAL)     \
+    X(T,  9, FLOAT,      mag_variation, OPTIONAL)     \
+    X(T, 10, CHAR,       mag_var_dir,   OPTIONAL)     \
+    X(T, 11, FAA_MODE,   faa_mode,      OPTIONAL)     \
+    X(T, 12, NAV_STATUS, nav_status,    OPTIONAL)
+
+#define TINY_NMEA_GGA_SCHEMA(X, T)                      \
+    X(T,  0, TIME,       time,            OPTIONAL)     \
+    X(T,  1, LATITUDE,   latitude,        OPTIONAL)     \
+    X(T,  3, LONGITUDE,  longitude,       OPTIONAL)     \
+    X(T,  5, U8,         fix_quality,     OPTIONAL)     \
+    X(T,  6, U8,         satellites_used, OPTIONAL)     \
+    X(T,  7, FLOAT,      hdop,            OPTIONAL)     \
+    X(T,  8, FLOAT,      altitude_m,      OPTIONAL)     \
+    X(T, 10, FLOAT,      geoid_sep_m,     OPTIONAL)     \
+    X(T, 12, FLOAT,      dgps_age_sec,    OPTIONAL)     \
+    X(T, 13, U16,        dgps_station_id, OPTIONAL)
+
+// field 5 (mode per constellation) is decoded by the finish hook
+#define TINY_NMEA_GNS_SCHEMA(X, T)                      \
+    X(T,  0, TIME,       time,            OPTIONAL)     \
+    X(T,  1, LATITUDE,   latitude,        OPTIONAL)     \
+    X(T,  3, LONGITUDE,  longitude,       OPTIONAL)     \
+    X(T,  6, U8,         satellites_used, OPTIONAL)     \
+    X(T,  7, FLOAT,      hdop,            OPTIONAL)     \
+    X(T,  8, FLOAT,      altitude_m,      OPTIONAL)     \
+    X(T,  9, FLOAT,      geoid_sep_m,     OPTIONAL)     \
+    X(T, 10, FLOAT,      dgps_age_sec,    OPTIONAL)     \
+    X(T, 11, U16,        dgps_station_id, OPTIONAL)     \
+    X(T, 12, NAV_STATUS, nav_status,      OPTIONAL)
+
+// fields 2-13 (satellite prns) are decoded by the finish hook
+#define TINY_NMEA_GSA_SCHEMA(X, T)                      \
+    X(T,  0, CHAR,       mode_selection,  OPTIONAL)     \
+    X(T,  1, GSA_FIX,    fix_type,        OPTIONAL)     \
+    X(T, 14, FLOAT,      pdop,            OPTIONAL)     \
+    X(T, 15, FLOAT,      hdop,            OPTIONAL)     \
+    X(T, 16, FLOAT,      vdop,            OPTIONAL)     \
+    X(T, 17, U8,         system_id,       OPTIONAL)
+
+#define TINY_NMEA_VTG_SCHEMA(X, T)                      \
+    X(T,  0, FLOAT,      course_true_deg, OPTIONAL)     \
+    X(T,  2, FLOAT,      course_mag_deg,  OPTIONAL)     \
+    X(T,  4, FLOAT,      speed_knots,     OPTIONAL)     \
+    X(T,  6, FLOAT,      speed_kph,       OPTIONAL)     \
+    X(T,  8, FAA_MODE,   faa_mode,        OPTIONAL)
+
+#define TINY_NMEA_GLL_SCHEMA(X, T)                      \
+    X(T,  0, LATITUDE,   latitude,        OPTIONAL)     \
+    X(T,  2, LONGITUDE,  longitude,       OPTIONAL)     \
+    X(T,  4, TIME,       time,            OPTIONAL)     \
+    X(T,  5, STATUS,     status_valid,    OPTIONAL)     \
+    X(T,  6, FAA_MODE,   faa_mode,        OPTIONAL)
+
+// fields 1-3 (day, month, year) are decoded and validated by the finish hook
+// tz_minutes is unsigned but is sent as a signed field like tz_hours
+#define TINY_NMEA_ZDA_SCHEMA(X, T)                      \
+    X(T,  0, TIME,       time,            REQUIRED)     \
+    X(T,  4, I8,         tz_hours,        OPTIONAL)     \
+    X(T,  5, I8,         tz_minutes,      OPTIONAL)
+
+#define TINY_NMEA_GBS_SCHEMA(X, T)                      \
+    X(T,  0, TIME,       time,            OPTIONAL)     \
+    X(T,  1, FLOAT,      err_lat_m,       OPTIONAL)     \
+    X(T,  2, FLOAT,      err_lon_m,       OPTIONAL)     \
+    X(T,  3, FLOAT,      err_alt_m,       OPTIONAL)     \
+    X(T,  4, PRN,        failed_sat_id,   OPTIONAL)     \
+    X(T,  5, FLOAT,      prob_missed,     OPTIONAL)     \
+    X(T,  6, FLOAT,      bias_m,          OPTIONAL)     \
+    X(T,  7, FLOAT,      bias_stddev_m,   OPTIONAL)
+
+#define TINY_NMEA_GST_SCHEMA(X, T)                      \
+    X(T,  0, TIME,       time,            OPTIONAL)     \
+    X(T,  1, FLOAT,      rms_range,       OPTIONAL)     \
+    X(T,  2, FLOAT,      std_major_m,     OPTIONAL)     \
+    X(T,  3, FLOAT,      std_minor_m,     OPTIONAL)     \
+    X(T,  4, FLOAT,      orient_deg,      OPTIONAL)     \
+    X(T,  5, FLOAT,      std_lat_m,       OPTIONAL)     \
+    X(T,  6, FLOAT,      std_lon_m,       OPTIONAL)     \
+    X(T,  7, FLOAT,      std_alt_m,       OPTIONAL)
+
+#endif //TINY_NMEA_NMEA_0183_SCHEMA_H
@@ -137,6 +137,30 @@ typedef struct {
   tiny_nmea_nav_status_t nav_status; // NMEA 4.1+
 } tiny_nmea_rmc_t;
 
+// compact RMC for large position histories (40 bytes instead of 72)
+// time and date are packed, the fixed-point fields keep their int32_t value
+// with a one byte decimal exponent, coordinates carry the hemisphere in the sign
+// and in the upper half of their exponent byte
+// convert with tiny_nmea_rmc_compact() / tiny_nmea_rmc_expand()
+typedef struct {
+  tiny_nmea_time_ms_t time_ms;
+  tiny_nmea_date_packed_t date;
+  int32_t latitude;                // DDMM.MMMM * 10^latitude_exp, S negative
+  int32_t longitude;               // DDDMM.MMMM * 10^longitude_exp, W negative
+  int32_t speed_knots;
+  int32_t course_deg;
+  int32_t mag_variation;
+  uint8_t latitude_exp;            // plus hemisphere, see TINY_NMEA_COORD_EXP_MASK
+  uint8_t longitude_exp;
+  uint8_t speed_knots_exp;
+  uint8_t course_deg_exp;
+  uint8_t mag_variation_exp;
+  char mag_var_dir;
+  tiny_nmea_faa_mode_t faa_mode;
+  tiny_nmea_nav_status_t nav_status;
+  bool status_valid;
+} tiny_nmea_rmc_compact_t;
+
 // GGA
 // gps fix information
 // fix quality, altitude, HDOP, satellite count
@@ -273,18 +297,42 @@ typedef struct {
   tiny_nmea_talker_t talker;
 
   // only one will be valid based on type
+  // members of sentence types disabled in config.h are left out
   union {
+#if TINY_NMEA_ENABLE_RMC
     tiny_nmea_rmc_t rmc;
+#endif
+#if TINY_NMEA_ENABLE_GGA
     tiny_nmea_gga_t gga;
+#endif
+#if TINY_NMEA_ENABLE_GNS
     tiny_nmea_gns_t gns;
+#endif
+#if TINY_NMEA_ENABLE_GSA
     tiny_nmea_gsa_t gsa;
+#endif
+#if TINY_NMEA_ENABLE_GSV
     tiny_nmea_gsv_t gsv;
+#endif
+#if TINY_NMEA_ENABLE_VTG
     tiny_nmea_vtg_t vtg;
+#endif
+#if TINY_NMEA_ENABLE_GLL
     tiny_nmea_gll_t gll;
+#endif
+#if TINY_NMEA_ENABLE_ZDA
     tiny_nmea_zda_t zda;
+#endif
+#if TINY_NMEA_ENABLE_GBS
     tiny_nmea_gbs_t gbs;
+#endif
+#if TINY_NMEA_ENABLE_GST
     tiny_nmea_gst_t gst;
+#endif
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
     tiny_nmea_ais_t ais;
+#endif
+    uint8_t none;                  // keeps the union valid with every sentence disabled
   } data;
 } tiny_nmea_type_t;
 
@@ -305,6 +353,9 @@ typedef enum {
   TINY_NMEA_ERR_BUFFER_FULL,
   TINY_NMEA_ERR_CHECKSUM,
   TINY_NMEA_ERR_UNSUPPORTED,
+  TINY_NMEA_ERR_NO_MEMORY,
+  TINY_NMEA_ERR_INCOMPLETE,
+  TINY_NMEA_ERR_TIMEOUT,
 } tiny_nmea_res_t;
 
 tiny_nmea_constellation_t parse_constellation(const char *s);
@@ -318,6 +369,17 @@ tiny_nmea_nav_status_t parse_nav_status(char c);
 const char *tiny_nmea_talker_str(tiny_nmea_talker_t t);
 const char *tiny_nmea_sentence_str(tiny_nmea_sentence_type_t t);
 
+/**
+ * convert a parsed RMC to its compact form
+ * sub-millisecond time digits are dropped, everything else round trips
+ */
+void tiny_nmea_rmc_compact(const tiny_nmea_rmc_t *rmc, tiny_nmea_rmc_compact_t *out);
+
+/**
+ * convert a compact RMC back to the parsed layout
+ */
+void tiny_nmea_rmc_expand(const tiny_nmea_rmc_compact_t *c, tiny_nmea_rmc_t *out);
+
 // use the 2 letters packed to a uint16_t number as a hash-lookup
 #define NMEA_HASH2(a, b)                     \
     (((uint16_t)(unsigned char)(a) << 8) |   \
@@ -9,6 +9,7 @@
 #include <stdint.h>
 
 #include "data_formats.h"
+#include "field.h"
 #include "fixed_point.h"
 
 #define IS_DIGIT(c)     ((uint8_t)((c) - '0') <= 9)
@@ -39,11 +40,6 @@ DEFINE_IS_N(is_nalpha,   IS_ALPHA)
 #define REQUIRE_UPPER(c)        REQUIRE(IS_UPPER(c))
 #define REQUIRE_XDIGIT(c)       REQUIRE(IS_XDIGIT(c))
 
-typedef struct {
-  const char* ptr;
-  uint8_t len;
-} field_t;
-
 bool field_empty(const field_t* f);
 
 /**
@@ -68,4 +64,32 @@ bool parse_date(const field_t* f, tiny_nmea_date_t* out);
 bool parse_latitude(const field_t* f, const field_t* dir, tiny_nmea_coord_t* out);
 bool parse_longitude(const field_t* f, const field_t* dir, tiny_nmea_coord_t* out);
 
+// single pass field scanners
+// decode the field under the cursor while looking for the comma that ends it,
+// so a sentence is walked once instead of tokenized and then parsed field by field.
+// every scanner leaves the cursor on that comma (or at end), valid or not,
+// and gives the same result as its parse_* counterpart on the same field
+typedef struct {
+  const char* pos;
+  const char* end;
+} scan_cursor_t;
+
+// cursor is on the comma ending the field or at the end of the data
+static inline bool scan_at_sep(const scan_cursor_t* c) {
+  return c->pos == c->end || *c->pos == ',';
+}
+
+void scan_skip(scan_cursor_t* c);
+bool scan_uint(scan_cursor_t* c, uint32_t* out);
+bool scan_int(scan_cursor_t* c, int32_t* out);
+bool scan_char(scan_cursor_t* c, char* out);
+bool scan_fixedpoint_float(scan_cursor_t* c, tiny_nmea_float_t* out);
+
+bool scan_time(scan_cursor_t* c, tiny_nmea_time_t* out);
+bool scan_date(scan_cursor_t* c, tiny_nmea_date_t* out);
+
+// the hemisphere is peeked from the next field, which is left for the caller
+bool scan_latitude(scan_cursor_t* c, tiny_nmea_coord_t* out);
+bool scan_longitude(scan_cursor_t* c, tiny_nmea_coord_t* out);
+
 #endif //TINY_NMEA_PARSE_DATA_TYPES_H
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 // a (hopefully) lock-free ring-buffer implementation?
 // adhering to single-producer single-consumer logic
+// with TINY_NMEA_ENABLE_MULTI_PRODUCER any number of threads may push,
+// there is still only one consumer
 
 #ifndef RINGBUF_H
 #define RINGBUF_H
@@ -16,14 +18,20 @@
 
 typedef enum {
   RINGBUF_PUSH_DROP,   // drop bytes that don't fit
-  RINGBUF_PUSH_WRAP,   // overwrite oldest data to fit entire write, NOT SPSC-safe, needs mutex or single-threaded
+  RINGBUF_PUSH_WRAP,   // overwrite oldest data to fit entire write, NOT SPSC-safe, needs mutex or single-threaded (also with multiple producers)
   RINGBUF_PUSH_ATOMIC  // all or nothing
 } ringbuf_push_mode_t;
 
 /**
  * init ringbuf with user-provided storage
+ * with TINY_NMEA_ENABLE_MULTI_PRODUCER the size is limited to RINGBUF_MAX_SIZE,
+ * 65535 bytes on 32 bit targets, larger storage is rejected instead of used in part
+ * @param rb    ringbuf
+ * @param buf   storage
+ * @param size  bytes of storage, at most RINGBUF_MAX_SIZE
+ * @return      false (and rb untouched) if size is above RINGBUF_MAX_SIZE
  */
-void ringbuf_init(ringbuf_t *rb, uint8_t *buf, size_t size);
+bool ringbuf_init(ringbuf_t *rb, uint8_t *buf, size_t size);
 
 /**
  * clear ringbuf to empty
@@ -53,6 +61,9 @@ bool ringbuf_full(const ringbuf_t *rb);
 
 /**
  * push data into ringbuf (producer operation)
+ * with TINY_NMEA_ENABLE_MULTI_PRODUCER concurrent pushes are safe and each
+ * one lands contiguously, the bytes become visible to the consumer once
+ * every earlier push has finished copying
  * @param rb    ringbuf
  * @param data  data to push
  * @param len   num of bytes
@@ -62,6 +73,28 @@ bool ringbuf_full(const ringbuf_t *rb);
  */
 size_t ringbuf_push(ringbuf_t *rb, const uint8_t *data, size_t len, ringbuf_push_mode_t mode);
 
+/**
+ * expose the free space for writing into the ring storage directly
+ * (producer operation), e.g. as the destination of read() or a DMA
+ * transfer. fill span1 first and continue into span2, then publish the
+ * bytes with ringbuf_commit(). nothing is claimed, so a ringbuf_push()
+ * in between overwrites the spans. not available with
+ * TINY_NMEA_ENABLE_MULTI_PRODUCER, where it always returns 0
+ * @param rb     ringbuf
+ * @param span1  free space from the write index, empty if full
+ * @param span2  free space continuing at the start of the storage, may be empty
+ * @return       total bytes in both spans
+ */
+size_t ringbuf_reserve(ringbuf_t *rb, ringbuf_span_t *span1, ringbuf_span_t *span2);
+
+/**
+ * publish bytes written into the spans from ringbuf_reserve() (producer operation)
+ * @param rb    ringbuf
+ * @param len   bytes written, from the start of span1 on
+ * @return      bytes actually committed, at most the free space
+ */
+size_t ringbuf_commit(ringbuf_t *rb, size_t len);
+
 /**
  * pop data from ringbuf (removes from buffer) (consumer operation)
  * @param rb    ringbuf
@@ -81,6 +114,16 @@ size_t ringbuf_pop(ringbuf_t *rb, uint8_t *data, size_t len);
  */
 size_t ringbuf_peek(const ringbuf_t *rb, uint8_t *data, size_t len, size_t offset);
 
+/**
+ * expose the readable data in place without copying (consumer operation)
+ * scan span1 then span2, then release what was used with ringbuf_discard()
+ * @param rb     ringbuf
+ * @param span1  data from the read index, empty if the ringbuf is empty
+ * @param span2  data continuing at the start of the storage, may be empty
+ * @return       total bytes in both spans
+ */
+size_t ringbuf_peek_spans(const ringbuf_t *rb, ringbuf_span_t *span1, ringbuf_span_t *span2);
+
 /**
  * peek single byte at offset
  * @param rb      ringbuf
@@ -92,6 +135,7 @@ bool ringbuf_peek_byte(const ringbuf_t *rb, size_t offset, uint8_t *out);
 
 /**
  * discard bytes from front of ringbuf (consumer operation)
+ * this is the consumer commit for ringbuf_peek_spans()
  * @param rb    ringbuf
  * @param len   bytes to discard
  * @return      bytes actually discarded
@@ -9,12 +9,58 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "config.h"
+
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+_Static_assert((TINY_NMEA_RINGBUF_COMMIT_SLOTS & (TINY_NMEA_RINGBUF_COMMIT_SLOTS - 1)) == 0 &&
+               TINY_NMEA_RINGBUF_COMMIT_SLOTS >= 2 && TINY_NMEA_RINGBUF_COMMIT_SLOTS <= 256,
+               "TINY_NMEA_RINGBUF_COMMIT_SLOTS must be a power of two from 2 to 256");
+#endif
+
+// largest storage a ringbuf can index, with TINY_NMEA_ENABLE_MULTI_PRODUCER
+// half of each index word holds a reservation tag, so 65535 bytes on 32 bit
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+#define RINGBUF_MAX_SIZE (((size_t)1 << (sizeof(size_t) * 4)) - 1)
+#else
+#define RINGBUF_MAX_SIZE SIZE_MAX
+#endif
+
+// with TINY_NMEA_RINGBUF_POW2 a full line of padding keeps the producer and
+// consumer fields apart, which works without aligning the containing struct
 typedef struct {
   uint8_t *buf;
   size_t size;           // total buffer size
+#if TINY_NMEA_RINGBUF_POW2
+  size_t mask;           // size - 1, indices are free running
+  char pad_producer[TINY_NMEA_CACHE_LINE];
+#endif
   _Atomic size_t head;   // write index (modified by producer)
+#if TINY_NMEA_RINGBUF_POW2
+  size_t tail_cache;     // producer's last look at tail
+#endif
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  // with multiple producers head only covers committed bytes and carries the tag
+  // of the next reservation to publish in its upper half, reserve is the next
+  // free byte and tag to hand out. commit holds the tag and end index of each
+  // reservation in flight once its bytes are written
+  _Atomic size_t reserve;
+  _Atomic size_t commit[TINY_NMEA_RINGBUF_COMMIT_SLOTS];
+#endif
+#if TINY_NMEA_RINGBUF_POW2
+  char pad_consumer[TINY_NMEA_CACHE_LINE];
+#endif
   _Atomic size_t tail;   // read index (modified by consumer)
+#if TINY_NMEA_RINGBUF_POW2
+  size_t head_cache;     // consumer's last look at head
+  char pad_end[TINY_NMEA_CACHE_LINE];
+#endif
 } ringbuf_t;
 
+// a contiguous run of ring storage, the wrap point splits a region in two
+typedef struct {
+  uint8_t *ptr;
+  size_t len;
+} ringbuf_span_t;
+
 
 #endif //TINY_NMEA_RINGBUF_TYPE_H
\ No newline at end of file
@@ -0,0 +1,129 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// declarative field schemas for flat sentences
+// a schema lists which field index decodes into which struct member and how,
+// handle_parse_schema() walks the sentence once and decodes each listed field
+// as it passes it, so entries must be in ascending index order. sentence types
+// with repeating groups (GSV) or free form payloads (AIS) keep their own handler,
+// the few irregular fields of the others go through a finish hook
+
+#ifndef TINY_NMEA_SENTENCE_SCHEMA_H
+#define TINY_NMEA_SENTENCE_SCHEMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "field.h"
+#include "nmea_0183_types.h"
+
+// field kinds the generic decoder understands
+// X(KIND, destination c type)
+// LATITUDE and LONGITUDE also consume the hemisphere field after them
+#define TINY_NMEA_FIELD_KIND_LIST(X)          \
+    X(TIME,       tiny_nmea_time_t)           \
+    X(DATE,       tiny_nmea_date_t)           \
+    X(LATITUDE,   tiny_nmea_coord_t)          \
+    X(LONGITUDE,  tiny_nmea_coord_t)          \
+    X(FLOAT,      tiny_nmea_float_t)          \
+    X(CHAR,       char)                       \
+    X(STATUS,     bool)                       \
+    X(U8,         uint8_t)                    \
+    X(U16,        uint16_t)                   \
+    X(I8,         int8_t)                     \
+    X(PRN,        TINY_NMEA_PRN_TYPE)         \
+    X(FAA_MODE,   tiny_nmea_faa_mode_t)       \
+    X(NAV_STATUS, tiny_nmea_nav_status_t)     \
+    X(GSA_FIX,    tiny_nmea_gsa_fix_t)
+
+#define X_KIND(kind, ctype) TINY_NMEA_KIND_##kind,
+typedef enum {
+  TINY_NMEA_FIELD_KIND_LIST(X_KIND)
+  TINY_NMEA_KIND_COUNT
+} tiny_nmea_field_kind_t;
+#undef X_KIND
+
+// destination size per kind, checked against the struct member at compile time
+#define X_KIND_SIZE(kind, ctype) TINY_NMEA_KIND_SIZE_##kind = sizeof(ctype),
+enum { TINY_NMEA_FIELD_KIND_LIST(X_KIND_SIZE) };
+#undef X_KIND_SIZE
+
+// OPTIONAL fields are left zeroed if empty or invalid,
+// REQUIRED fields fail the sentence with the kind's error
+typedef enum {
+  TINY_NMEA_FIELD_OPTIONAL = 0,
+  TINY_NMEA_FIELD_REQUIRED
+} tiny_nmea_field_flag_t;
+
+// largest field count of any schema (GSV)
+#define TINY_NMEA_SCHEMA_MAX_FIELDS 20
+
+typedef struct {
+  uint8_t index;        // field index after the address field
+  uint8_t kind;         // tiny_nmea_field_kind_t
+  uint8_t flags;        // tiny_nmea_field_flag_t
+  uint16_t offset;      // offset of the member in the output struct
+} tiny_nmea_field_schema_t;
+
+// decode the fields a flat schema cannot describe, runs after the schema fields
+typedef tiny_nmea_res_t (*tiny_nmea_schema_finish_t)(const field_t *fields, uint8_t count, void *data);
+
+typedef struct {
+  const tiny_nmea_field_schema_t *entries;
+  uint8_t entry_count;
+  uint8_t min_fields;
+  uint8_t max_fields;
+  size_t size;                        // size of the output struct, zeroed before decoding
+  tiny_nmea_schema_finish_t finish;   // NULL if every field is in the table
+} tiny_nmea_sentence_schema_t;
+
+// schema list entries are X(T, index, KIND, member, FLAG), T being the output struct
+#define TINY_NMEA_SCHEMA_ENTRY(T, idx, k, member, flag)           \
+  { .index = (idx), .kind = TINY_NMEA_KIND_##k,                    \
+    .flags = TINY_NMEA_FIELD_##flag, .offset = (uint16_t)offsetof(T, member) },
+
+#define TINY_NMEA_SCHEMA_CHECK(T, idx, kind, member, flag)                          \
+  _Static_assert(sizeof(((T *)0)->member) == TINY_NMEA_KIND_SIZE_##kind,             \
+                 #T "." #member " does not match field kind " #kind);                \
+  _Static_assert((idx) < TINY_NMEA_SCHEMA_MAX_FIELDS, #T "." #member " index out of range");
+
+/**
+ * define a static const schema from a schema list
+ * @param name      name of the schema variable
+ * @param T         output struct type
+ * @param list      schema list macro, list(X, T)
+ * @param min       minimum field count
+ * @param max       maximum field count
+ * @param finish_fn finish hook or NULL
+ */
+#define TINY_NMEA_DEFINE_SCHEMA(name, T, list, min, max, finish_fn)                  \
+  list(TINY_NMEA_SCHEMA_CHECK, T)                                                    \
+  _Static_assert((max) <= TINY_NMEA_SCHEMA_MAX_FIELDS, #name " has too many fields"); \
+  static const tiny_nmea_field_schema_t name##_entries[] = { list(TINY_NMEA_SCHEMA_ENTRY, T) }; \
+  static const tiny_nmea_sentence_schema_t name = {                                  \
+    .entries = name##_entries,                                                       \
+    .entry_count = (uint8_t)(sizeof(name##_entries) / sizeof(name##_entries[0])),    \
+    .min_fields = (min),                                                             \
+    .max_fields = (max),                                                             \
+    .size = sizeof(T),                                                               \
+    .finish = (finish_fn),                                                           \
+  }
+
+/**
+ * decode a sentence with a field schema
+ * also the way to add proprietary sentences without a new handler
+ * TINY_NMEA_INVALID_ARGS if the entries are out of order or a coordinate
+ * is the last field, leaving no room for its hemisphere
+ *
+ * @param schema    field schema
+ * @param sentence  sentence data from the first field, stripped comma
+ * @param len       length of the sentence data
+ * @param data      output struct, schema->size bytes
+ * @return          TINY_NMEA_OK if parsed successfully
+ */
+tiny_nmea_res_t handle_parse_schema(const tiny_nmea_sentence_schema_t *schema,
+                                    const char *sentence, size_t len, void *data);
+
+#endif //TINY_NMEA_SENTENCE_SCHEMA_H
@@ -7,6 +7,7 @@
 
 #include "../tiny_nmea.h"
 
+// handlers are only built for the sentence types enabled in config.h
 tiny_nmea_res_t handle_parse_rmc(const char *sentence, size_t len, tiny_nmea_rmc_t *data);
 tiny_nmea_res_t handle_parse_gga(const char *sentence, size_t len, tiny_nmea_gga_t *data);
 tiny_nmea_res_t handle_parse_gns(const char *sentence, size_t len, tiny_nmea_gns_t *data);
@@ -19,4 +20,9 @@ tiny_nmea_res_t handle_parse_gbs(const char *sentence, size_t len, tiny_nmea_gbs
 tiny_nmea_res_t handle_parse_gst(const char *sentence, size_t len, tiny_nmea_gst_t *data);
 tiny_nmea_res_t handle_parse_ais(const char *sentence, size_t len, tiny_nmea_ais_t *data);
 
+// field count bounds the handlers enforce, for callers that tokenize themselves
+// 0 for sentence types without a handler
+uint8_t handle_min_fields(tiny_nmea_sentence_type_t type);
+uint8_t handle_max_fields(tiny_nmea_sentence_type_t type);
+
 #endif //TINY_NMEA_SENTENCES_H
\ No newline at end of file
@@ -0,0 +1,378 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// SWAR (simd within a register) decimal digit kernels
+// up to 8 ascii digits are loaded into one uint64_t, validated with a few
+// masks and converted with three multiply-shift steps instead of one
+// multiply, add and overflow check per digit
+//
+// loads never read past p[n - 1], fields can end right at the buffer end
+
+#ifndef TINY_NMEA_SWAR_DIGITS_H
+#define TINY_NMEA_SWAR_DIGITS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "data_formats.h"
+#include "util.h"
+
+// TINY_NMEA_SCAN_PORTABLE only picks the kernel in delim_scan.c,
+// the digit kernels are portable already and only need little endian
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+  #define SWAR_DIGITS_LE
+#endif
+
+#define SWAR_DIGITS_ONES   0x0101010101010101ULL
+#define SWAR_DIGITS_HIGH   0x8080808080808080ULL
+#define SWAR_DIGITS_LOW7   0x7F7F7F7F7F7F7F7FULL
+#define SWAR_DIGITS_ZEROS  0x3030303030303030ULL
+
+#ifdef SWAR_DIGITS_LE
+
+// p[0..n) into the low n bytes, p[0] in byte 0, the rest zero
+// 1-3 and 4-7 bytes use overlapping loads, so no byte loops and no over-read
+static inline uint64_t swar_load_le(const char *p, size_t n) {
+  if (n >= 8) {
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+  }
+  if (n >= 4) {
+    uint32_t lo, hi;
+    memcpy(&lo, p, sizeof(lo));
+    memcpy(&hi, p + n - 4, sizeof(hi));
+    return (uint64_t)lo | ((uint64_t)hi << (8 * (n - 4)));
+  }
+  if (n == 0) return 0;
+  return (uint64_t)(uint8_t)p[0] |
+         ((uint64_t)(uint8_t)p[n / 2] << (8 * (n / 2))) |
+         ((uint64_t)(uint8_t)p[n - 1] << (8 * (n - 1)));
+}
+
+// high bit of each byte set iff that byte is not an ascii digit
+// exact per byte, no carry crosses into the neighbouring bytes
+static inline uint64_t swar_nondigit_mask(uint64_t x) {
+  const uint64_t y = x & SWAR_DIGITS_LOW7;
+  const uint64_t ge0 = y + SWAR_DIGITS_ONES * (0x80 - '0');        // y >= '0'
+  const uint64_t gt9 = y + SWAR_DIGITS_ONES * (0x80 - '9' - 1);    // y > '9'
+  return (~ge0 | gt9 | x) & SWAR_DIGITS_HIGH;
+}
+
+// value of the 8 digits in x, byte 0 is the most significant
+static inline uint32_t swar_digits_value(uint64_t d) {
+  // d holds digit values 0-9 per byte
+  d = d * 10 + (d >> 8);  // pairs in the even bytes
+  d = (((d & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+       (((d >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+  return (uint32_t)d;
+}
+
+/**
+ * parse the leading digits of p[0..avail), at most 8 of them
+ * one load, one mask and one conversion whatever the digit count
+ *
+ * @param avail bytes available
+ * @param out   value of the digits, untouched if there are none
+ * @return      number of digits consumed, 0-8
+ */
+static inline size_t swar_parse_span(const char *p, size_t avail, uint32_t *out) {
+  uint64_t x;
+  if (avail >= 8) {
+    memcpy(&x, p, sizeof(x));
+  } else {
+    x = swar_load_le(p, avail);
+  }
+
+  // the zero bytes past avail are not digits, so they stop the span
+  uint64_t m = swar_nondigit_mask(x);
+  size_t n = m ? ctz64(m) / 8 : 8;
+  if (n == 0) return 0;
+
+  // 1-2 digits (satellite counts, sentence numbers, "1.6") are cheaper
+  // straight from the loaded bytes than through the multiply chain
+  if (n <= 2) {
+    uint32_t d0 = (uint32_t)(x & 0x0F);
+    *out = n == 1 ? d0 : d0 * 10 + (uint32_t)(x >> 8 & 0x0F);
+    return n;
+  }
+
+  // digits never borrow, so the garbage above them is shifted out whole
+  *out = swar_digits_value((x - SWAR_DIGITS_ZEROS) << (8 * (8 - n)));
+  return n;
+}
+
+/**
+ * parse a short unsigned decimal ("1.6", "3855.448", "03") with one load
+ * the '.' is squeezed out of the register so the integer and fraction
+ * digits convert as a single number
+ *
+ * @param avail       bytes available
+ * @param mantissa    out: every digit as one number, int * 10^frac + frac
+ * @param frac_digits out: digits after the '.', all of them without a '.'
+ *                    (the same quirk as parse_fixedpoint_float)
+ * @return            bytes consumed, 0 if the number has no digits or may not
+ *                    end inside the 8 byte window, the caller falls back then
+ */
+static inline size_t swar_parse_decimal(const char *p, size_t avail,
+                                        uint32_t *mantissa, size_t *frac_digits) {
+  uint64_t x;
+  if (avail >= 8) {
+    memcpy(&x, p, sizeof(x));
+  } else {
+    x = swar_load_le(p, avail);
+  }
+
+  uint64_t m = swar_nondigit_mask(x);
+  if (!m) return 0;
+
+  size_t dot = ctz64(m) / 8;
+  size_t end = dot;
+  size_t digits = dot;
+  *frac_digits = dot;
+
+  // the zero padding past avail can't look like a '.'
+  if ((uint8_t)(x >> (8 * dot)) == '.') {
+    m &= m - 1;
+    if (!m) return 0;
+
+    end = ctz64(m) / 8;
+    digits = end - 1;
+    *frac_digits = end - dot - 1;
+
+    // drop the '.' byte, everything above it moves down one byte
+    uint64_t low = ((uint64_t)1 << (8 * dot)) - 1;
+    x = (x & low) | ((x >> 8) & ~low);
+  }
+
+  if (digits == 0) return 0;
+  *mantissa = swar_digits_value((x - SWAR_DIGITS_ZEROS) << (8 * (8 - digits)));
+  return end;
+}
+
+/**
+ * count the leading digits of p[0..n)
+ * @param n     bytes available, only the first 8 are looked at
+ * @return      0-8
+ */
+static inline size_t swar_digit_span(const char *p, size_t n) {
+  uint64_t m = swar_nondigit_mask(swar_load_le(p, n < 8 ? n : 8));
+  if (n < 8) m |= SWAR_DIGITS_HIGH << (8 * n);
+  return m ? ctz64(m) / 8 : 8;
+}
+
+/**
+ * parse 1-8 ascii digits
+ * @return      false if any of p[0..n) is not a digit
+ */
+static inline bool swar_parse_digits8(const char *p, size_t n, uint32_t *out) {
+  uint64_t x = swar_load_le(p, n);
+  uint64_t m = swar_nondigit_mask(x) & (SWAR_DIGITS_HIGH >> (8 * (8 - n)));
+  if (m) return false;
+
+  // right align the digits, the leading bytes become zeros
+  *out = swar_digits_value((x - (SWAR_DIGITS_ZEROS >> (8 * (8 - n)))) << (8 * (8 - n)));
+  return true;
+}
+
+// fixed layout kernels
+// hhmmss.ssssss and ddmmyy decode straight into the result structs with one
+// load per 8 bytes, one subtract, one multiply-add for the digit pairs and a
+// single test that covers the digit check and every range check
+
+// per byte limits for the hh, mm, ss pairs in bytes 0, 2 and 4:
+// pair + bias has the high bit set iff the pair is above the limit
+#define SWAR_TIME_MAX_BIAS  (((uint64_t)(0x80 - 24)) | ((uint64_t)(0x80 - 60) << 16) | ((uint64_t)(0x80 - 61) << 32))
+// dd in byte 0 and mm in byte 2 must be at least 1 and at most 31 / 12
+#define SWAR_DATE_MAX_BIAS  (((uint64_t)(0x80 - 32)) | ((uint64_t)(0x80 - 13) << 16))
+#define SWAR_DATE_MIN_BIAS  (((uint64_t)(0x80 - 1)) | ((uint64_t)(0x80 - 1) << 16))
+#define SWAR_PAIR_HIGH      0x0000008000800080ULL
+#define SWAR_DATE_HIGH      0x0000000000800080ULL
+#define SWAR_SIX_HIGH       0x0000808080808080ULL
+
+// digit pairs of the 6 leading digits, pair k in byte 2k
+// bytes 0-4 stay exact whatever follows the 6 digits
+static inline uint64_t swar_pairs6(uint64_t x) {
+  uint64_t d = x - 0x0000303030303030ULL;
+  return d * 10 + (d >> 8);
+}
+
+/**
+ * decode hhmmss or hhmmss.s{1-6} into a time
+ * seconds may be 60 for a leap second, fraction digits past the 6th and
+ * anything after the digits are left alone like the byte loop did
+ *
+ * @param avail bytes available, at least 6
+ * @param out   filled in and marked valid on success, untouched otherwise
+ * @return      bytes consumed, 0 if invalid
+ */
+static inline size_t swar_decode_time(const char *p, size_t avail, tiny_nmea_time_t *out) {
+  if (avail < 6) return 0;
+
+  uint64_t x = swar_load_le(p, avail < 8 ? avail : 8);
+  uint64_t pairs = swar_pairs6(x);
+  // the pairs are garbage when a byte is not a digit, but then the
+  // nondigit bits fail the test anyway
+  if ((swar_nondigit_mask(x) & SWAR_SIX_HIGH) |
+      ((pairs + SWAR_TIME_MAX_BIAS) & SWAR_PAIR_HIGH)) {
+    return 0;
+  }
+
+  size_t used = 6;
+  uint32_t micros = 0;
+  if (avail > 7 && (uint8_t)(x >> 48) == '.') {
+    // avail >= 8 here, so a short fraction is read as the last 8 bytes
+    // of the field and shifted down instead of byte by byte
+    uint64_t y;
+    if (avail >= 15) {
+      memcpy(&y, p + 7, sizeof(y));
+    } else {
+      memcpy(&y, p + avail - 8, sizeof(y));
+      y >>= 8 * (15 - avail);
+    }
+    // up to 6 digits, the bytes after the last digit become '0' which
+    // is the same as scaling the fraction up to microseconds
+    uint64_t m = swar_nondigit_mask(y) | (SWAR_DIGITS_HIGH << 48);
+    // every byte below the first non digit, without waiting for the ctz
+    uint64_t keep = ((m & (0 - m)) >> 7) - 1;
+    size_t n = ctz64(m) / 8;
+    uint64_t q = swar_pairs6((y & keep) | (SWAR_DIGITS_ZEROS & ~keep));
+    micros = (uint32_t)(q & 0xFF) * 10000u + (uint32_t)(q >> 16 & 0xFF) * 100u + (uint32_t)(q >> 32 & 0xFF);
+    used = 7 + n;
+  }
+
+  out->hours = (uint8_t)pairs;
+  out->minutes = (uint8_t)(pairs >> 16);
+  out->seconds = (uint8_t)(pairs >> 32);
+  out->microseconds = micros;
+  out->valid = true;
+  return used;
+}
+
+/**
+ * decode ddmmyy into a date, the full year is left at 0
+ *
+ * @param avail bytes available, at least 6
+ * @param out   filled in and marked valid on success, untouched otherwise
+ * @return      true if the 6 bytes are digits and day / month are in range
+ */
+static inline bool swar_decode_date(const char *p, size_t avail, tiny_nmea_date_t *out) {
+  if (avail < 6) return false;
+
+  uint64_t x = swar_load_le(p, avail < 8 ? avail : 8);
+  uint64_t pairs = swar_pairs6(x);
+  if ((swar_nondigit_mask(x) & SWAR_SIX_HIGH) |
+      (((pairs + SWAR_DATE_MAX_BIAS) | ~(pairs + SWAR_DATE_MIN_BIAS)) & SWAR_DATE_HIGH)) {
+    return false;
+  }
+
+  out->day = (uint8_t)pairs;
+  out->month = (uint8_t)(pairs >> 16);
+  out->year_yy = (uint8_t)(pairs >> 32);
+  out->year = 0;
+  out->valid = true;
+  return true;
+}
+
+#else
+
+// big endian or unknown byte order, plain loops with the same contracts
+
+static inline size_t swar_parse_span(const char *p, size_t avail, uint32_t *out) {
+  uint32_t val = 0;
+  size_t i = 0;
+  for (; i < avail && i < 8 && (uint8_t)(p[i] - '0') <= 9; i++) {
+    val = val * 10 + (uint8_t)(p[i] - '0');
+  }
+  if (i) *out = val;
+  return i;
+}
+
+static inline size_t swar_parse_decimal(const char *p, size_t avail,
+                                        uint32_t *mantissa, size_t *frac_digits) {
+  // no fast path, callers fall back to their digit loops
+  (void)p; (void)avail; (void)mantissa; (void)frac_digits;
+  return 0;
+}
+
+static inline size_t swar_digit_span(const char *p, size_t n) {
+  size_t i = 0;
+  while (i < n && i < 8 && (uint8_t)(p[i] - '0') <= 9) i++;
+  return i;
+}
+
+static inline bool swar_parse_digits8(const char *p, size_t n, uint32_t *out) {
+  uint32_t val = 0;
+  for (size_t i = 0; i < n; i++) {
+    uint8_t digit = (uint8_t)(p[i] - '0');
+    if (digit > 9) return false;
+    val = val * 10 + digit;
+  }
+  *out = val;
+  return true;
+}
+
+static inline size_t swar_decode_time(const char *p, size_t avail, tiny_nmea_time_t *out) {
+  uint32_t v;
+  if (avail < 6 || !swar_parse_digits8(p, 6, &v)) return 0;
+
+  uint8_t h = (uint8_t)(v / 10000), m = (uint8_t)(v / 100 % 100), s = (uint8_t)(v % 100);
+  if (h > 23 || m > 59 || s > 60) return 0;
+
+  size_t used = 6;
+  uint32_t micros = 0;
+  if (avail > 7 && p[6] == '.') {
+    size_t n = swar_digit_span(p + 7, avail - 7 < 6 ? avail - 7 : 6);
+    if (n) swar_parse_digits8(p + 7, n, &micros);
+    for (size_t i = n; i < 6; i++) micros *= 10;
+    used = 7 + n;
+  }
+
+  out->hours = h;
+  out->minutes = m;
+  out->seconds = s;
+  out->microseconds = micros;
+  out->valid = true;
+  return used;
+}
+
+static inline bool swar_decode_date(const char *p, size_t avail, tiny_nmea_date_t *out) {
+  uint32_t v;
+  if (avail < 6 || !swar_parse_digits8(p, 6, &v)) return false;
+
+  uint8_t d = (uint8_t)(v / 10000), m = (uint8_t)(v / 100 % 100);
+  if (d < 1 || d > 31 || m < 1 || m > 12) return false;
+
+  out->day = d;
+  out->month = m;
+  out->year_yy = (uint8_t)(v % 100);
+  out->year = 0;
+  out->valid = true;
+  return true;
+}
+
+#endif
+
+/**
+ * parse 1-16 ascii digits into a uint32_t
+ * @return      false on a non digit or if the value does not fit
+ */
+static inline bool swar_parse_u32(const char *p, size_t n, uint32_t *out) {
+  if (n <= 8) return swar_parse_digits8(p, n, out);
+
+  uint32_t hi, lo;
+  if (!swar_parse_digits8(p, n - 8, &hi) || !swar_parse_digits8(p + n - 8, 8, &lo)) {
+    return false;
+  }
+
+  uint64_t val = (uint64_t)hi * 100000000u + lo;
+  if (val > UINT32_MAX) return false;
+  *out = (uint32_t)val;
+  return true;
+}
+
+#endif //TINY_NMEA_SWAR_DIGITS_H
@@ -5,6 +5,9 @@
 #ifndef TINY_NMEA_UTIL_H
 #define TINY_NMEA_UTIL_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #define DEFINE_MIN(name, type) \
   static inline type min_##name(type a, type b) { return a < b ? a : b; }
 
@@ -24,6 +27,39 @@
 DEFINE_MIN(ptr,    void*)
 DEFINE_MIN(size,   size_t)
 
+// index of the lowest set bit, x must be non-zero
+static inline unsigned ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_ctzll(x);
+#else
+  unsigned n = 0;
+  while (!(x & 1)) { x >>= 1; n++; }
+  return n;
+#endif
+}
+
+// number of leading zero bits, x must be non-zero
+static inline unsigned clz32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_clz(x);
+#else
+  unsigned n = 0;
+  while (!(x & 0x80000000u)) { x <<= 1; n++; }
+  return n;
+#endif
+}
+
+// number of leading zero bits, x must be non-zero
+static inline unsigned clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (unsigned)__builtin_clzll(x);
+#else
+  unsigned n = 0;
+  while (!(x & 0x8000000000000000ull)) { x <<= 1; n++; }
+  return n;
+#endif
+}
+
 static inline int parse_hex_char(char c) {
   if (c >= '0' && c <= '9') return c - '0';
   if (c >= 'A' && c <= 'F') return c - 'A' + 10;
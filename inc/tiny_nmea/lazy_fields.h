@@ -0,0 +1,117 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// on-demand field decoding
+// a lazy result only tokenizes the sentence, each field is decoded
+// the first time it is read and cached, so the cost scales with the
+// fields actually used rather than with the fields present
+
+#ifndef TINY_NMEA_LAZY_FIELDS_H
+#define TINY_NMEA_LAZY_FIELDS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "internal/field.h"
+#include "internal/nmea_0183_types.h"
+
+// fields that can be read lazily, mapped to the field index
+// of every sentence type that carries them
+// X(NAME)
+#define TINY_NMEA_LAZY_FIELD_LIST(X) \
+    X(TIME)                          \
+    X(DATE)                          \
+    X(STATUS)                        \
+    X(LATITUDE)                      \
+    X(LONGITUDE)                     \
+    X(SPEED_KNOTS)                   \
+    X(COURSE)                        \
+    X(FIX_QUALITY)                   \
+    X(SATELLITES)                    \
+    X(HDOP)                          \
+    X(ALTITUDE)
+
+#define X_LAZY(name) TINY_NMEA_LAZY_##name,
+typedef enum {
+  TINY_NMEA_LAZY_FIELD_LIST(X_LAZY)
+  TINY_NMEA_LAZY_FIELD_COUNT
+} tiny_nmea_lazy_field_t;
+#undef X_LAZY
+
+_Static_assert(TINY_NMEA_LAZY_FIELD_COUNT <= 16, "lazy field bitmask is 16 bits");
+
+// largest field count of any handler (GSV)
+#define TINY_NMEA_LAZY_MAX_FIELDS 20
+
+typedef struct {
+  tiny_nmea_sentence_type_t type;
+  tiny_nmea_talker_t talker;
+  uint8_t field_count;
+  uint8_t century;             // century from ZDA tracking for RMC dates, 0 if unknown
+  uint16_t decoded;            // bit per lazy field, set once it has been decoded
+  uint16_t valid;              // bit per lazy field, set if it decoded successfully
+
+  // tokenized sentence, fields point into the sentence data
+  // which is not owned and must outlive the lazy result
+  const char *sentence;
+  size_t sentence_len;
+  field_t fields[TINY_NMEA_LAZY_MAX_FIELDS];
+
+  // decoded field cache, read through the accessors
+  tiny_nmea_time_t time;
+  tiny_nmea_date_t date;
+  bool status_valid;
+  tiny_nmea_coord_t latitude;
+  tiny_nmea_coord_t longitude;
+  tiny_nmea_float_t speed_knots;
+  tiny_nmea_float_t course_deg;
+  tiny_nmea_fix_quality_t fix_quality;
+  uint8_t satellites_used;
+  tiny_nmea_float_t hdop;
+  tiny_nmea_float_t altitude_m;
+} tiny_nmea_lazy_t;
+
+/**
+ * tokenize a sentence for lazy decoding, no field is decoded yet
+ * if out->type and out->talker are already valid they are used as is
+ * (zero-init out to have them parsed from the sentence)
+ *
+ * @param sentence  sentence data starting from '$' or '!' up to the data end
+ * @param len       length of the sentence data
+ * @param out       lazy result, keeps pointers into sentence
+ * @return          TINY_NMEA_OK if the sentence has enough fields for its type
+ */
+tiny_nmea_res_t tiny_nmea_lazy_parse(const char *sentence, size_t len, tiny_nmea_lazy_t *out);
+
+/**
+ * check if the sentence type carries a field at all
+ */
+bool tiny_nmea_lazy_has(const tiny_nmea_lazy_t *l, tiny_nmea_lazy_field_t field);
+
+// field accessors, decode on first call and return the cached value after
+// return false if the sentence does not carry the field or it is empty/invalid
+bool tiny_nmea_lazy_time(tiny_nmea_lazy_t *l, tiny_nmea_time_t *out);
+bool tiny_nmea_lazy_date(tiny_nmea_lazy_t *l, tiny_nmea_date_t *out);
+bool tiny_nmea_lazy_status(tiny_nmea_lazy_t *l, bool *out);
+bool tiny_nmea_lazy_latitude(tiny_nmea_lazy_t *l, tiny_nmea_coord_t *out);
+bool tiny_nmea_lazy_longitude(tiny_nmea_lazy_t *l, tiny_nmea_coord_t *out);
+bool tiny_nmea_lazy_speed_knots(tiny_nmea_lazy_t *l, tiny_nmea_float_t *out);
+bool tiny_nmea_lazy_course(tiny_nmea_lazy_t *l, tiny_nmea_float_t *out);
+bool tiny_nmea_lazy_fix_quality(tiny_nmea_lazy_t *l, tiny_nmea_fix_quality_t *out);
+bool tiny_nmea_lazy_satellites(tiny_nmea_lazy_t *l, uint8_t *out);
+bool tiny_nmea_lazy_hdop(tiny_nmea_lazy_t *l, tiny_nmea_float_t *out);
+bool tiny_nmea_lazy_altitude(tiny_nmea_lazy_t *l, tiny_nmea_float_t *out);
+
+/**
+ * fall back to decoding the whole sentence with the eager handler
+ * for sentence types or fields without a lazy accessor
+ *
+ * @param l         lazy result
+ * @param out       output result structure
+ * @return          TINY_NMEA_OK if parsed successfully
+ */
+tiny_nmea_res_t tiny_nmea_lazy_decode_all(const tiny_nmea_lazy_t *l, tiny_nmea_type_t *out);
+
+#endif //TINY_NMEA_LAZY_FIELDS_H
@@ -11,27 +11,77 @@
 
 #include "internal/ringbuf_type.h"
 #include "internal/nmea_0183_types.h"
+#include "lazy_fields.h"
+#include "ais.h"
 
 typedef struct {
   uint32_t sentences_parsed;
   uint32_t checksum_errors;
   uint32_t parse_errors;
   uint32_t buffer_overflows;
+  uint32_t sentences_filtered;  // skipped by the sentence filter, never checksummed or parsed
 } tiny_nmea_parser_statistics_t;
 
+// sentence filter mask, one bit per tiny_nmea_sentence_type_t
+typedef uint32_t tiny_nmea_sentence_mask_t;
+#define TINY_NMEA_SENTENCE_BIT(type) ((tiny_nmea_sentence_mask_t)1 << (type))
+#define TINY_NMEA_SENTENCE_MASK_ALL  ((tiny_nmea_sentence_mask_t)UINT32_MAX)
+
+// sentence types compiled in, see TINY_NMEA_ENABLE_* in config.h
+#define TINY_NMEA_X_SENTENCE_ENABLED(name, c1, c2, c3) \
+  | (TINY_NMEA_ENABLE_##name ? TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_##name) : 0)
+#define TINY_NMEA_SENTENCE_MASK_ENABLED \
+  ((tiny_nmea_sentence_mask_t)0 TINY_NMEA_SENTENCE_LIST(TINY_NMEA_X_SENTENCE_ENABLED))
+_Static_assert(TINY_NMEA_SENTENCE_COUNT <= 32, "sentence types exceed the filter mask");
+
 // sentenced parsed callback
 // use result->type to determine which union member to access
 typedef void (*tiny_nmea_parse_callback_t)(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *parse_user_data);
 typedef void (*tiny_nmea_error_callback_t)(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *error_user_data);
 
+// batch of parsed sentences callback, called at most once per tiny_nmea_work()
+// (more often only if the batch array fills up), results are in stream order
+typedef void (*tiny_nmea_batch_callback_t)(const tiny_nmea_type_t *results, size_t count,
+                                           const tiny_nmea_parser_statistics_t *stats, void *batch_user_data);
+
+// lazily decoded sentence callback, fields are decoded on access through the
+// tiny_nmea_lazy_* accessors. result points into the parser buffers and is
+// only valid for the duration of the callback
+typedef void (*tiny_nmea_lazy_callback_t)(tiny_nmea_lazy_t *result, tiny_nmea_parser_statistics_t stats, void *lazy_user_data);
+
+// runs on the feeding thread after bytes land in the ring buffer
+typedef void (*tiny_nmea_feed_callback_t)(const ringbuf_t *ringbuf, void *feed_user_data);
+
 typedef enum {
   TINY_NMEA_PARSE_FIND_START = 0,
   TINY_NMEA_PARSE_FIND_TALKER_AND_TYPE,
   TINY_NMEA_PARSE_FIND_CHECKSUM_OR_END,
   TINY_NMEA_PARSE_FIND_END,
+  TINY_NMEA_PARSE_SKIP_TO_END,
   TINY_NMEA_SENTENCE_COMPLETE
 } tiny_nmea_parser_fsm_state_t;
 
+#define TINY_NMEA_PARSE_STATE_COUNT (TINY_NMEA_SENTENCE_COMPLETE + 1)
+
+// hot path instrumentation, only collected with TINY_NMEA_ENABLE_INSTRUMENTATION
+// times are in ticks of TINY_NMEA_INSTR_NOW(), see config.h
+typedef struct {
+  uint64_t state_ticks[TINY_NMEA_PARSE_STATE_COUNT];  // time in each FSM state, COMPLETE includes parse and callbacks
+  uint32_t state_steps[TINY_NMEA_PARSE_STATE_COUNT];  // FSM steps taken in each state
+  uint64_t parse_ticks;                               // time in the sentence decoders or the lazy tokenizer
+  uint64_t callback_ticks;                            // time in user callbacks, parse, batch, lazy and error
+  uint32_t parse_hist[TINY_NMEA_SENTENCE_COUNT][TINY_NMEA_INSTR_HIST_BUCKETS]; // log2 parse time buckets per type
+  uint64_t find_start_discarded;                      // bytes thrown away in FIND_START looking for '$' or '!'
+  uint64_t memmove_bytes;                             // bytes shifted down the working buffer by copy framing
+  size_t ring_high_water;                             // most bytes waiting in the ringbuf at tiny_nmea_work() entry
+} tiny_nmea_instrumentation_t;
+
+// how tiny_nmea_work() frames sentences out of the ring buffer
+typedef enum {
+  TINY_NMEA_FRAMING_COPY = 0,  // pop bytes into the linear working buffer (default)
+  TINY_NMEA_FRAMING_IN_PLACE   // scan the ring storage directly, copy only sentences that wrap
+} tiny_nmea_framing_mode_t;
+
 // parser context
 typedef struct {
   // INTERNAL DATA DO NOT ACCESS DIRECTLY
@@ -45,40 +95,73 @@ typedef struct {
   void *parse_user_data;
   void *error_user_data;
 
-  // working buffer
+  // batch mode, replaces parse_callback when set
+  tiny_nmea_batch_callback_t batch_callback;
+  void *batch_user_data;
+  tiny_nmea_type_t *batch_results;           // user supplied result array
+  size_t batch_capacity;
+  size_t batch_count;                        // results pending in the current batch
+
+  // lazy mode, replaces batch_callback and parse_callback when set
+  tiny_nmea_lazy_callback_t lazy_callback;
+  void *lazy_user_data;
+
+  // producer side notification, e.g. to wake a blocked consumer
+  tiny_nmea_feed_callback_t feed_callback;
+  void *feed_user_data;
+
+  // framing window, the bytes the FSM is currently looking at
+  // copy framing keeps them in working_buf, in-place framing leaves
+  // them in the ringbuf and only uses working_buf for wrapped sentences
+  tiny_nmea_framing_mode_t framing_mode;
   uint8_t working_buf[TINY_NMEA_WORKING_BUF_LEN];
-  size_t working_buf_len;
-  size_t parse_pos;                          // current parse position in working_buf
+  size_t window_len;                         // bytes currently in the framing window
+  size_t parse_pos;                          // current parse position in the window
   // check for overrun length while waiting for data
   bool waiting_for_data;
 
+  // linear source for tiny_nmea_parse_buffer(), NULL when framing out of the ringbuf
+  const uint8_t *src;
+  size_t src_len;
+  size_t src_pos;                            // first byte not yet consumed
+
   // current sentence info
   char start_char;
   bool has_checksum;
-  uint8_t computed_checksum;                 // computed xor checksum for debugging
+  uint8_t computed_checksum;                 // running xor checksum, folded in as the data end is searched for
   uint8_t received_checksum;                 // actual read checksum for debugging
-  uint8_t *data_end;                         // sentence end, right at the last char '*' if checksum or 'CR' if 'CRLF'
-  uint8_t *line_end;                         // at the first char 'CR' of 'CRLF' etc
+  size_t data_end;                           // sentence end offset, right at the last char '*' if checksum or 'CR' if 'CRLF'
+  size_t line_end;                           // offset of the first char 'CR' of 'CRLF' etc
   tiny_nmea_talker_t current_talker;
   tiny_nmea_sentence_type_t current_type;
   tiny_nmea_parser_fsm_state_t parser_state;
 
+  // sentence types to parse, others are skipped right after the header
+  tiny_nmea_sentence_mask_t sentence_filter;
+
   // century tracking from ZDA
   uint8_t zda_century;    // 0 if unknown
 
   // parse statistics
   tiny_nmea_parser_statistics_t stats;
+
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  tiny_nmea_instrumentation_t instr;
+#endif
 } tiny_nmea_ctx_t;
 
 /**
  * init the parser context
  * @param ctx       empty parser context to init
  * @param buffer    user supplied working buffer for ringbuf
- * @param buf_size  size of the provided buffer
+ * @param buf_size  size of the provided buffer, with
+ *                  TINY_NMEA_ENABLE_MULTI_PRODUCER at most RINGBUF_MAX_SIZE
+ *                  (65535 bytes on 32 bit targets)
  * @param parse_callback  callback func when a sentence is parsed (NULL for none)
  * @param parse_user_data data passed to parse callback
  * @param error_callback  callback func when sentence found but error parsing (NULL for none)
  * @param error_user_data data passed to error callback
+ * @return          TINY_NMEA_INVALID_ARGS if buf_size is too large for the ringbuf
  */
 tiny_nmea_res_t tiny_nmea_init_callbacks(tiny_nmea_ctx_t *ctx,
                                          uint8_t *buffer,
@@ -92,7 +175,10 @@ tiny_nmea_res_t tiny_nmea_init_callbacks(tiny_nmea_ctx_t *ctx,
  * init the parser context without setting callbacks
  * @param ctx       empty parser context to init
  * @param buffer    user supplied working buffer for ringbuf
- * @param buf_size  size of the provided buffer
+ * @param buf_size  size of the provided buffer, with
+ *                  TINY_NMEA_ENABLE_MULTI_PRODUCER at most RINGBUF_MAX_SIZE
+ *                  (65535 bytes on 32 bit targets)
+ * @return          TINY_NMEA_INVALID_ARGS if buf_size is too large for the ringbuf
  */
 tiny_nmea_res_t tiny_nmea_init(tiny_nmea_ctx_t *ctx,
                                uint8_t *buffer,
@@ -117,6 +203,70 @@ tiny_nmea_res_t tiny_nmea_set_error_callback(tiny_nmea_ctx_t *ctx,
                                              tiny_nmea_error_callback_t error_callback,
                                              void *error_user_data);
 
+/**
+ * switch to batch mode, parsed sentences are written straight into
+ * the results array and handed over in one callback per tiny_nmea_work()
+ * instead of one parse callback per sentence. the error callback is
+ * still invoked per sentence
+ * @param results         user supplied array for parsed sentences (NULL to disable batch mode)
+ * @param capacity        number of entries in results, the batch is flushed early when full
+ * @param batch_callback  callback func when a batch is complete (NULL to disable batch mode)
+ * @param batch_user_data data passed to batch callback
+ */
+tiny_nmea_res_t tiny_nmea_set_batch_callback(tiny_nmea_ctx_t *ctx,
+                                             tiny_nmea_type_t *results,
+                                             size_t capacity,
+                                             tiny_nmea_batch_callback_t batch_callback,
+                                             void *batch_user_data);
+
+/**
+ * switch to lazy mode, sentences are only tokenized and handed over
+ * as a tiny_nmea_lazy_t so the callback pays for the fields it reads.
+ * sentences with too few fields still go to the error callback, bad
+ * field values only show up as a failed accessor
+ * @param lazy_callback   callback func when a sentence is tokenized (NULL to disable lazy mode)
+ * @param lazy_user_data  data passed to lazy callback
+ */
+tiny_nmea_res_t tiny_nmea_set_lazy_callback(tiny_nmea_ctx_t *ctx,
+                                            tiny_nmea_lazy_callback_t lazy_callback,
+                                            void *lazy_user_data);
+
+/**
+ * get notified on the feeding thread whenever tiny_nmea_feed() or
+ * tiny_nmea_feed_commit() added bytes, with the ring buffer to check
+ * the fill level. keep it short, it runs in the producer path (maybe
+ * an ISR). with TINY_NMEA_ENABLE_MULTI_PRODUCER it runs concurrently
+ * @param feed_callback   callback func after a feed (NULL to disable)
+ * @param feed_user_data  data passed to feed callback
+ */
+tiny_nmea_res_t tiny_nmea_set_feed_callback(tiny_nmea_ctx_t *ctx,
+                                            tiny_nmea_feed_callback_t feed_callback,
+                                            void *feed_user_data);
+
+/**
+ * only parse the sentence types in mask, other sentences are dropped
+ * as soon as their type is known, before checksum or tokenization,
+ * and counted in stats.sentences_filtered. types compiled out in
+ * config.h are always dropped
+ * e.g. TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_RMC) | TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_GGA)
+ * @param mask      bitmask of TINY_NMEA_SENTENCE_BIT(), TINY_NMEA_SENTENCE_MASK_ALL to parse everything (default)
+ */
+tiny_nmea_res_t tiny_nmea_set_sentence_filter(tiny_nmea_ctx_t *ctx,
+                                              tiny_nmea_sentence_mask_t mask);
+
+/**
+ * select how sentences are framed out of the ring buffer
+ * in-place framing avoids copying every byte into the working buffer,
+ * but keeps a partial sentence in the ring so it needs a ring buffer
+ * at least TINY_NMEA_MAX_SENTENCE_LEN bytes larger than one feed
+ * call this right after init, a partially framed sentence is dropped
+ *
+ * @param ctx       parser context
+ * @param mode      framing mode
+ */
+tiny_nmea_res_t tiny_nmea_set_framing_mode(tiny_nmea_ctx_t *ctx,
+                                           tiny_nmea_framing_mode_t mode);
+
 /**
  * process available data in the ring buffer
  * call this periodically to parse complete
@@ -127,9 +277,26 @@ tiny_nmea_res_t tiny_nmea_set_error_callback(tiny_nmea_ctx_t *ctx,
  */
 tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx);
 
+/**
+ * parse a contiguous buffer of NMEA data in place, without the ring buffer
+ * e.g. a whole recorded log. sentences are framed and decoded straight out
+ * of data with the same callbacks, filter and statistics as tiny_nmea_work().
+ * an unterminated sentence at the end of data is dropped, so split large
+ * inputs at line ends. a partially framed ring buffer sentence is handled
+ * as in tiny_nmea_set_framing_mode()
+ *
+ * @param ctx       parser context
+ * @param data      raw NMEA data, only read during the call
+ * @param len       length of data
+ * @return          TINY_NMEA_OK, TINY_NMEA_INVALID_ARGS on bad args
+ */
+tiny_nmea_res_t tiny_nmea_parse_buffer(tiny_nmea_ctx_t *ctx, const uint8_t *data, size_t len);
+
 /**
  * ingest data into the ring buffer, call this when you
  * have UART data in a linear buffer already
+ * with TINY_NMEA_ENABLE_MULTI_PRODUCER several threads may feed the same
+ * context, each feed then lands whole or not at all so feed complete sentences
  *
  * @param ctx       Parser context
  * @param data      Raw NMEA data
@@ -138,6 +305,30 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx);
  */
 tiny_nmea_res_t tiny_nmea_feed(tiny_nmea_ctx_t *ctx, const uint8_t *data, size_t len);
 
+/**
+ * get the free ring buffer space to receive into directly, e.g.
+ *   n = read(fd, span1.ptr, span1.len); tiny_nmea_feed_commit(ctx, n);
+ * which saves copying the data from a staging buffer as tiny_nmea_feed()
+ * does. fill span1 before span2, nothing is claimed until the commit so
+ * do not mix with tiny_nmea_feed() in between
+ *
+ * @param ctx       parser context
+ * @param span1     free space from the write position
+ * @param span2     free space after the ring wraps, may be empty
+ * @return          TINY_NMEA_OK, TINY_NMEA_ERR_BUFFER_FULL if there is no space,
+ *                  TINY_NMEA_ERR_UNSUPPORTED with TINY_NMEA_ENABLE_MULTI_PRODUCER
+ */
+tiny_nmea_res_t tiny_nmea_feed_reserve(tiny_nmea_ctx_t *ctx, ringbuf_span_t *span1, ringbuf_span_t *span2);
+
+/**
+ * hand over bytes received into the spans from tiny_nmea_feed_reserve()
+ *
+ * @param ctx       parser context
+ * @param len       bytes written, span1 first then span2
+ * @return          TINY_NMEA_OK, TINY_NMEA_INVALID_ARGS if len is more than was free
+ */
+tiny_nmea_res_t tiny_nmea_feed_commit(tiny_nmea_ctx_t *ctx, size_t len);
+
 /**
  * parse a single NMEA sentence
  * the sentence should just contain the data, starting from '$' and ending
@@ -150,6 +341,18 @@ tiny_nmea_res_t tiny_nmea_feed(tiny_nmea_ctx_t *ctx, const uint8_t *data, size_t
  */
 tiny_nmea_res_t tiny_nmea_parse(const char *sentence, tiny_nmea_type_t *result);
 
+/**
+ * parse a single NMEA sentence of known length
+ * same as tiny_nmea_parse() but the sentence does not need to be
+ * null-terminated, len covers the start char up to the data end
+ *
+ * @param sentence  sentence data starting from '$' or '!'
+ * @param len       length of the sentence data
+ * @param result    output result structure
+ * @return          TINY_NMEA_OK if parsed successfully
+ */
+tiny_nmea_res_t tiny_nmea_parse_len(const char *sentence, size_t len, tiny_nmea_type_t *result);
+
 /**
  * get sentence type name as string
  */
@@ -165,4 +368,21 @@ const char *tiny_nmea_talker_name(tiny_nmea_talker_t talker);
  */
 void tiny_nmea_reset_stats(tiny_nmea_ctx_t *ctx);
 
+/**
+ * copy out the hot path instrumentation, call from the thread running
+ * tiny_nmea_work() since the counters are updated without locking
+ * @param ctx       parser context
+ * @param out       snapshot of the counters
+ * @return          TINY_NMEA_OK, TINY_NMEA_ERR_UNSUPPORTED if built without
+ *                  TINY_NMEA_ENABLE_INSTRUMENTATION
+ */
+tiny_nmea_res_t tiny_nmea_get_instrumentation(const tiny_nmea_ctx_t *ctx, tiny_nmea_instrumentation_t *out);
+
+/**
+ * zero the hot path instrumentation counters
+ * @return          TINY_NMEA_OK, TINY_NMEA_ERR_UNSUPPORTED if built without
+ *                  TINY_NMEA_ENABLE_INSTRUMENTATION
+ */
+tiny_nmea_res_t tiny_nmea_reset_instrumentation(tiny_nmea_ctx_t *ctx);
+
 #endif //TINY_NMEA_TINY_NMEA_H
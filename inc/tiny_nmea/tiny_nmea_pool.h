@@ -0,0 +1,131 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// multi-stream parser pool for hosted targets
+// owns one parser context and ringbuf per stream and shards the streams
+// across worker threads, a worker runs tiny_nmea_work() on a stream
+// whenever new data is fed to it. callbacks run on the worker thread
+
+#ifndef TINY_NMEA_TINY_NMEA_POOL_H
+#define TINY_NMEA_TINY_NMEA_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tiny_nmea.h"
+
+typedef struct tiny_nmea_pool tiny_nmea_pool_t;
+
+typedef struct {
+  size_t stream_count;       // number of input streams
+  size_t ring_size;          // ringbuf bytes per stream
+  size_t worker_count;       // worker threads, 0 for one per online core (capped at stream_count)
+  bool pin_workers;          // pin worker i to core i % cores (linux only, ignored elsewhere)
+
+  // installed on every stream, use tiny_nmea_pool_stream() for per-stream setup
+  tiny_nmea_parse_callback_t parse_callback;
+  void *parse_user_data;
+  tiny_nmea_error_callback_t error_callback;
+  void *error_user_data;
+} tiny_nmea_pool_config_t;
+
+/**
+ * allocate the pool, its parser contexts and ringbufs
+ * worker threads are not started until tiny_nmea_pool_start()
+ *
+ * @param out       receives the new pool
+ * @param config    pool configuration
+ */
+tiny_nmea_res_t tiny_nmea_pool_create(tiny_nmea_pool_t **out, const tiny_nmea_pool_config_t *config);
+
+/**
+ * get the parser context of a stream for per-stream setup
+ * (callbacks, sentence filter, framing mode etc)
+ * only touch it before tiny_nmea_pool_start() or after tiny_nmea_pool_stop()
+ *
+ * @return          stream context, NULL if stream is out of range
+ */
+tiny_nmea_ctx_t *tiny_nmea_pool_stream(tiny_nmea_pool_t *pool, size_t stream);
+
+/**
+ * start the worker threads
+ */
+tiny_nmea_res_t tiny_nmea_pool_start(tiny_nmea_pool_t *pool);
+
+/**
+ * feed data to a stream and wake its worker if the stream was idle
+ * each stream must only be fed from one thread at a time
+ *
+ * @param pool      parser pool
+ * @param stream    stream index
+ * @param data      incoming bytes
+ * @param len       number of bytes
+ * @return          TINY_NMEA_ERR_BUFFER_FULL if the stream ringbuf dropped data
+ */
+tiny_nmea_res_t tiny_nmea_pool_feed(tiny_nmea_pool_t *pool, size_t stream, const uint8_t *data, size_t len);
+
+/**
+ * process everything already fed, then stop and join the worker threads
+ */
+tiny_nmea_res_t tiny_nmea_pool_stop(tiny_nmea_pool_t *pool);
+
+/**
+ * stop the pool if running and free everything it owns
+ */
+void tiny_nmea_pool_destroy(tiny_nmea_pool_t *pool);
+
+/**
+ * thread safe snapshot of one stream's statistics
+ * as of the last tiny_nmea_work() on that stream
+ */
+tiny_nmea_res_t tiny_nmea_pool_stream_stats(tiny_nmea_pool_t *pool, size_t stream,
+                                            tiny_nmea_parser_statistics_t *out);
+
+/**
+ * thread safe sum of the statistics of all streams
+ */
+tiny_nmea_res_t tiny_nmea_pool_stats(tiny_nmea_pool_t *pool, tiny_nmea_parser_statistics_t *out);
+
+// parallel parsing of one large buffer, e.g. a mapped log file
+// the buffer is cut into chunks at sentence boundaries, each chunk is parsed
+// on its own thread with its own parser context and the results are handed
+// to the callbacks in stream order on the calling thread afterwards
+typedef struct {
+  size_t chunk_count;        // 0 for one per online core, capped so chunks are not tiny
+  tiny_nmea_sentence_mask_t sentence_filter;  // 0 for TINY_NMEA_SENTENCE_MASK_ALL
+
+  tiny_nmea_parse_callback_t parse_callback;
+  void *parse_user_data;
+  tiny_nmea_error_callback_t error_callback;
+  void *error_user_data;
+} tiny_nmea_parallel_config_t;
+
+/**
+ * find the first sentence boundary at or after from, a '$' or '!'
+ * right after a line end. the start of data is always a boundary
+ *
+ * @return          offset of the boundary, len if there is none
+ */
+size_t tiny_nmea_sentence_boundary(const uint8_t *data, size_t len, size_t from);
+
+/**
+ * parse a buffer on several threads, see tiny_nmea_parallel_config_t
+ * all results of a chunk are kept until every chunk is done, which costs
+ * one tiny_nmea_type_t per sentence. the ZDA century is carried across
+ * chunks so RMC years come out as in a single pass. the statistics passed
+ * to the callbacks are the totals up to the end of the sentence's chunk
+ *
+ * @param data      raw NMEA data, sentences should end with a line end
+ * @param len       length of data
+ * @param config    chunking and callbacks
+ * @param stats     summed statistics of all chunks (NULL for none)
+ * @return          TINY_NMEA_OK, TINY_NMEA_ERR_NO_MEMORY if results could not
+ *                  be kept, in which case no callbacks are invoked
+ */
+tiny_nmea_res_t tiny_nmea_parse_parallel(const uint8_t *data, size_t len,
+                                         const tiny_nmea_parallel_config_t *config,
+                                         tiny_nmea_parser_statistics_t *stats);
+
+#endif //TINY_NMEA_TINY_NMEA_POOL_H
@@ -0,0 +1,27 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// recorded log replay for hosted (posix) targets
+// memory-maps a log file and parses it in place with tiny_nmea_parse_buffer(),
+// so offline reprocessing never copies the data through the ringbuf
+
+#ifndef TINY_NMEA_TINY_NMEA_REPLAY_H
+#define TINY_NMEA_TINY_NMEA_REPLAY_H
+
+#include "tiny_nmea.h"
+
+/**
+ * memory-map a recorded NMEA log and parse all of it
+ * callbacks run on the calling thread before this returns, the ctx
+ * ringbuf is not touched and may be left empty
+ *
+ * @param ctx       parser context with callbacks installed
+ * @param path      path of the log file
+ * @return          TINY_NMEA_OK if the whole file was parsed,
+ *                  TINY_NMEA_INVALID_ARGS if the file can not be opened,
+ *                  TINY_NMEA_ERR_NO_MEMORY if it can not be mapped
+ */
+tiny_nmea_res_t tiny_nmea_replay_mmap(tiny_nmea_ctx_t *ctx, const char *path);
+
+#endif //TINY_NMEA_TINY_NMEA_REPLAY_H
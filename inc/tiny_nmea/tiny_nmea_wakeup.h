@@ -0,0 +1,95 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// blocking wakeup for hosted linux targets
+// lets the thread running tiny_nmea_work() sleep until tiny_nmea_feed()
+// (or tiny_nmea_feed_commit()) has buffered at least a watermark of bytes,
+// instead of polling. backed by an eventfd so it also plugs into poll/epoll
+// loops. the feeding side only pays for a syscall when the consumer is
+// actually asleep and the watermark is reached
+
+#ifndef TINY_NMEA_TINY_NMEA_WAKEUP_H
+#define TINY_NMEA_TINY_NMEA_WAKEUP_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "tiny_nmea.h"
+
+typedef struct {
+  // INTERNAL DATA DO NOT ACCESS DIRECTLY
+
+  tiny_nmea_ctx_t *ctx;
+  int fd;                     // eventfd, readable once signalled
+  size_t watermark;           // buffered bytes that end a wait
+  _Atomic size_t held;        // ring bytes in-place framing already looked at, set by the consumer on arm
+  _Atomic bool armed;         // consumer is about to sleep, the next feed past the watermark signals
+  _Atomic bool kicked;        // tiny_nmea_wakeup_wake() was called
+} tiny_nmea_wakeup_t;
+
+/**
+ * create the eventfd and install it as the feed callback of ctx
+ * replaces any feed callback set with tiny_nmea_set_feed_callback()
+ *
+ * @param w         wakeup to init
+ * @param ctx       parser context, must outlive the wakeup
+ * @param watermark buffered bytes to wake at, 0 or 1 wakes on the first
+ *                  byte. e.g. TINY_NMEA_MAX_SENTENCE_LEN batches the work
+ *                  but a wait then only ends early if that much arrives.
+ *                  with TINY_NMEA_FRAMING_IN_PLACE a partial sentence the
+ *                  last tiny_nmea_work() left in the ring does not count
+ * @return          TINY_NMEA_INVALID_ARGS if the watermark is more than the
+ *                  ring buffer holds, TINY_NMEA_ERR_NO_MEMORY if the eventfd
+ *                  can not be created
+ */
+tiny_nmea_res_t tiny_nmea_wakeup_init(tiny_nmea_wakeup_t *w, tiny_nmea_ctx_t *ctx, size_t watermark);
+
+/**
+ * block until the watermark is buffered, tiny_nmea_wakeup_wake() is called
+ * or the timeout runs out. returns right away if the data is already there
+ * only one thread may wait on a wakeup
+ *
+ * @param w         wakeup
+ * @param timeout_ms max time to block, negative to wait forever
+ * @return          TINY_NMEA_OK to run tiny_nmea_work(),
+ *                  TINY_NMEA_ERR_TIMEOUT if the timeout ran out first
+ */
+tiny_nmea_res_t tiny_nmea_wakeup_wait(tiny_nmea_wakeup_t *w, int timeout_ms);
+
+/**
+ * for event loops, arm the wakeup before sleeping on tiny_nmea_wakeup_fd()
+ * if this returns true the data is already there and the fd will not be
+ * signalled for it, run tiny_nmea_work() instead of sleeping
+ *
+ * @param w         wakeup
+ * @return          true if the watermark is already buffered
+ */
+bool tiny_nmea_wakeup_arm(tiny_nmea_wakeup_t *w);
+
+/**
+ * eventfd to add to poll/epoll with POLLIN, after it fired call
+ * tiny_nmea_wakeup_clear() then tiny_nmea_wakeup_arm() again
+ */
+int tiny_nmea_wakeup_fd(const tiny_nmea_wakeup_t *w);
+
+/**
+ * drain the eventfd after it fired, wakeups may be spurious so always
+ * check with tiny_nmea_wakeup_arm() before sleeping again
+ */
+void tiny_nmea_wakeup_clear(tiny_nmea_wakeup_t *w);
+
+/**
+ * wake the waiting thread regardless of the buffered data, e.g. on shutdown
+ * safe to call from any thread
+ */
+void tiny_nmea_wakeup_wake(tiny_nmea_wakeup_t *w);
+
+/**
+ * remove the feed callback from the ctx and close the eventfd
+ * no thread may be feeding or waiting
+ */
+void tiny_nmea_wakeup_deinit(tiny_nmea_wakeup_t *w);
+
+#endif //TINY_NMEA_TINY_NMEA_WAKEUP_H
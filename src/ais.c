@@ -0,0 +1,536 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+#include "tiny_nmea/ais.h"
+
+#include <string.h>
+
+// 6-bit value of every armor char, '0'-'W' and '`'-'w'
+// 0xFF for chars outside the alphabet so one or-ed high bit flags any of them
+static const uint8_t ais_armor_table[256] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x00
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x10
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x20
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,  // 0x30
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F,  // 0x40
+  0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x50
+  0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,  // 0x60
+  0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x70
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x80
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0x90
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0xA0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0xB0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0xC0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0xD0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0xE0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  // 0xF0
+};
+
+tiny_nmea_res_t tiny_nmea_ais_dearmor(const char *payload, size_t len, uint8_t fill_bits,
+                                      tiny_nmea_ais_bits_t *out) {
+  if (!payload || !out) return TINY_NMEA_ERR_NULL_PTR;
+  if (fill_bits > 5 || fill_bits > len * 6) return TINY_NMEA_ERR_INVALID_FORMAT;
+  if (len > TINY_NMEA_AIS_MAX_CHARS) return TINY_NMEA_ERR_OVERFLOW;
+
+  const uint8_t *p = (const uint8_t *)payload;
+  uint8_t *dst = out->bytes;
+  size_t i = 0;
+
+  // 4 chars are 24 bits, exactly 3 bytes
+  for (; i + 4 <= len; i += 4) {
+    const uint8_t a = ais_armor_table[p[i]];
+    const uint8_t b = ais_armor_table[p[i + 1]];
+    const uint8_t c = ais_armor_table[p[i + 2]];
+    const uint8_t d = ais_armor_table[p[i + 3]];
+    if ((a | b | c | d) & 0xC0) return TINY_NMEA_ERR_INVALID_FORMAT;
+
+    const uint32_t v = ((uint32_t)a << 18) | ((uint32_t)b << 12) | ((uint32_t)c << 6) | d;
+    dst[0] = (uint8_t)(v >> 16);
+    dst[1] = (uint8_t)(v >> 8);
+    dst[2] = (uint8_t)v;
+    dst += 3;
+  }
+
+  // remaining 1-3 chars, left aligned in the last group
+  if (i < len) {
+    uint32_t v = 0;
+    const size_t rem = len - i;
+    for (size_t k = 0; k < rem; k++) {
+      const uint8_t c = ais_armor_table[p[i + k]];
+      if (c & 0xC0) return TINY_NMEA_ERR_INVALID_FORMAT;
+      v |= (uint32_t)c << (18 - 6 * k);
+    }
+    dst[0] = (uint8_t)(v >> 16);
+    dst[1] = (uint8_t)(v >> 8);
+    dst[2] = (uint8_t)v;
+    dst += 3;
+  }
+
+  // clear the fill bits and everything after so reads past the end give 0
+  out->bit_len = (uint16_t)(len * 6 - fill_bits);
+  if (out->bit_len & 7) {
+    out->bytes[out->bit_len >> 3] &= (uint8_t)(0xFF00 >> (out->bit_len & 7));
+  }
+  const size_t used = ((size_t)out->bit_len + 7) >> 3;
+  memset(&out->bytes[used], 0, sizeof(out->bytes) - used);
+
+  return TINY_NMEA_OK;
+}
+
+size_t tiny_nmea_ais_get_text(const tiny_nmea_ais_bits_t *b, uint16_t start, uint8_t nchars,
+                              char *out, size_t out_size) {
+  if (!out || out_size == 0) return 0;
+
+  size_t n = 0;
+  for (uint8_t i = 0; i < nchars && n + 1 < out_size; i++) {
+    uint8_t v = (uint8_t)tiny_nmea_ais_get_uint(b, (uint16_t)(start + 6 * i), 6);
+    // '@' pads unused chars
+    if (v == 0) break;
+    // 6-bit ascii, 0-31 are '@'-'_' and 32-63 are ' '-'?'
+    out[n++] = (char)(v < 32 ? v + 64 : v);
+  }
+
+  while (n > 0 && out[n - 1] == ' ') n--;
+  out[n] = '\0';
+  return n;
+}
+
+// message layouts from ITU-R M.1371
+// X(kind, member, first bit, width), width is in chars for TEXT
+// U unsigned, I signed, B flag, TEXT 6-bit string
+#define AIS_POS_REPORT_LAYOUT(X)         \
+    X(U,    nav_status,         38,  4)  \
+    X(I,    rot,                42,  8)  \
+    X(U,    sog,                50, 10)  \
+    X(B,    accuracy,           60,  1)  \
+    X(I,    lon,                61, 28)  \
+    X(I,    lat,                89, 27)  \
+    X(U,    cog,               116, 12)  \
+    X(U,    heading,           128,  9)  \
+    X(U,    second,            137,  6)  \
+    X(U,    maneuver,          143,  2)  \
+    X(B,    raim,              148,  1)  \
+    X(U,    radio,             149, 19)
+
+#define AIS_STATIC_VOYAGE_LAYOUT(X)      \
+    X(U,    ais_version,        38,  2)  \
+    X(U,    imo,                40, 30)  \
+    X(TEXT, callsign,           70,  7)  \
+    X(TEXT, shipname,          112, 20)  \
+    X(U,    ship_type,         232,  8)  \
+    X(U,    dims.to_bow,       240,  9)  \
+    X(U,    dims.to_stern,     249,  9)  \
+    X(U,    dims.to_port,      258,  6)  \
+    X(U,    dims.to_starboard, 264,  6)  \
+    X(U,    epfd,              270,  4)  \
+    X(U,    eta_month,         274,  4)  \
+    X(U,    eta_day,           278,  5)  \
+    X(U,    eta_hour,          283,  5)  \
+    X(U,    eta_minute,        288,  6)  \
+    X(U,    draught,           294,  8)  \
+    X(TEXT, destination,       302, 20)  \
+    X(B,    dte,               422,  1)
+
+#define AIS_CLASS_B_POS_LAYOUT(X)        \
+    X(U,    sog,                46, 10)  \
+    X(B,    accuracy,           56,  1)  \
+    X(I,    lon,                57, 28)  \
+    X(I,    lat,                85, 27)  \
+    X(U,    cog,               112, 12)  \
+    X(U,    heading,           124,  9)  \
+    X(U,    second,            133,  6)  \
+    X(B,    cs_unit,           141,  1)  \
+    X(B,    display,           142,  1)  \
+    X(B,    dsc,               143,  1)  \
+    X(B,    band,              144,  1)  \
+    X(B,    msg22,             145,  1)  \
+    X(B,    assigned,          146,  1)  \
+    X(B,    raim,              147,  1)  \
+    X(U,    radio,             148, 20)
+
+#define AIS_CLASS_B_EXT_LAYOUT(X)        \
+    X(U,    sog,                46, 10)  \
+    X(B,    accuracy,           56,  1)  \
+    X(I,    lon,                57, 28)  \
+    X(I,    lat,                85, 27)  \
+    X(U,    cog,               112, 12)  \
+    X(U,    heading,           124,  9)  \
+    X(U,    second,            133,  6)  \
+    X(TEXT, shipname,          143, 20)  \
+    X(U,    ship_type,         263,  8)  \
+    X(U,    dims.to_bow,       271,  9)  \
+    X(U,    dims.to_stern,     280,  9)  \
+    X(U,    dims.to_port,      289,  6)  \
+    X(U,    dims.to_starboard, 295,  6)  \
+    X(U,    epfd,              301,  4)  \
+    X(B,    raim,              305,  1)  \
+    X(B,    dte,               306,  1)  \
+    X(B,    assigned,          307,  1)
+
+#define AIS_ATON_LAYOUT(X)               \
+    X(U,    aid_type,           38,  5)  \
+    X(TEXT, name,               43, 20)  \
+    X(B,    accuracy,          163,  1)  \
+    X(I,    lon,               164, 28)  \
+    X(I,    lat,               192, 27)  \
+    X(U,    dims.to_bow,       219,  9)  \
+    X(U,    dims.to_stern,     228,  9)  \
+    X(U,    dims.to_port,      237,  6)  \
+    X(U,    dims.to_starboard, 243,  6)  \
+    X(U,    epfd,              249,  4)  \
+    X(U,    second,            253,  6)  \
+    X(B,    off_position,      259,  1)  \
+    X(B,    raim,              268,  1)  \
+    X(B,    virtual_aid,       269,  1)  \
+    X(B,    assigned,          270,  1)
+
+#define AIS_STATIC_A_LAYOUT(X)           \
+    X(TEXT, shipname,           40, 20)
+
+#define AIS_STATIC_B_LAYOUT(X)           \
+    X(U,    ship_type,          40,  8)  \
+    X(TEXT, vendor_id,          48,  3)  \
+    X(U,    model,              66,  4)  \
+    X(U,    serial,             70, 20)  \
+    X(TEXT, callsign,           90,  7)
+
+#define AIS_STATIC_B_DIMS_LAYOUT(X)      \
+    X(U,    dims.to_bow,       132,  9)  \
+    X(U,    dims.to_stern,     141,  9)  \
+    X(U,    dims.to_port,      150,  6)  \
+    X(U,    dims.to_starboard, 156,  6)
+
+#define AIS_STATIC_B_AUX_LAYOUT(X)       \
+    X(U,    mothership_mmsi,   132, 30)
+
+// minimum bit length per message, shorter is rejected
+// type 5 is often sent 2-4 bits short of its 424 bits
+#define AIS_POS_REPORT_BITS     168
+#define AIS_STATIC_VOYAGE_BITS  420
+#define AIS_CLASS_B_POS_BITS    168
+#define AIS_CLASS_B_EXT_BITS    312
+#define AIS_ATON_BITS           272
+#define AIS_STATIC_A_BITS       160
+#define AIS_STATIC_B_BITS       162
+
+// expand a layout into straight line reads of bits into dst
+#define AIS_READ_U(dst, member, start, width)    (dst)->member = tiny_nmea_ais_get_uint(bits, start, width);
+#define AIS_READ_I(dst, member, start, width)    (dst)->member = tiny_nmea_ais_get_int(bits, start, width);
+#define AIS_READ_B(dst, member, start, width)    (dst)->member = tiny_nmea_ais_get_uint(bits, start, width) != 0;
+#define AIS_READ_TEXT(dst, member, start, width) \
+  tiny_nmea_ais_get_text(bits, start, width, (dst)->member, sizeof((dst)->member));
+
+#define AIS_READ_POS(kind, member, start, width)         AIS_READ_##kind(&out->data.pos, member, start, width)
+#define AIS_READ_VOYAGE(kind, member, start, width)      AIS_READ_##kind(&out->data.voyage, member, start, width)
+#define AIS_READ_CLASS_B(kind, member, start, width)     AIS_READ_##kind(&out->data.class_b, member, start, width)
+#define AIS_READ_CLASS_B_EXT(kind, member, start, width) AIS_READ_##kind(&out->data.class_b_ext, member, start, width)
+#define AIS_READ_ATON(kind, member, start, width)        AIS_READ_##kind(&out->data.aton, member, start, width)
+#define AIS_READ_STATIC(kind, member, start, width)      AIS_READ_##kind(&out->data.static_data, member, start, width)
+
+// an mmsi of the form 98xxxxxxx is an auxiliary craft of a mothership
+#define AIS_MMSI_IS_AUX(mmsi) ((mmsi) / 10000000 == 98)
+
+// bits of the aid to nav name extension, at most 14 chars
+#define AIS_ATON_NAME_EXT_START 272
+#define AIS_ATON_NAME_EXT_CHARS 14
+
+tiny_nmea_res_t tiny_nmea_ais_decode_bits(const tiny_nmea_ais_bits_t *bits, tiny_nmea_ais_msg_t *out) {
+  if (!bits || !out) return TINY_NMEA_ERR_NULL_PTR;
+
+  // every message starts with type, repeat indicator and mmsi
+  if (bits->bit_len < 38) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+
+  memset(out, 0, sizeof(*out));
+  out->type = (uint8_t)tiny_nmea_ais_get_uint(bits, 0, 6);
+  out->repeat = (uint8_t)tiny_nmea_ais_get_uint(bits, 6, 2);
+  out->mmsi = tiny_nmea_ais_get_uint(bits, 8, 30);
+
+  switch (out->type) {
+    case 1:
+    case 2:
+    case 3:
+      if (bits->bit_len < AIS_POS_REPORT_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+      AIS_POS_REPORT_LAYOUT(AIS_READ_POS)
+      break;
+
+    case 5:
+      if (bits->bit_len < AIS_STATIC_VOYAGE_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+      AIS_STATIC_VOYAGE_LAYOUT(AIS_READ_VOYAGE)
+      break;
+
+    case 18:
+      if (bits->bit_len < AIS_CLASS_B_POS_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+      AIS_CLASS_B_POS_LAYOUT(AIS_READ_CLASS_B)
+      break;
+
+    case 19:
+      if (bits->bit_len < AIS_CLASS_B_EXT_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+      AIS_CLASS_B_EXT_LAYOUT(AIS_READ_CLASS_B_EXT)
+      break;
+
+    case 21: {
+      if (bits->bit_len < AIS_ATON_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+      AIS_ATON_LAYOUT(AIS_READ_ATON)
+
+      // the name continues in the trailing bits if it is longer than 20 chars
+      tiny_nmea_ais_aton_t *aton = &out->data.aton;
+      size_t name_len = strlen(aton->name);
+      uint16_t ext_chars = (uint16_t)((bits->bit_len - AIS_ATON_NAME_EXT_START) / 6);
+      if (name_len == 20 && ext_chars > 0) {
+        if (ext_chars > AIS_ATON_NAME_EXT_CHARS) ext_chars = AIS_ATON_NAME_EXT_CHARS;
+        tiny_nmea_ais_get_text(bits, AIS_ATON_NAME_EXT_START, (uint8_t)ext_chars,
+                               aton->name + name_len, sizeof(aton->name) - name_len);
+      }
+      break;
+    }
+
+    case 24: {
+      tiny_nmea_ais_static_data_t *sd = &out->data.static_data;
+      sd->part_num = (uint8_t)tiny_nmea_ais_get_uint(bits, 38, 2);
+      if (sd->part_num == 0) {
+        if (bits->bit_len < AIS_STATIC_A_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+        AIS_STATIC_A_LAYOUT(AIS_READ_STATIC)
+      } else if (sd->part_num == 1) {
+        if (bits->bit_len < AIS_STATIC_B_BITS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+        AIS_STATIC_B_LAYOUT(AIS_READ_STATIC)
+        if (AIS_MMSI_IS_AUX(out->mmsi)) {
+          AIS_STATIC_B_AUX_LAYOUT(AIS_READ_STATIC)
+        } else {
+          AIS_STATIC_B_DIMS_LAYOUT(AIS_READ_STATIC)
+        }
+      } else {
+        return TINY_NMEA_ERR_INVALID_FORMAT;
+      }
+      break;
+    }
+
+    default:
+      return TINY_NMEA_ERR_UNSUPPORTED;
+  }
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_ais_decode(const tiny_nmea_ais_t *ais, tiny_nmea_ais_msg_t *out) {
+  if (!ais || !out) return TINY_NMEA_ERR_NULL_PTR;
+  if (ais->fragment_count > 1) return TINY_NMEA_ERR_INCOMPLETE;
+
+  tiny_nmea_ais_bits_t bits;
+  tiny_nmea_res_t res = tiny_nmea_ais_dearmor(ais->payload, ais->payload_len, ais->fill_bits, &bits);
+  if (res != TINY_NMEA_OK) return res;
+
+  return tiny_nmea_ais_decode_bits(&bits, out);
+}
+
+tiny_nmea_res_t tiny_nmea_ais_decode_payload(const tiny_nmea_ais_payload_t *payload, tiny_nmea_ais_msg_t *out) {
+  if (!payload || !out) return TINY_NMEA_ERR_NULL_PTR;
+
+  tiny_nmea_ais_bits_t bits;
+  tiny_nmea_res_t res = tiny_nmea_ais_dearmor(payload->payload, payload->len, payload->fill_bits, &bits);
+  if (res != TINY_NMEA_OK) return res;
+
+  return tiny_nmea_ais_decode_bits(&bits, out);
+}
+
+// fragment reassembly
+
+#define REASM_MASK (TINY_NMEA_AIS_REASM_SLOTS - 1)
+
+// backward shift deletion, keeps every probe chain unbroken without tombstones
+static void reasm_remove(tiny_nmea_ais_reasm_t *r, uint8_t i) {
+  uint8_t j = i;
+  r->active--;
+
+  for (;;) {
+    r->slots[i].used = false;
+    for (;;) {
+      j = (j + 1) & REASM_MASK;
+      if (!r->slots[j].used) return;
+      // entry at j may fill the hole at i only if its home is not within (i, j]
+      uint8_t k = r->slots[j].home;
+      bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+      if (!stays) break;
+    }
+    r->slots[i] = r->slots[j];
+    i = j;
+  }
+}
+
+static bool reasm_expired(const tiny_nmea_ais_reasm_t *r, const tiny_nmea_ais_reasm_slot_t *s, uint32_t now_ms) {
+  return (uint32_t)(now_ms - s->first_ms) >= r->timeout_ms;
+}
+
+tiny_nmea_res_t tiny_nmea_ais_reasm_init(tiny_nmea_ais_reasm_t *r, uint32_t timeout_ms) {
+  if (!r) return TINY_NMEA_ERR_NULL_PTR;
+
+  memset(r, 0, sizeof(*r));
+  r->timeout_ms = timeout_ms ? timeout_ms : TINY_NMEA_AIS_REASM_TIMEOUT_MS;
+  return TINY_NMEA_OK;
+}
+
+uint8_t tiny_nmea_ais_reasm_expire(tiny_nmea_ais_reasm_t *r, uint32_t now_ms) {
+  if (!r || r->active == 0) return 0;
+
+  uint8_t dropped = 0;
+  for (uint8_t i = 0; i < TINY_NMEA_AIS_REASM_SLOTS; i++) {
+    // removal may shift another entry into i, check it again
+    while (r->slots[i].used && reasm_expired(r, &r->slots[i], now_ms)) {
+      reasm_remove(r, i);
+      dropped++;
+    }
+  }
+
+  r->stats.timed_out += dropped;
+  return dropped;
+}
+
+// the table itself works without AIS sentences compiled in, only adding needs them
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
+static uint8_t reasm_hash(tiny_nmea_talker_t talker, tiny_nmea_sentence_type_t type, char channel,
+                          uint8_t sequential_id) {
+  uint32_t h = (uint32_t)talker * 0x9E3779B1u;
+  h ^= ((uint32_t)type << 16) ^ ((uint32_t)(uint8_t)channel << 8) ^ sequential_id;
+  h ^= h >> 15;
+  h *= 0x2C1B3C6Du;
+  h ^= h >> 12;
+  return (uint8_t)(h & REASM_MASK);
+}
+
+static bool reasm_key_eq(const tiny_nmea_ais_reasm_slot_t *s, tiny_nmea_talker_t talker,
+                         tiny_nmea_sentence_type_t type, char channel, uint8_t sequential_id) {
+  return s->talker == talker && s->type == type && s->channel == channel && s->sequential_id == sequential_id;
+}
+
+// make room for one more entry by dropping the message waiting the longest
+static void reasm_evict_oldest(tiny_nmea_ais_reasm_t *r, uint32_t now_ms) {
+  uint8_t oldest = 0;
+  uint32_t oldest_age = 0;
+  for (uint8_t i = 0; i < TINY_NMEA_AIS_REASM_SLOTS; i++) {
+    uint32_t age = now_ms - r->slots[i].first_ms;
+    if (age >= oldest_age) {
+      oldest_age = age;
+      oldest = i;
+    }
+  }
+  reasm_remove(r, oldest);
+  r->stats.evicted++;
+}
+
+static void reasm_emit(const tiny_nmea_ais_reasm_slot_t *s, tiny_nmea_ais_payload_t *out) {
+  out->talker = s->talker;
+  out->type = s->type;
+  out->channel = s->channel;
+  out->fill_bits = s->fill_bits;
+  out->len = s->len;
+
+  // fragments are stored in arrival order, join them in fragment order
+  char *dst = out->payload;
+  for (uint8_t f = 0; f < s->fragment_count; f++) {
+    memcpy(dst, &s->payload[s->frag_off[f]], s->frag_len[f]);
+    dst += s->frag_len[f];
+  }
+  *dst = '\0';
+}
+
+tiny_nmea_res_t tiny_nmea_ais_reasm_add(tiny_nmea_ais_reasm_t *r, const tiny_nmea_type_t *sentence,
+                                        uint32_t now_ms, tiny_nmea_ais_payload_t *out) {
+  if (!r || !sentence || !out) return TINY_NMEA_ERR_NULL_PTR;
+  if (sentence->type != TINY_NMEA_SENTENCE_VDM && sentence->type != TINY_NMEA_SENTENCE_VDO) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  const tiny_nmea_ais_t *ais = &sentence->data.ais;
+  if (ais->fragment_count == 0 || ais->fragment_count > TINY_NMEA_AIS_MAX_FRAGMENTS ||
+      ais->fragment_number == 0 || ais->fragment_number > ais->fragment_count) {
+    r->stats.dropped++;
+    return TINY_NMEA_ERR_INVALID_FORMAT;
+  }
+
+  // nothing to join
+  if (ais->fragment_count == 1) {
+    out->talker = sentence->talker;
+    out->type = sentence->type;
+    out->channel = ais->channel;
+    out->fill_bits = ais->fill_bits;
+    out->len = ais->payload_len;
+    memcpy(out->payload, ais->payload, ais->payload_len);
+    out->payload[ais->payload_len] = '\0';
+    r->stats.completed++;
+    return TINY_NMEA_OK;
+  }
+
+  tiny_nmea_ais_reasm_expire(r, now_ms);
+
+  uint8_t home = reasm_hash(sentence->talker, sentence->type, ais->channel, ais->sequential_id);
+  uint8_t i = home;
+  tiny_nmea_ais_reasm_slot_t *s = NULL;
+  for (uint8_t n = 0; n < TINY_NMEA_AIS_REASM_SLOTS && r->slots[i].used; n++) {
+    if (reasm_key_eq(&r->slots[i], sentence->talker, sentence->type, ais->channel, ais->sequential_id)) {
+      s = &r->slots[i];
+      break;
+    }
+    i = (i + 1) & REASM_MASK;
+  }
+
+  uint16_t bit = (uint16_t)(1u << (ais->fragment_number - 1));
+
+  // a repeated fragment or a different count means the rest of the old message
+  // was lost and the sequential id got reused, start over with this one
+  if (s && (s->fragment_count != ais->fragment_count || (s->received & bit))) {
+    reasm_remove(r, i);
+    r->stats.dropped++;
+    s = NULL;
+  }
+
+  if (!s) {
+    if (r->active == TINY_NMEA_AIS_REASM_SLOTS) reasm_evict_oldest(r, now_ms);
+
+    // removals may have shifted the chain, find the first free slot again
+    i = home;
+    while (r->slots[i].used) i = (i + 1) & REASM_MASK;
+
+    s = &r->slots[i];
+    s->used = true;
+    s->home = home;
+    s->talker = sentence->talker;
+    s->type = sentence->type;
+    s->channel = ais->channel;
+    s->sequential_id = ais->sequential_id;
+    s->fragment_count = ais->fragment_count;
+    s->received = 0;
+    s->fill_bits = 0;
+    s->len = 0;
+    s->first_ms = now_ms;
+    r->active++;
+  }
+
+  if (s->len + ais->payload_len > TINY_NMEA_AIS_MAX_CHARS) {
+    reasm_remove(r, i);
+    r->stats.dropped++;
+    return TINY_NMEA_ERR_OVERFLOW;
+  }
+
+  uint8_t f = ais->fragment_number - 1;
+  memcpy(&s->payload[s->len], ais->payload, ais->payload_len);
+  s->frag_off[f] = s->len;
+  s->frag_len[f] = ais->payload_len;
+  s->len += ais->payload_len;
+  s->received |= bit;
+  if (ais->fragment_number == ais->fragment_count) s->fill_bits = ais->fill_bits;
+
+  if (s->received != (uint16_t)((1u << s->fragment_count) - 1)) return TINY_NMEA_ERR_INCOMPLETE;
+
+  reasm_emit(s, out);
+  reasm_remove(r, i);
+  r->stats.completed++;
+  return TINY_NMEA_OK;
+}
+#else
+tiny_nmea_res_t tiny_nmea_ais_reasm_add(tiny_nmea_ais_reasm_t *r, const tiny_nmea_type_t *sentence,
+                                        uint32_t now_ms, tiny_nmea_ais_payload_t *out) {
+  (void)now_ms;
+  if (!r || !sentence || !out) return TINY_NMEA_ERR_NULL_PTR;
+  return TINY_NMEA_ERR_UNSUPPORTED;
+}
+#endif // TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
@@ -3,6 +3,7 @@
 //
 
 #include "tiny_nmea/internal/data_formats.h"
+#include "tiny_nmea/internal/nmea_0183_types.h"
 
 double tiny_nmea_coord_to_degrees(const tiny_nmea_coord_t *coord) {
     if (coord->hemisphere == '\0' || coord->raw.scale == 0) {
@@ -43,6 +44,31 @@ int32_t tiny_nmea_coord_to_fixed_degrees(const tiny_nmea_coord_t *coord) {
     // minutes_frac = raw_int - degrees_int * 100 * scale
     // result = degrees_int * 10^7 + (minutes_frac * 10^7) / (60 * scale)
 
+    const int64_t SCALE_OUT = 10000000;  // 10^7
+
+    // parsed coordinates have a power of ten scale and are never negative,
+    // so the divides by 100 * scale and 60 * scale become reciprocal multiplies
+    uint8_t exp = tiny_nmea_fp_exponent(&coord->raw);
+    if (exp != TINY_NMEA_FP_EXP_INVALID && coord->raw.value >= 0) {
+        uint32_t raw_u = (uint32_t)coord->raw.value;
+        uint32_t degrees_u = tiny_nmea_div_pow10(raw_u, exp + 2);
+        uint32_t minutes_u = (uint32_t)(raw_u - (uint64_t)degrees_u * 100u * (uint32_t)tiny_nmea_pow10[exp]);
+
+        // minutes * 10^7 / 60, minutes < 100 * 10^exp so this stays below 10^9
+        uint32_t frac;
+        if (exp <= 7) {
+            frac = minutes_u * (uint32_t)tiny_nmea_pow10[7 - exp] / 60u;
+        } else {
+            frac = tiny_nmea_div_pow10(minutes_u, exp - 7) / 60u;
+        }
+
+        int64_t result = (int64_t)degrees_u * SCALE_OUT + frac;
+        if (coord->hemisphere == 'S' || coord->hemisphere == 'W') {
+            result = -result;
+        }
+        return (int32_t)result;
+    }
+
     int64_t raw = coord->raw.value;
     int64_t scale = coord->raw.scale;
 
@@ -54,8 +80,6 @@ int32_t tiny_nmea_coord_to_fixed_degrees(const tiny_nmea_coord_t *coord) {
 
     // convert to degrees * 10^7
     // degrees * 10^7 + (minutes_scaled * 10^7) / (60 * scale)
-    const int64_t SCALE_OUT = 10000000;  // 10^7
-
     int64_t result = degrees * SCALE_OUT + (minutes_scaled * SCALE_OUT) / (60 * scale);
 
     // account for hemisphere
@@ -83,3 +107,125 @@ int32_t tiny_nmea_knots_to_kph(const tiny_nmea_float_t *knots) {
     return (int32_t)(((int64_t)knots->value * 1852) / knots->scale);
 }
 
+
+#define MS_PER_DAY 86400000u
+
+tiny_nmea_time_ms_t tiny_nmea_time_pack(const tiny_nmea_time_t *t) {
+    if (!t->valid) return TINY_NMEA_TIME_MS_INVALID;
+
+    uint32_t secs = ((uint32_t)t->hours * 60u + t->minutes) * 60u + t->seconds;
+    return secs * 1000u + t->microseconds / 1000u;
+}
+
+tiny_nmea_time_t tiny_nmea_time_unpack(tiny_nmea_time_ms_t ms) {
+    tiny_nmea_time_t t = {0};
+    // one extra second for 23:59:60
+    if (ms >= MS_PER_DAY + 1000u) return t;
+
+    t.microseconds = (ms % 1000u) * 1000u;
+    uint32_t secs = ms / 1000u;
+    if (secs == 86400u) {
+        // leap second, don't roll over to 24:00:00
+        t.hours = 23;
+        t.minutes = 59;
+        t.seconds = 60;
+    } else {
+        t.hours = (uint8_t)(secs / 3600u);
+        t.minutes = (uint8_t)(secs / 60u % 60u);
+        t.seconds = (uint8_t)(secs % 60u);
+    }
+    t.valid = true;
+    return t;
+}
+
+tiny_nmea_date_packed_t tiny_nmea_date_pack(const tiny_nmea_date_t *d) {
+    // day is never 0 for a valid date, so 0 stays free for invalid
+    if (!d->valid || d->day == 0) return TINY_NMEA_DATE_PACKED_INVALID;
+
+    return (uint32_t)(d->day & 0x1Fu)
+         | (uint32_t)(d->month & 0x0Fu) << 5
+         | (uint32_t)(d->year_yy & 0x7Fu) << 9
+         | (uint32_t)d->year << 16;
+}
+
+tiny_nmea_date_t tiny_nmea_date_unpack(tiny_nmea_date_packed_t p) {
+    tiny_nmea_date_t d = {0};
+    if (p == TINY_NMEA_DATE_PACKED_INVALID) return d;
+
+    d.day = (uint8_t)(p & 0x1Fu);
+    d.month = (uint8_t)(p >> 5 & 0x0Fu);
+    d.year_yy = (uint8_t)(p >> 9 & 0x7Fu);
+    d.year = (uint16_t)(p >> 16);
+    d.valid = true;
+    return d;
+}
+
+int32_t tiny_nmea_coord_pack(const tiny_nmea_coord_t *coord, uint8_t *exp) {
+    // the parser keeps a value without hemisphere and the other way round,
+    // so both halves of the byte are stored on their own
+    uint8_t e = coord->raw.scale != 0 ? tiny_nmea_fp_exponent(&coord->raw) : TINY_NMEA_FP_EXP_INVALID;
+    if (e > TINY_NMEA_FP_EXP_MAX) e = TINY_NMEA_COORD_EXP_MASK;
+
+    uint8_t hemi = TINY_NMEA_COORD_HEMI_NONE;
+    if (coord->hemisphere == 'S' || coord->hemisphere == 'W') {
+        hemi = TINY_NMEA_COORD_HEMI_NEG;
+    } else if (coord->hemisphere != '\0') {
+        hemi = TINY_NMEA_COORD_HEMI_POS;
+    }
+    *exp = (uint8_t)(hemi << TINY_NMEA_COORD_HEMI_SHIFT | e);
+
+    if (e == TINY_NMEA_COORD_EXP_MASK) return 0;
+    return hemi == TINY_NMEA_COORD_HEMI_NEG ? -coord->raw.value : coord->raw.value;
+}
+
+tiny_nmea_coord_t tiny_nmea_coord_unpack(int32_t value, uint8_t exp, bool is_lon) {
+    tiny_nmea_coord_t coord = {0};
+    uint8_t e = exp & TINY_NMEA_COORD_EXP_MASK;
+    uint8_t hemi = exp >> TINY_NMEA_COORD_HEMI_SHIFT;
+
+    // raw NMEA values are never negative, the sign is the hemisphere
+    if (e <= TINY_NMEA_FP_EXP_MAX) {
+        coord.raw = tiny_nmea_fp_from_exponent(value < 0 ? -value : value, e);
+    }
+    if (hemi == TINY_NMEA_COORD_HEMI_NEG) {
+        coord.hemisphere = is_lon ? 'W' : 'S';
+    } else if (hemi == TINY_NMEA_COORD_HEMI_POS) {
+        coord.hemisphere = is_lon ? 'E' : 'N';
+    }
+    return coord;
+}
+
+void tiny_nmea_rmc_compact(const tiny_nmea_rmc_t *rmc, tiny_nmea_rmc_compact_t *out) {
+    out->time_ms = tiny_nmea_time_pack(&rmc->time);
+    out->date = tiny_nmea_date_pack(&rmc->date);
+    out->latitude = tiny_nmea_coord_pack(&rmc->latitude, &out->latitude_exp);
+    out->longitude = tiny_nmea_coord_pack(&rmc->longitude, &out->longitude_exp);
+
+    out->speed_knots = rmc->speed_knots.value;
+    out->speed_knots_exp = tiny_nmea_fp_exponent(&rmc->speed_knots);
+    out->course_deg = rmc->course_deg.value;
+    out->course_deg_exp = tiny_nmea_fp_exponent(&rmc->course_deg);
+    out->mag_variation = rmc->mag_variation.value;
+    out->mag_variation_exp = tiny_nmea_fp_exponent(&rmc->mag_variation);
+
+    out->mag_var_dir = rmc->mag_var_dir;
+    out->faa_mode = rmc->faa_mode;
+    out->nav_status = rmc->nav_status;
+    out->status_valid = rmc->status_valid;
+}
+
+void tiny_nmea_rmc_expand(const tiny_nmea_rmc_compact_t *c, tiny_nmea_rmc_t *out) {
+    out->time = tiny_nmea_time_unpack(c->time_ms);
+    out->date = tiny_nmea_date_unpack(c->date);
+    out->latitude = tiny_nmea_coord_unpack(c->latitude, c->latitude_exp, false);
+    out->longitude = tiny_nmea_coord_unpack(c->longitude, c->longitude_exp, true);
+
+    out->speed_knots = tiny_nmea_fp_from_exponent(c->speed_knots, c->speed_knots_exp);
+    out->course_deg = tiny_nmea_fp_from_exponent(c->course_deg, c->course_deg_exp);
+    out->mag_variation = tiny_nmea_fp_from_exponent(c->mag_variation, c->mag_variation_exp);
+
+    out->mag_var_dir = c->mag_var_dir;
+    out->faa_mode = c->faa_mode;
+    out->nav_status = c->nav_status;
+    out->status_valid = c->status_valid;
+}
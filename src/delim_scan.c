@@ -0,0 +1,180 @@
+//
+// Created by Lin Yicheng on 2/9/26.
+//
+
+#include "tiny_nmea/internal/delim_scan.h"
+#include "tiny_nmea/internal/util.h"
+
+#include <string.h>
+
+// pick the widest kernel the target supports at build time
+// TINY_NMEA_SCAN_PORTABLE forces the SWAR kernel everywhere
+#if !defined(TINY_NMEA_SCAN_PORTABLE) && defined(__AVX2__)
+  #define DELIM_KERNEL_AVX2
+  #include <immintrin.h>
+#elif !defined(TINY_NMEA_SCAN_PORTABLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #define DELIM_KERNEL_SSE2
+  #include <emmintrin.h>
+#elif !defined(TINY_NMEA_SCAN_PORTABLE) && defined(__ARM_NEON) && defined(__aarch64__)
+  #define DELIM_KERNEL_NEON
+  #include <arm_neon.h>
+#endif
+
+const uint8_t delim_class_table[256] = {
+  ['$']  = DELIM_START,
+  ['!']  = DELIM_START,
+  ['*']  = DELIM_STAR,
+  ['\r'] = DELIM_EOL,
+  ['\n'] = DELIM_EOL,
+};
+
+// portable kernel
+
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+  #define DELIM_SWAR_LE
+#endif
+
+#define SWAR_ONES  0x0101010101010101ULL
+#define SWAR_LOW7  0x7F7F7F7F7F7F7F7FULL
+
+#ifdef DELIM_SWAR_LE
+// high bit of each byte set iff that byte of x equals c
+// exact per byte, no borrow leaking into the neighbouring bytes
+static inline uint64_t swar_eq(uint64_t x, uint8_t c) {
+  const uint64_t y = x ^ (SWAR_ONES * c);
+  const uint64_t t = (y & SWAR_LOW7) + SWAR_LOW7;
+  return ~(t | y | SWAR_LOW7);
+}
+
+// gather the high bit of each byte into an 8 bit mask, byte 0 in bit 0
+static inline uint8_t swar_movemask(uint64_t hi) {
+  return (uint8_t)(((hi >> 7) * 0x0102040810204080ULL) >> 56);
+}
+
+static inline uint8_t swar_mask8(const uint8_t *p) {
+  uint64_t x;
+  memcpy(&x, p, sizeof(x));
+  return swar_movemask(swar_eq(x, '$') | swar_eq(x, '!') | swar_eq(x, '*') |
+                       swar_eq(x, '\r') | swar_eq(x, '\n'));
+}
+#endif
+
+static inline uint64_t scan_tail(const uint8_t *p, size_t from, size_t len) {
+  uint64_t mask = 0;
+  for (size_t i = from; i < len; i++) {
+    mask |= (uint64_t)(delim_class_table[p[i]] != 0) << i;
+  }
+  return mask;
+}
+
+uint64_t delim_scan_block_portable(const uint8_t *p, size_t len) {
+  uint64_t mask = 0;
+  size_t i = 0;
+#ifdef DELIM_SWAR_LE
+  for (; i + 8 <= len; i += 8) {
+    mask |= (uint64_t)swar_mask8(p + i) << i;
+  }
+#endif
+  return mask | scan_tail(p, i, len);
+}
+
+// simd kernels
+
+#if defined(DELIM_KERNEL_AVX2)
+
+static inline uint32_t avx2_mask32(const uint8_t *p) {
+  const __m256i v = _mm256_loadu_si256((const __m256i *)p);
+  __m256i m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('$'));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('!')));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+  m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+  return (uint32_t)_mm256_movemask_epi8(m);
+}
+
+#define SIMD_WIDTH 32
+#define SIMD_MASK(p) avx2_mask32(p)
+
+#elif defined(DELIM_KERNEL_SSE2)
+
+static inline uint32_t sse2_mask16(const uint8_t *p) {
+  const __m128i v = _mm_loadu_si128((const __m128i *)p);
+  __m128i m = _mm_cmpeq_epi8(v, _mm_set1_epi8('$'));
+  m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('!')));
+  m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+  m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+  m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+  return (uint32_t)_mm_movemask_epi8(m);
+}
+
+#define SIMD_WIDTH 16
+#define SIMD_MASK(p) sse2_mask16(p)
+
+#elif defined(DELIM_KERNEL_NEON)
+
+static inline uint32_t neon_mask16(const uint8_t *p) {
+  static const uint8_t bit_weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                          1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t v = vld1q_u8(p);
+  uint8x16_t m = vceqq_u8(v, vdupq_n_u8('$'));
+  m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('!')));
+  m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('*')));
+  m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\r')));
+  m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\n')));
+  // no movemask on neon, weight each lane by its bit and sum the halves
+  m = vandq_u8(m, vld1q_u8(bit_weights));
+  return (uint32_t)vaddv_u8(vget_low_u8(m)) | ((uint32_t)vaddv_u8(vget_high_u8(m)) << 8);
+}
+
+#define SIMD_WIDTH 16
+#define SIMD_MASK(p) neon_mask16(p)
+
+#endif
+
+uint64_t delim_scan_block(const uint8_t *p, size_t len) {
+#ifdef SIMD_WIDTH
+  uint64_t mask = 0;
+  size_t i = 0;
+  for (; i + SIMD_WIDTH <= len; i += SIMD_WIDTH) {
+    mask |= (uint64_t)SIMD_MASK(p + i) << i;
+  }
+  // leftover bytes go through the portable kernel
+  if (i < len) {
+    mask |= delim_scan_block_portable(p + i, len - i) << i;
+  }
+  return mask;
+#else
+  return delim_scan_block_portable(p, len);
+#endif
+}
+
+size_t delim_find(const uint8_t *p, size_t len, uint8_t want) {
+  for (size_t base = 0; base < len; base += DELIM_BLOCK_LEN) {
+    const size_t n = min_size(len - base, DELIM_BLOCK_LEN);
+    uint64_t mask = delim_scan_block(p + base, n);
+
+    // walk the structural chars in order, the first one of
+    // a wanted class is the answer, others are skipped
+    while (mask) {
+      const unsigned i = ctz64(mask);
+      if (delim_class_table[p[base + i]] & want) {
+        return base + i;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return DELIM_NPOS;
+}
+
+const char *delim_scan_kernel_name(void) {
+#if defined(DELIM_KERNEL_AVX2)
+  return "avx2";
+#elif defined(DELIM_KERNEL_SSE2)
+  return "sse2";
+#elif defined(DELIM_KERNEL_NEON)
+  return "neon";
+#else
+  return "swar";
+#endif
+}
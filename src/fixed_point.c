@@ -3,6 +3,47 @@
 //
 
 #include "tiny_nmea/internal/fixed_point.h"
+#include "tiny_nmea/internal/util.h"
+
+const int32_t tiny_nmea_pow10[TINY_NMEA_FP_EXP_MAX + 1] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+// mul = ceil(2^shift / 10^exp) with shift = 31 + ceil(log2(10^exp))
+// checked against x / 10^exp for every x in [0, 2^31]
+const uint32_t tiny_nmea_pow10_recip_mul[TINY_NMEA_FP_EXP_MAX + 1] = {
+  1u, 0xCCCCCCCDu, 0xA3D70A3Eu, 0x83126E98u, 0xD1B71759u,
+  0xA7C5AC48u, 0x8637BD06u, 0xD6BF94D6u, 0xABCC7712u, 0x89705F42u,
+};
+const uint8_t tiny_nmea_pow10_recip_shift[TINY_NMEA_FP_EXP_MAX + 1] = {
+  0, 35, 38, 41, 45, 48, 51, 55, 58, 61,
+};
+
+// powers of ten all have different bit lengths, so the bit length picks the
+// only candidate exponent. stored as exp + 1, 0 means no power of ten
+static const uint8_t exp_by_bit_len[33] = {
+  [1] = 1, [4] = 2, [7] = 3, [10] = 4, [14] = 5,
+  [17] = 6, [20] = 7, [24] = 8, [27] = 9, [30] = 10,
+};
+
+static uint8_t scale_exponent(int32_t scale) {
+  if (scale <= 0) return TINY_NMEA_FP_EXP_INVALID;
+
+  uint8_t exp = exp_by_bit_len[32 - clz32((uint32_t)scale)];
+  if (exp == 0 || tiny_nmea_pow10[exp - 1] != scale) return TINY_NMEA_FP_EXP_INVALID;
+  return (uint8_t)(exp - 1);
+}
+
+// value * 10^to / 10^from, truncated toward zero like the integer divide
+static int32_t rescale_exp(int32_t value, uint8_t from, uint8_t to) {
+  if (to >= from) {
+    return (int32_t)((int64_t)value * tiny_nmea_pow10[to - from]);
+  }
+
+  uint32_t mag = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+  int32_t q = (int32_t)tiny_nmea_div_pow10(mag, (uint8_t)(from - to));
+  return value < 0 ? -q : q;
+}
 
 float tiny_nmea_to_float(const tiny_nmea_float_t *f) {
   if (!tiny_nmea_float_valid(f)) return 0.0f;
@@ -23,6 +64,13 @@ int32_t tiny_nmea_rescale(const tiny_nmea_float_t *f, int32_t new_scale) {
     return f->value;
   }
 
+  uint8_t from = scale_exponent(f->scale);
+  uint8_t to = scale_exponent(new_scale);
+  if (from != TINY_NMEA_FP_EXP_INVALID && to != TINY_NMEA_FP_EXP_INVALID) {
+    return rescale_exp(f->value, from, to);
+  }
+
+  // arbitrary scales, e.g. after tiny_nmea_fp_div_int
   // int64_t for intermediate to avoid overflow
   return (int32_t)(((int64_t)f->value * new_scale) / f->scale);
 }
@@ -36,6 +84,15 @@ tiny_nmea_float_t tiny_nmea_fp_mul_int(const tiny_nmea_float_t *f, int32_t n) {
 // Helper: add two fixed-point numbers (rescales to common scale)
 tiny_nmea_float_t tiny_nmea_fp_add(const tiny_nmea_float_t *a,
                                         const tiny_nmea_float_t *b) {
+  uint8_t ea = scale_exponent(a->scale);
+  uint8_t eb = scale_exponent(b->scale);
+  if (ea != TINY_NMEA_FP_EXP_INVALID && eb != TINY_NMEA_FP_EXP_INVALID) {
+    // the larger exponent is the common one, so this only ever multiplies
+    uint8_t e = ea > eb ? ea : eb;
+    return (tiny_nmea_float_t){.value = rescale_exp(a->value, ea, e) + rescale_exp(b->value, eb, e),
+                               .scale = tiny_nmea_pow10[e]};
+  }
+
   // Use larger scale as common scale
   if (a->scale >= b->scale) {
     int32_t b_rescaled = tiny_nmea_rescale(b, a->scale);
@@ -47,8 +104,17 @@ tiny_nmea_float_t tiny_nmea_fp_add(const tiny_nmea_float_t *a,
 }
 
 // Helper: divide fixed-point by integer (increases scale to maintain precision)
-tiny_nmea_float_t fp_div_int(const tiny_nmea_float_t *f, int32_t n) {
+tiny_nmea_float_t tiny_nmea_fp_div_int(const tiny_nmea_float_t *f, int32_t n) {
   // To divide by n without losing precision, multiply scale by n
   // value/scale ÷ n = value/(scale*n)
   return (tiny_nmea_float_t){.value = f->value, .scale = f->scale * n};
 }
+
+uint8_t tiny_nmea_fp_exponent(const tiny_nmea_float_t *f) {
+  return scale_exponent(f->scale);
+}
+
+tiny_nmea_float_t tiny_nmea_fp_from_exponent(int32_t value, uint8_t exp) {
+  if (exp > TINY_NMEA_FP_EXP_MAX) return (tiny_nmea_float_t){0, 0};
+  return (tiny_nmea_float_t){.value = value, .scale = tiny_nmea_pow10[exp]};
+}
@@ -0,0 +1,227 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+#include "tiny_nmea/lazy_fields.h"
+#include "tiny_nmea/tiny_nmea.h"
+#include "tiny_nmea/internal/parse_sentence_fields.h"
+#include "tiny_nmea/internal/sentences.h"
+
+// field index of each lazy field per sentence type, stored as index + 1
+// so that the zero default of the designated initializers means absent
+// coordinates are followed by their hemisphere field
+#define AT(idx) ((idx) + 1)
+
+static const uint8_t lazy_field_index[TINY_NMEA_SENTENCE_COUNT][TINY_NMEA_LAZY_FIELD_COUNT] = {
+  [TINY_NMEA_SENTENCE_RMC] = {
+    [TINY_NMEA_LAZY_TIME] = AT(0),
+    [TINY_NMEA_LAZY_STATUS] = AT(1),
+    [TINY_NMEA_LAZY_LATITUDE] = AT(2),
+    [TINY_NMEA_LAZY_LONGITUDE] = AT(4),
+    [TINY_NMEA_LAZY_SPEED_KNOTS] = AT(6),
+    [TINY_NMEA_LAZY_COURSE] = AT(7),
+    [TINY_NMEA_LAZY_DATE] = AT(8),
+  },
+  [TINY_NMEA_SENTENCE_GGA] = {
+    [TINY_NMEA_LAZY_TIME] = AT(0),
+    [TINY_NMEA_LAZY_LATITUDE] = AT(1),
+    [TINY_NMEA_LAZY_LONGITUDE] = AT(3),
+    [TINY_NMEA_LAZY_FIX_QUALITY] = AT(5),
+    [TINY_NMEA_LAZY_SATELLITES] = AT(6),
+    [TINY_NMEA_LAZY_HDOP] = AT(7),
+    [TINY_NMEA_LAZY_ALTITUDE] = AT(8),
+  },
+  [TINY_NMEA_SENTENCE_GNS] = {
+    [TINY_NMEA_LAZY_TIME] = AT(0),
+    [TINY_NMEA_LAZY_LATITUDE] = AT(1),
+    [TINY_NMEA_LAZY_LONGITUDE] = AT(3),
+    [TINY_NMEA_LAZY_SATELLITES] = AT(6),
+    [TINY_NMEA_LAZY_HDOP] = AT(7),
+    [TINY_NMEA_LAZY_ALTITUDE] = AT(8),
+  },
+  [TINY_NMEA_SENTENCE_GSA] = {
+    [TINY_NMEA_LAZY_HDOP] = AT(15),
+  },
+  [TINY_NMEA_SENTENCE_VTG] = {
+    [TINY_NMEA_LAZY_COURSE] = AT(0),
+    [TINY_NMEA_LAZY_SPEED_KNOTS] = AT(4),
+  },
+  [TINY_NMEA_SENTENCE_GLL] = {
+    [TINY_NMEA_LAZY_LATITUDE] = AT(0),
+    [TINY_NMEA_LAZY_LONGITUDE] = AT(2),
+    [TINY_NMEA_LAZY_TIME] = AT(4),
+    [TINY_NMEA_LAZY_STATUS] = AT(5),
+  },
+  [TINY_NMEA_SENTENCE_ZDA] = {
+    [TINY_NMEA_LAZY_TIME] = AT(0),
+    [TINY_NMEA_LAZY_DATE] = AT(1),  // day, month, year in separate fields
+  },
+  [TINY_NMEA_SENTENCE_GBS] = {
+    [TINY_NMEA_LAZY_TIME] = AT(0),
+  },
+  [TINY_NMEA_SENTENCE_GST] = {
+    [TINY_NMEA_LAZY_TIME] = AT(0),
+  },
+};
+
+#undef AT
+
+tiny_nmea_res_t tiny_nmea_lazy_parse(const char *sentence, size_t len, tiny_nmea_lazy_t *out) {
+  if (!sentence || !out) return TINY_NMEA_ERR_NULL_PTR;
+
+  // 1 byte start, 2 bytes talker id, 3 bytes sentence type, 1 byte comma
+  if (len < 7) return TINY_NMEA_MALFORMED_SENTENCE;
+
+  // if out does not have type, try to parse from the sentence
+  if (!tiny_nmea_talker_valid(out->talker) || !tiny_nmea_sentence_valid(out->type)) {
+    out->talker = parse_talker_id(sentence + 1);
+    out->type = parse_sentence_type(sentence + 3);
+
+    if (!tiny_nmea_talker_valid(out->talker) || !tiny_nmea_sentence_valid(out->type)) {
+      return TINY_NMEA_MALFORMED_SENTENCE;
+    }
+  }
+
+  out->sentence = sentence;
+  out->sentence_len = len;
+  out->century = 0;
+  out->decoded = 0;
+  out->valid = 0;
+
+  // same field count bounds as the eager handlers
+  // so both accept the same sentences
+  uint8_t max_fields = handle_max_fields(out->type);
+  if (max_fields > TINY_NMEA_LAZY_MAX_FIELDS) max_fields = TINY_NMEA_LAZY_MAX_FIELDS;
+  out->field_count = tokenize(sentence + 7, len - 7, out->fields, max_fields);
+
+  if (out->field_count < handle_min_fields(out->type)) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+
+  return TINY_NMEA_OK;
+}
+
+bool tiny_nmea_lazy_has(const tiny_nmea_lazy_t *l, tiny_nmea_lazy_field_t field) {
+  return tiny_nmea_sentence_valid(l->type) && field < TINY_NMEA_LAZY_FIELD_COUNT &&
+         lazy_field_index[l->type][field] != 0;
+}
+
+// zda carries the date as separate day, month and 4 digit year fields
+static bool decode_zda_date(const field_t *f, tiny_nmea_date_t *out) {
+  uint32_t day, month, year;
+  if (!parse_uint(&f[0], &day) || !parse_uint(&f[1], &month) || !parse_uint(&f[2], &year)) {
+    return false;
+  }
+  if (day < 1 || day > 31 || month < 1 || month > 12) return false;
+
+  out->day = (uint8_t)day;
+  out->month = (uint8_t)month;
+  out->year = (uint16_t)year;
+  out->year_yy = 0;
+  out->valid = true;
+  return true;
+}
+
+static bool decode_field(tiny_nmea_lazy_t *l, tiny_nmea_lazy_field_t field) {
+  if (!tiny_nmea_lazy_has(l, field)) return false;
+
+  const uint8_t idx = lazy_field_index[l->type][field] - 1;
+  if (idx >= l->field_count) return false;
+  const field_t *f = &l->fields[idx];
+
+  uint32_t tmp;
+  switch (field) {
+    case TINY_NMEA_LAZY_TIME:
+      return parse_time(f, &l->time);
+
+    case TINY_NMEA_LAZY_DATE:
+      if (l->type == TINY_NMEA_SENTENCE_ZDA) {
+        return idx + 2 < l->field_count && decode_zda_date(f, &l->date);
+      }
+      if (!parse_date(f, &l->date)) return false;
+      // compute correct full year from 2 digit year if century known
+      if (l->century > 0) {
+        l->date.year = (uint16_t)l->century * 100 + l->date.year_yy;
+      }
+      return true;
+
+    case TINY_NMEA_LAZY_STATUS:
+      l->status_valid = !field_empty(f) && f->ptr[0] == 'A';
+      return !field_empty(f);
+
+    case TINY_NMEA_LAZY_LATITUDE:
+      return idx + 1 < l->field_count && parse_latitude(f, f + 1, &l->latitude);
+
+    case TINY_NMEA_LAZY_LONGITUDE:
+      return idx + 1 < l->field_count && parse_longitude(f, f + 1, &l->longitude);
+
+    case TINY_NMEA_LAZY_SPEED_KNOTS:
+      return parse_fixedpoint_float(f, &l->speed_knots);
+
+    case TINY_NMEA_LAZY_COURSE:
+      return parse_fixedpoint_float(f, &l->course_deg);
+
+    case TINY_NMEA_LAZY_FIX_QUALITY:
+      if (!parse_uint(f, &tmp)) return false;
+      l->fix_quality = (tiny_nmea_fix_quality_t)tmp;
+      return true;
+
+    case TINY_NMEA_LAZY_SATELLITES:
+      if (!parse_uint(f, &tmp)) return false;
+      l->satellites_used = (uint8_t)tmp;
+      return true;
+
+    case TINY_NMEA_LAZY_HDOP:
+      return parse_fixedpoint_float(f, &l->hdop);
+
+    case TINY_NMEA_LAZY_ALTITUDE:
+      return parse_fixedpoint_float(f, &l->altitude_m);
+
+    default:
+      return false;
+  }
+}
+
+// decode once, then answer from the cached bitmasks
+static bool lazy_decode(tiny_nmea_lazy_t *l, tiny_nmea_lazy_field_t field) {
+  const uint16_t bit = (uint16_t)(1u << field);
+  if (!(l->decoded & bit)) {
+    l->decoded |= bit;
+    if (decode_field(l, field)) l->valid |= bit;
+  }
+  return (l->valid & bit) != 0;
+}
+
+#define DEFINE_LAZY_GETTER(name, FIELD, type, member) \
+  bool tiny_nmea_lazy_##name(tiny_nmea_lazy_t *l, type *out) { \
+    if (!l || !out || !lazy_decode(l, TINY_NMEA_LAZY_##FIELD)) return false; \
+    *out = l->member; \
+    return true; \
+  }
+
+DEFINE_LAZY_GETTER(time,        TIME,        tiny_nmea_time_t,        time)
+DEFINE_LAZY_GETTER(date,        DATE,        tiny_nmea_date_t,        date)
+DEFINE_LAZY_GETTER(status,      STATUS,      bool,                    status_valid)
+DEFINE_LAZY_GETTER(latitude,    LATITUDE,    tiny_nmea_coord_t,       latitude)
+DEFINE_LAZY_GETTER(longitude,   LONGITUDE,   tiny_nmea_coord_t,       longitude)
+DEFINE_LAZY_GETTER(speed_knots, SPEED_KNOTS, tiny_nmea_float_t,       speed_knots)
+DEFINE_LAZY_GETTER(course,      COURSE,      tiny_nmea_float_t,       course_deg)
+DEFINE_LAZY_GETTER(fix_quality, FIX_QUALITY, tiny_nmea_fix_quality_t, fix_quality)
+DEFINE_LAZY_GETTER(satellites,  SATELLITES,  uint8_t,                 satellites_used)
+DEFINE_LAZY_GETTER(hdop,        HDOP,        tiny_nmea_float_t,       hdop)
+DEFINE_LAZY_GETTER(altitude,    ALTITUDE,    tiny_nmea_float_t,       altitude_m)
+
+#undef DEFINE_LAZY_GETTER
+
+tiny_nmea_res_t tiny_nmea_lazy_decode_all(const tiny_nmea_lazy_t *l, tiny_nmea_type_t *out) {
+  if (!l || !out) return TINY_NMEA_ERR_NULL_PTR;
+
+  out->type = l->type;
+  out->talker = l->talker;
+  tiny_nmea_res_t res = tiny_nmea_parse_len(l->sentence, l->sentence_len, out);
+
+#if TINY_NMEA_ENABLE_RMC
+  if (res == TINY_NMEA_OK && out->type == TINY_NMEA_SENTENCE_RMC && l->century > 0) {
+    out->data.rmc.date.year = (uint16_t)l->century * 100 + out->data.rmc.date.year_yy;
+  }
+#endif
+  return res;
+}
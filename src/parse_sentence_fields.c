@@ -4,6 +4,7 @@
 
 #include "tiny_nmea/internal/parse_sentence_fields.h"
 #include "tiny_nmea/internal/data_formats.h"
+#include "tiny_nmea/internal/swar_digits.h"
 
 #include <string.h>
 #include <stdint.h>
@@ -31,6 +32,12 @@ bool parse_uint(const field_t* f, uint32_t* out) {
 
   const char* p = f->ptr;
   uint8_t len = f->len;
+
+  // every real numeric field fits the SWAR kernel,
+  // it checks the digits and the overflow on its own
+  if (len <= 16) return swar_parse_u32(p, len, out);
+
+  // long runs of leading zeros
   // check all are digits before parsing
   REQUIRE_DIGITS(p, len);
 
@@ -122,6 +129,15 @@ bool parse_fixedpoint_float(const field_t* f, tiny_nmea_float_t* out) {
 
   if (len == 0) return false;
 
+  // the whole field in one register, up to 7 digits can't overflow
+  uint32_t mantissa;
+  size_t frac_digits;
+  if (swar_parse_decimal(p, len, &mantissa, &frac_digits) == len) {
+    out->value = negative ? -(int32_t)mantissa : (int32_t)mantissa;
+    out->scale = tiny_nmea_pow10[frac_digits];
+    return true;
+  }
+
   // find decimal poin tnow
   const char* decimal_pt = memchr(p, '.', len);
   if (decimal_pt) {
@@ -149,21 +165,16 @@ bool parse_fixedpoint_float(const field_t* f, tiny_nmea_float_t* out) {
     if (!parse_uint(&tmp, &frac_val)) return false;
     have_digits = true;
 
-    // adjust scale from number of fractional digits
-    for (size_t i = 0; i < len; i++) {
-      scale *= 10;
-    }
+    // scale from number of fractional digits, beyond 10^9 it can't be an int32_t
+    if (len > TINY_NMEA_FP_EXP_MAX) return false;
+    scale = (uint32_t)tiny_nmea_pow10[len];
   }
 
   // reject "." or "+" or "-" with no actual digits
   if (!have_digits) return false;
 
-  // both parsed successfully
-  if (integer_val > (uint32_t)(INT32_MAX / scale)) {
-    return false; // would overflow
-  }
-
-  uint32_t combined = integer_val * scale + frac_val;
+  // both parsed successfully, a 64-bit combine replaces the INT32_MAX / scale check
+  uint64_t combined = (uint64_t)integer_val * scale + frac_val;
   if (combined > INT32_MAX) {
     return false; // would overflow
   }
@@ -216,46 +227,10 @@ bool parse_time(const field_t* f, tiny_nmea_time_t* out) {
 
   if (field_empty(f) || f->len < 6) return false;
 
-  const char* p = f->ptr;
-  // ensure at least 6 digits before we parse into
-  // hours, minutes and seconds
-  REQUIRE_DIGITS(p, 6);
-  out->hours = (p[0] - '0') * 10 + (p[1] - '0');
-  out->minutes = (p[2] - '0') * 10 + (p[3] - '0');
-  out->seconds = (p[4] - '0') * 10 + (p[5] - '0');
-
-  // validate that this is a real time value
-  if (out->hours > 23 || out->minutes > 59 || out->seconds > 60) {
-    return false; // seconds can be 60 for leap second
-  }
-
-  // parse fractional seconds
-  // the number of digits can vary depending on
-  // the precision provided by the receiver
-  // we simplify parsing by scaling everything to
-  // microseconds
-  if (f->len > 7 && p[6] == '.') {
-    uint32_t frac = 0;
-    uint8_t digits = 0;
-
-    for (uint8_t i = 7; i < f->len && digits < 6; i++) {
-      char c = p[i];
-      if (!IS_DIGIT(c)) break;
-      frac = frac * 10 + (c - '0');
-      digits++;
-    }
-
-    // scale to microseconds
-    while (digits < 6) {
-      frac *= 10;
-      digits++;
-    }
-
-    out->microseconds = frac;
-  }
-
-  out->valid = true;
-  return true;
+  // hhmmss digits, the range checks (seconds can be 60 for a leap second)
+  // and up to 6 fractional digits scaled to microseconds in one kernel
+  // the number of fractional digits varies with the receiver
+  return swar_decode_time(f->ptr, f->len, out) != 0;
 }
 
 // parse date expecting ddmmyy
@@ -268,27 +243,10 @@ bool parse_date(const field_t* f, tiny_nmea_date_t* out) {
 
   if (field_empty(f) || f->len < 6) return false;
 
-  const char* p = f->ptr;
-
-  // ensure at least 6 digits before we parse into
-  // the date fields
-  REQUIRE_DIGITS(p, 6);
-  out->day = (p[0] - '0') * 10 + (p[1] - '0');
-  out->month = (p[2] - '0') * 10 + (p[3] - '0');
-  out->year_yy = (p[4] - '0') * 10 + (p[5] - '0');
-
-  // check the date numbers make sense
-  if (out->day < 1 || out->day > 31 ||
-        out->month < 1 || out->month > 12) {
-    return false;
-        }
-
-  // the full year is left as zero unlees
-  // we know the century from the context and can
-  // update it with the actual year
-
-  out->valid = true;
-  return true;
+  // ddmmyy digits and the day / month range checks in one kernel
+  // the full year is left as zero unless we know the century
+  // from the context and can update it with the actual year
+  return swar_decode_date(f->ptr, f->len, out);
 }
 
 // parse latitude: ddmm.mmmm -> decimal degrees as fixed-point
@@ -341,3 +299,218 @@ bool parse_longitude(const field_t* f, const field_t* dir, tiny_nmea_coord_t* ou
 
   return true;
 }
+
+// single pass scanners
+
+void scan_skip(scan_cursor_t* c) {
+  const char* comma = memchr(c->pos, ',', c->end - c->pos);
+  c->pos = comma ? comma : c->end;
+}
+
+// accumulate digits up to the first non digit, false on overflow
+// the cursor stays on the first byte that was not consumed
+static inline bool scan_digits(scan_cursor_t* c, uint32_t* out, size_t* count) {
+  const char* p = c->pos;
+  uint32_t val = 0;
+
+  // 8 digits per step, a 9th and 10th digit can still fit a uint32_t
+  uint32_t chunk;
+  size_t n = swar_parse_span(p, (size_t)(c->end - p), &chunk);
+  if (n) {
+    val = chunk;
+    p += n;
+  }
+  while (n == 8) {
+    n = swar_parse_span(p, (size_t)(c->end - p), &chunk);
+    if (n == 0) break;
+
+    uint64_t next = (uint64_t)val * (uint32_t)tiny_nmea_pow10[n] + chunk;
+    if (next > UINT32_MAX) return false;
+    val = (uint32_t)next;
+    p += n;
+  }
+
+  *count = (size_t)(p - c->pos);
+  *out = val;
+  c->pos = p;
+  return true;
+}
+
+bool scan_uint(scan_cursor_t* c, uint32_t* out) {
+  if (scan_at_sep(c)) return false;
+
+  uint32_t val;
+  size_t digits;
+  // anything but digits up to the comma fails the field
+  if (!scan_digits(c, &val, &digits) || !scan_at_sep(c)) {
+    scan_skip(c);
+    return false;
+  }
+
+  *out = val;
+  return true;
+}
+
+bool scan_int(scan_cursor_t* c, int32_t* out) {
+  if (scan_at_sep(c)) return false;
+
+  bool negative = false;
+  if (*c->pos == '-') {
+    negative = true;
+    c->pos++;
+  } else if (*c->pos == '+') {
+    c->pos++;
+  }
+
+  uint32_t uval;
+  if (!scan_uint(c, &uval)) return false;
+
+  // check for signed overflow
+  if (negative) {
+    if (uval > (uint32_t)INT32_MAX + 1) return false;
+    *out = -(int32_t)uval;
+  } else {
+    if (uval > INT32_MAX) return false;
+    *out = (int32_t)uval;
+  }
+
+  return true;
+}
+
+bool scan_char(scan_cursor_t* c, char* out) {
+  if (scan_at_sep(c)) return false;
+  *out = *c->pos;
+  scan_skip(c);
+  return true;
+}
+
+bool scan_fixedpoint_float(scan_cursor_t* c, tiny_nmea_float_t* out) {
+  out->value = 0;
+  out->scale = 0;
+
+  if (scan_at_sep(c)) return false;
+
+  bool negative = false;
+  if (*c->pos == '-') {
+    negative = true;
+    c->pos++;
+  } else if (*c->pos == '+') {
+    c->pos++;
+  }
+
+  uint32_t integer_val = 0;
+  uint32_t frac_val = 0;
+  size_t int_digits = 0;
+  size_t frac_digits = 0;
+  uint32_t scale = 1;
+
+  // up to 7 digits in one register, can't overflow
+  size_t used = swar_parse_decimal(c->pos, (size_t)(c->end - c->pos), &frac_val, &frac_digits);
+  if (used) {
+    c->pos += used;
+    if (!scan_at_sep(c)) goto invalid;
+
+    out->value = negative ? -(int32_t)frac_val : (int32_t)frac_val;
+    out->scale = tiny_nmea_pow10[frac_digits];
+    return true;
+  }
+
+  if (!scan_digits(c, &integer_val, &int_digits)) goto invalid;
+
+  if (c->pos != c->end && *c->pos == '.') {
+    c->pos++;
+    if (!scan_digits(c, &frac_val, &frac_digits)) goto invalid;
+  } else {
+    // no decimal point, digits count as the fraction like parse_fixedpoint_float
+    frac_val = integer_val;
+    frac_digits = int_digits;
+    integer_val = 0;
+    int_digits = 0;
+  }
+
+  // a second '.' or any other byte before the comma
+  if (!scan_at_sep(c)) goto invalid;
+
+  // reject "." or "+" or "-" with no actual digits
+  if (int_digits == 0 && frac_digits == 0) return false;
+
+  if (frac_digits > TINY_NMEA_FP_EXP_MAX) return false;
+  scale = (uint32_t)tiny_nmea_pow10[frac_digits];
+
+  uint64_t combined = (uint64_t)integer_val * scale + frac_val;
+  if (combined > INT32_MAX) {
+    return false; // would overflow
+  }
+
+  out->value = negative ? -(int32_t)combined : (int32_t)combined;
+  out->scale = (int32_t)scale;
+  return true;
+
+invalid:
+  scan_skip(c);
+  return false;
+}
+
+bool scan_time(scan_cursor_t* c, tiny_nmea_time_t* out) {
+  out->valid = false;
+  out->hours = 0;
+  out->minutes = 0;
+  out->seconds = 0;
+  out->microseconds = 0;
+
+  // a comma inside the first 6 bytes fails the digit check
+  size_t used = swar_decode_time(c->pos, (size_t)(c->end - c->pos), out);
+  c->pos += used;
+
+  // trailing bytes are ignored like parse_time
+  scan_skip(c);
+  return used != 0;
+}
+
+bool scan_date(scan_cursor_t* c, tiny_nmea_date_t* out) {
+  out->valid = false;
+  out->day = 0;
+  out->month = 0;
+  out->year = 0;
+  out->year_yy = 0;
+
+  const char* p = c->pos;
+  scan_skip(c);
+
+  return swar_decode_date(p, (size_t)(c->end - p), out);
+}
+
+// first byte of the field after the one under the cursor, false if it is empty
+static inline bool scan_peek_next(const scan_cursor_t* c, char* out) {
+  if (c->end - c->pos < 2 || c->pos[1] == ',') return false;
+  *out = c->pos[1];
+  return true;
+}
+
+bool scan_latitude(scan_cursor_t* c, tiny_nmea_coord_t* out) {
+  out->raw.value = 0;
+  out->raw.scale = 0;
+  out->hemisphere = '\0';
+
+  if (!scan_fixedpoint_float(c, &out->raw)) return false;
+
+  char h;
+  if (!scan_peek_next(c, &h)) return true;
+  if (h != 'N' && h != 'S') return false; // Invalid hemisphere
+  out->hemisphere = h;
+  return true;
+}
+
+bool scan_longitude(scan_cursor_t* c, tiny_nmea_coord_t* out) {
+  out->raw.value = 0;
+  out->raw.scale = 0;
+  out->hemisphere = '\0';
+
+  if (!scan_fixedpoint_float(c, &out->raw)) return false;
+
+  char h;
+  if (!scan_peek_next(c, &h)) return true;
+  if (h != 'E' && h != 'W') return false; // Invalid hemisphere
+  out->hemisphere = h;
+  return true;
+}
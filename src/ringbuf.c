@@ -7,32 +7,138 @@
 #include <stdatomic.h>
 #include <string.h>
 
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+// with multiple producers head and reserve carry a reservation tag in the
+// upper half of the word and the buffer index in the lower half
+#define RINGBUF_TAG_SHIFT       (sizeof(size_t) * 4)
+#define RINGBUF_POS_MASK        (((size_t)1 << RINGBUF_TAG_SHIFT) - 1)
+#define RINGBUF_POS(x)          ((x) & RINGBUF_POS_MASK)
+#define RINGBUF_TAG(x)          ((x) >> RINGBUF_TAG_SHIFT)
+#define RINGBUF_PACK(tag, pos)  (((size_t)(tag) << RINGBUF_TAG_SHIFT) | (pos))
+#define RINGBUF_SLOT(tag)       ((tag) & (TINY_NMEA_RINGBUF_COMMIT_SLOTS - 1))
+#define RINGBUF_IDX_MASK        RINGBUF_POS_MASK
+#else
+#define RINGBUF_POS(x)          (x)
+#define RINGBUF_IDX_MASK        SIZE_MAX
+#endif
+
 // macro to atomically load pointers
 // and make the vars available in scope
 
 // for observer functions that need a consistent snapshot
 #define RINGBUF_LOAD(rb, head_order, tail_order) \
-size_t head = atomic_load_explicit(&(rb)->head, head_order); \
+size_t head = RINGBUF_POS(atomic_load_explicit(&(rb)->head, head_order)); \
 size_t tail = atomic_load_explicit(&(rb)->tail, tail_order)
 
-#define RINGBUF_LOAD_PRODUCER(rb) RINGBUF_LOAD(rb, memory_order_relaxed, memory_order_acquire)
 #define RINGBUF_LOAD_CONSUMER(rb) RINGBUF_LOAD(rb, memory_order_acquire, memory_order_relaxed)
 #define RINGBUF_LOAD_OBSERVER(rb) RINGBUF_LOAD(rb, memory_order_acquire, memory_order_acquire)
 
+#if TINY_NMEA_RINGBUF_POW2
+
+// free running indices, the distance is the length even across the
+// index wrap, so head == tail is empty and every slot can be used
+#define RINGBUF_COMPUTE_LENGTH(hd, tl) \
+  (((hd) - (tl)) & RINGBUF_IDX_MASK)
+
+#define RINGBUF_CAPACITY(rb) ((rb)->size)
+
+#else
+
 // implements the simple length logic to reduce repeated blocks
 #define RINGBUF_COMPUTE_LENGTH(hd, tl) \
   (((hd) >= (tl)) ? (hd) - (tl) : rb->size - (tl) + (hd))
 
+// one slot kept empty to distinguish full from empty
+#define RINGBUF_CAPACITY(rb) ((rb)->size - 1)
+
+#endif
+
 // implements get free space logic to reduce repeats
 #define RINGBUF_COMPUTE_FREE_SPACE(hd, tl) \
-  (rb->size - RINGBUF_COMPUTE_LENGTH(hd, tl) - 1)
+  (RINGBUF_CAPACITY(rb) - RINGBUF_COMPUTE_LENGTH(hd, tl))
+
+// advance an index by less than size
+// a compare instead of a divide, indices never run a full lap ahead
+static inline size_t ringbuf_wrap(const ringbuf_t *rb, size_t idx) {
+#if TINY_NMEA_RINGBUF_POW2
+  (void)rb;
+  return idx & RINGBUF_IDX_MASK;
+#else
+  return idx >= rb->size ? idx - rb->size : idx;
+#endif
+}
 
+// storage offset of an index
+static inline size_t ringbuf_offset(const ringbuf_t *rb, size_t idx) {
+#if TINY_NMEA_RINGBUF_POW2
+  return idx & rb->mask;
+#else
+  (void)rb;
+  return idx;
+#endif
+}
 
-void ringbuf_init(ringbuf_t *rb, uint8_t *buf, size_t size) {
+// tail as seen by the producer, enough to tell whether want bytes fit
+// the power of two ring only goes to the consumer's line when its
+// cached copy is too old, a stale tail just underestimates the space
+static inline size_t producer_tail(ringbuf_t *rb, size_t head, size_t want) {
+#if TINY_NMEA_RINGBUF_POW2
+  size_t tail = rb->tail_cache;
+  if (RINGBUF_COMPUTE_FREE_SPACE(head, tail) < want) {
+    tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+    rb->tail_cache = tail;
+  }
+  return tail;
+#else
+  (void)head;
+  (void)want;
+  return atomic_load_explicit(&rb->tail, memory_order_acquire);
+#endif
+}
+
+// head as seen by the consumer, same idea as producer_tail()
+static inline size_t consumer_head(ringbuf_t *rb, size_t tail, size_t want) {
+#if TINY_NMEA_RINGBUF_POW2
+  size_t head = rb->head_cache;
+  if (RINGBUF_COMPUTE_LENGTH(head, tail) < want) {
+    head = RINGBUF_POS(atomic_load_explicit(&rb->head, memory_order_acquire));
+    rb->head_cache = head;
+  }
+  return head;
+#else
+  (void)tail;
+  (void)want;
+  return RINGBUF_POS(atomic_load_explicit(&rb->head, memory_order_acquire));
+#endif
+}
+
+
+bool ringbuf_init(ringbuf_t *rb, uint8_t *buf, size_t size) {
+  // with multiple producers indices only get the lower half of the word
+  if (size > RINGBUF_MAX_SIZE) {
+    return false;
+  }
+#if TINY_NMEA_RINGBUF_POW2
+  // round down to a power of two by clearing all but the top bit
+  while (size & (size - 1)) {
+    size &= size - 1;
+  }
+  rb->mask = size - 1;
+  rb->tail_cache = 0;
+  rb->head_cache = 0;
+#endif
   rb->buf = buf;
   rb->size = size;
   atomic_init(&rb->head, 0);
   atomic_init(&rb->tail, 0);
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  atomic_init(&rb->reserve, 0);
+  // every marker starts out as a long published reservation
+  for (size_t i = 0; i < TINY_NMEA_RINGBUF_COMMIT_SLOTS; i++) {
+    atomic_init(&rb->commit[i], RINGBUF_PACK(i - TINY_NMEA_RINGBUF_COMMIT_SLOTS, 0));
+  }
+#endif
+  return true;
 }
 
 void ringbuf_clear(ringbuf_t *rb) {
@@ -40,7 +146,18 @@ void ringbuf_clear(ringbuf_t *rb) {
   // this is NOT thread-safe and should only be called
   // when you can guarantee no concurrent access
   const size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  // keep the tag, nothing is in flight so reserve catches up with head
+  const size_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+  atomic_store_explicit(&rb->head, RINGBUF_PACK(RINGBUF_TAG(head), tail), memory_order_relaxed);
+  atomic_store_explicit(&rb->reserve, RINGBUF_PACK(RINGBUF_TAG(head), tail), memory_order_relaxed);
+#else
   atomic_store_explicit(&rb->head, tail, memory_order_relaxed);
+#endif
+#if TINY_NMEA_RINGBUF_POW2
+  rb->tail_cache = tail;
+  rb->head_cache = tail;
+#endif
 }
 
 size_t ringbuf_len(const ringbuf_t *rb) {
@@ -51,7 +168,6 @@ size_t ringbuf_len(const ringbuf_t *rb) {
 
 
 size_t ringbuf_free(const ringbuf_t *rb) {
-  // one slot kept empty to distinguish full from empty
   RINGBUF_LOAD_OBSERVER(rb);
   return RINGBUF_COMPUTE_FREE_SPACE(head, tail);
 }
@@ -63,16 +179,112 @@ bool ringbuf_empty(const ringbuf_t *rb) {
 }
 
 bool ringbuf_full(const ringbuf_t *rb) {
-  // consider ringbuf full if the head pointer will equal
-  // the tail pointer if we advance by one (size-1 items)
-  // because we cannot distinguish head == tail due to empty
-  // or full otherwise
+  // without free running indices the ringbuf is full one slot early,
+  // since head == tail could not tell empty from full otherwise
   RINGBUF_LOAD_OBSERVER(rb);
-  return ((head + 1) % rb->size) == tail;
+  return RINGBUF_COMPUTE_FREE_SPACE(head, tail) == 0;
+}
+
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+
+// advance head over every committed reservation in a row
+// whoever commits last in a run publishes the whole run, so a stalled
+// producer only holds back the bytes behind its own reservation
+static void publish_commits(ringbuf_t *rb) {
+  // seq_cst pairs the marker store in push_multi() with this head load
+  // and the head update with the marker load, so a committing producer
+  // either sees its reservation get published or publishes it itself
+  size_t head = atomic_load_explicit(&rb->head, memory_order_seq_cst);
+  for (;;) {
+    const size_t tag = RINGBUF_TAG(head);
+    const size_t mark = atomic_load_explicit(&rb->commit[RINGBUF_SLOT(tag)], memory_order_seq_cst);
+    if (RINGBUF_TAG(mark) != tag) {
+      // still being copied, its producer takes over from here
+      return;
+    }
+
+    const size_t next = RINGBUF_PACK(tag + 1, RINGBUF_POS(mark));
+    if (atomic_compare_exchange_strong_explicit(&rb->head, &head, next,
+                                                memory_order_seq_cst, memory_order_seq_cst)) {
+      head = next;
+    }
+  }
+}
+
+static size_t push_multi(ringbuf_t *rb, const uint8_t *data, size_t len, ringbuf_push_mode_t mode) {
+  if (mode == RINGBUF_PUSH_WRAP) {
+    // exclusive access only, so nothing is in flight and the
+    // oldest bytes can be dropped before an all or nothing push
+    if (len > RINGBUF_CAPACITY(rb)) {
+      data += len - RINGBUF_CAPACITY(rb);
+      len = RINGBUF_CAPACITY(rb);
+    }
+    const size_t free_space = ringbuf_free(rb);
+    if (len > free_space) {
+      ringbuf_discard(rb, len - free_space);
+    }
+    mode = RINGBUF_PUSH_ATOMIC;
+  }
+
+  // claim [pos, end) and the next tag with a CAS on the reservation index
+  size_t reserve, pos, tag, end;
+  for (;;) {
+    // head first, acquire makes every reservation it covers visible
+    // so its tag can never pass the tag of the reserve load after it
+    const size_t published = RINGBUF_TAG(atomic_load_explicit(&rb->head, memory_order_acquire));
+    reserve = atomic_load_explicit(&rb->reserve, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+    pos = RINGBUF_POS(reserve);
+    tag = RINGBUF_TAG(reserve);
+
+    // out of commit markers, too many reservations behind a stalled producer
+    if (((tag - published) & RINGBUF_POS_MASK) >= TINY_NMEA_RINGBUF_COMMIT_SLOTS) {
+      return 0;
+    }
+
+    const size_t free_space = RINGBUF_COMPUTE_FREE_SPACE(pos, tail);
+    if (len > free_space) {
+      if (mode == RINGBUF_PUSH_ATOMIC) {
+        return 0;
+      }
+      len = free_space;
+    }
+    if (len == 0) {
+      return 0;
+    }
+
+    end = ringbuf_wrap(rb, pos + len);
+    if (atomic_compare_exchange_weak_explicit(&rb->reserve, &reserve, RINGBUF_PACK(tag + 1, end),
+                                              memory_order_relaxed, memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  // the range is ours alone, copy in one or two chunks
+  const size_t start = ringbuf_offset(rb, pos);
+  size_t to_end = rb->size - start;
+  if (to_end >= len) {
+    memcpy(rb->buf + start, data, len);
+  } else {
+    memcpy(rb->buf + start, data, to_end);
+    memcpy(rb->buf, data + to_end, len - to_end);
+  }
+
+  // mark the reservation committed, then publish it along with any
+  // committed reservations after it if everything before is done
+  atomic_store_explicit(&rb->commit[RINGBUF_SLOT(tag)], RINGBUF_PACK(tag, end), memory_order_seq_cst);
+  publish_commits(rb);
+  return len;
 }
 
+#endif // TINY_NMEA_ENABLE_MULTI_PRODUCER
+
 size_t ringbuf_push(ringbuf_t *rb, const uint8_t *data, size_t len, ringbuf_push_mode_t mode) {
-  RINGBUF_LOAD_PRODUCER(rb);
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  return push_multi(rb, data, len, mode);
+#else
+  const size_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+  size_t tail = producer_tail(rb, head, len);
   const size_t free_space = RINGBUF_COMPUTE_FREE_SPACE(head, tail);
 
   if (len > free_space) {
@@ -89,24 +301,18 @@ size_t ringbuf_push(ringbuf_t *rb, const uint8_t *data, size_t len, ringbuf_push
         // this modifies tail pointer, no lock-free guarantee
         // use with exclusive access
 
-        if (len >= rb->size) {
+        if (len > RINGBUF_CAPACITY(rb)) {
           // incoming data larger than buffer
-          // keep only the last (size-1) bytes
-          data += len - (rb->size - 1);
-          len = rb->size - 1;
-          // reset buffer to empty state
-          atomic_store_explicit(&rb->tail, 0, memory_order_relaxed);
-          atomic_store_explicit(&rb->head, 0, memory_order_relaxed);
-          // update local variables to match
-          head = 0;
-          tail = 0;
-        } else {
-          // advance tail to make room for new data
-          // discard old data from the buffer
-          ringbuf_discard(rb, len - free_space);
-          // tail has changed, reload it
-          tail = atomic_load_explicit(&rb->tail, memory_order_acquire);
+          // keep only the last capacity bytes
+          data += len - RINGBUF_CAPACITY(rb);
+          len = RINGBUF_CAPACITY(rb);
         }
+
+        // advance tail to make room for new data
+        // discard old data from the buffer
+        ringbuf_discard(rb, len - free_space);
+        // tail has changed, reload it
+        tail = producer_tail(rb, head, len);
         break;
     }
   }
@@ -116,22 +322,67 @@ size_t ringbuf_push(ringbuf_t *rb, const uint8_t *data, size_t len, ringbuf_push
   }
 
   // copy in one or two chunks to handle wraparound
-  size_t to_end = rb->size - head;
+  const size_t start = ringbuf_offset(rb, head);
+  size_t to_end = rb->size - start;
   if (to_end >= len) {
-    memcpy(rb->buf + head, data, len);
+    memcpy(rb->buf + start, data, len);
   } else {
-    memcpy(rb->buf + head, data, to_end);
+    memcpy(rb->buf + start, data, to_end);
     memcpy(rb->buf, data + to_end, len - to_end);
   }
 
   // publish the new data with release semantics
   // this ensures all data writes are visible before head update
-  atomic_store_explicit(&rb->head, (head + len) % rb->size, memory_order_release);
+  atomic_store_explicit(&rb->head, ringbuf_wrap(rb, head + len), memory_order_release);
   return len;
+#endif
+}
+
+size_t ringbuf_reserve(ringbuf_t *rb, ringbuf_span_t *span1, ringbuf_span_t *span2) {
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  // an unclaimed region can not be shared between producers
+  span1->ptr = span2->ptr = rb->buf;
+  span1->len = span2->len = 0;
+  return 0;
+#else
+  // hand out all the space there is, so always look at the real tail
+  const size_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+  const size_t tail = producer_tail(rb, head, SIZE_MAX);
+  const size_t free_space = RINGBUF_COMPUTE_FREE_SPACE(head, tail);
+
+  // the free region starts at head and may wrap to the start of the storage
+  const size_t start = ringbuf_offset(rb, head);
+  const size_t to_end = rb->size - start;
+  span1->ptr = rb->buf + start;
+  span1->len = free_space < to_end ? free_space : to_end;
+  span2->ptr = rb->buf;
+  span2->len = free_space - span1->len;
+  return free_space;
+#endif
+}
+
+size_t ringbuf_commit(ringbuf_t *rb, size_t len) {
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  (void)rb;
+  (void)len;
+  return 0;
+#else
+  const size_t head = atomic_load_explicit(&rb->head, memory_order_relaxed);
+  const size_t tail = producer_tail(rb, head, len);
+  const size_t free_space = RINGBUF_COMPUTE_FREE_SPACE(head, tail);
+  if (len > free_space) {
+    len = free_space;
+  }
+
+  // publish the bytes written in place, same as the end of ringbuf_push()
+  atomic_store_explicit(&rb->head, ringbuf_wrap(rb, head + len), memory_order_release);
+  return len;
+#endif
 }
 
 size_t ringbuf_pop(ringbuf_t *rb, uint8_t *data, size_t len) {
-  RINGBUF_LOAD_CONSUMER(rb);
+  const size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+  const size_t head = consumer_head(rb, tail, len);
   const size_t avail = RINGBUF_COMPUTE_LENGTH(head, tail);
   if (len > avail) {
     len = avail;
@@ -141,24 +392,39 @@ size_t ringbuf_pop(ringbuf_t *rb, uint8_t *data, size_t len) {
     return 0;
   }
 
-  size_t to_end = rb->size - tail;
+  const size_t start = ringbuf_offset(rb, tail);
+  size_t to_end = rb->size - start;
 
   if (data != NULL) {
     // check the user actually supplied a buffer
     if (to_end >= len) {
-      memcpy(data, rb->buf + tail, len);
+      memcpy(data, rb->buf + start, len);
     } else {
-      memcpy(data, rb->buf + tail, to_end);
+      memcpy(data, rb->buf + start, to_end);
       memcpy(data + to_end, rb->buf, len - to_end);
     }
   }
 
   // publish the freed space with release semantics
   // this ensures all data reads are complete before tail update
-  atomic_store_explicit(&rb->tail, (tail + len) % rb->size, memory_order_release);
+  atomic_store_explicit(&rb->tail, ringbuf_wrap(rb, tail + len), memory_order_release);
   return len;
 }
 
+size_t ringbuf_peek_spans(const ringbuf_t *rb, ringbuf_span_t *span1, ringbuf_span_t *span2) {
+  RINGBUF_LOAD_CONSUMER(rb);
+  const size_t avail = RINGBUF_COMPUTE_LENGTH(head, tail);
+
+  // the readable region starts at tail and may wrap to the start of the storage
+  const size_t start = ringbuf_offset(rb, tail);
+  const size_t to_end = rb->size - start;
+  span1->ptr = rb->buf + start;
+  span1->len = avail < to_end ? avail : to_end;
+  span2->ptr = rb->buf;
+  span2->len = avail - span1->len;
+  return avail;
+}
+
 size_t ringbuf_peek(const ringbuf_t *rb, uint8_t *data, size_t len, size_t offset) {
   RINGBUF_LOAD_OBSERVER(rb);
   const size_t avail = RINGBUF_COMPUTE_LENGTH(head, tail);
@@ -171,7 +437,7 @@ size_t ringbuf_peek(const ringbuf_t *rb, uint8_t *data, size_t len, size_t offse
     len = avail - offset;
   }
 
-  size_t start = (tail + offset) % rb->size;
+  size_t start = ringbuf_offset(rb, ringbuf_wrap(rb, tail + offset));
   size_t to_end = rb->size - start;
   if (to_end >= len) {
     memcpy(data, rb->buf + start, len);
@@ -190,18 +456,19 @@ bool ringbuf_peek_byte(const ringbuf_t *rb, size_t offset, uint8_t *out) {
     return false;
   }
 
-  *out = rb->buf[(tail + offset) % rb->size];
+  *out = rb->buf[ringbuf_offset(rb, ringbuf_wrap(rb, tail + offset))];
   return true;
 }
 
 size_t ringbuf_discard(ringbuf_t *rb, size_t len) {
-  RINGBUF_LOAD_CONSUMER(rb);
+  const size_t tail = atomic_load_explicit(&rb->tail, memory_order_relaxed);
+  const size_t head = consumer_head(rb, tail, len);
   const size_t avail = RINGBUF_COMPUTE_LENGTH(head, tail);
   if (len > avail) {
     len = avail;
   }
 
   // publish the freed space with release semantics
-  atomic_store_explicit(&rb->tail, (tail + len) % rb->size, memory_order_release);
+  atomic_store_explicit(&rb->tail, ringbuf_wrap(rb, tail + len), memory_order_release);
   return len;
 }
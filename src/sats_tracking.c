@@ -53,37 +53,55 @@ tiny_nmea_res_t tiny_nmea_sat_tracking_update_sentence(tiny_nmea_sats_tracker_ct
     // full UTC time + date available
     // RMC sentences will only have valid year after
     // at least one valid ZDA sentence has been parsed
+#if TINY_NMEA_ENABLE_RMC
     case TINY_NMEA_SENTENCE_RMC:
       ret = tiny_nmea_sat_tracking_update_datetime(ctx, &parse_res.data.rmc.date, &parse_res.data.rmc.time);
       break;
+#endif
+#if TINY_NMEA_ENABLE_ZDA
     case TINY_NMEA_SENTENCE_ZDA:
       ret = tiny_nmea_sat_tracking_update_datetime(ctx, &parse_res.data.zda.date, &parse_res.data.zda.time);
       break;
+#endif
 
     // only UTC time available
+#if TINY_NMEA_ENABLE_GGA
     case TINY_NMEA_SENTENCE_GGA:
       ret = tiny_nmea_sat_tracking_update_time(ctx, &parse_res.data.gga.time);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GLL
     case TINY_NMEA_SENTENCE_GLL:
       ret = tiny_nmea_sat_tracking_update_time(ctx, &parse_res.data.gll.time);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GBS
     case TINY_NMEA_SENTENCE_GBS:
       ret = tiny_nmea_sat_tracking_update_time(ctx, &parse_res.data.gbs.time);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GST
     case TINY_NMEA_SENTENCE_GST:
       ret = tiny_nmea_sat_tracking_update_time(ctx, &parse_res.data.gst.time);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GNS
     case TINY_NMEA_SENTENCE_GNS:
       ret = tiny_nmea_sat_tracking_update_time(ctx, &parse_res.data.gns.time);
       break;
+#endif
 
     // sat tracking handlers
+#if TINY_NMEA_ENABLE_GSV
     case TINY_NMEA_SENTENCE_GSV:
       ret = tiny_nmea_sat_tracking_update_gsv(ctx, &parse_res.data.gsv);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GSA
     case TINY_NMEA_SENTENCE_GSA:
       ret = tiny_nmea_sat_tracking_update_gsa(ctx, &parse_res.data.gsa, parse_res.talker);
       break;
+#endif
 
     // other sentences are ignored
     default:
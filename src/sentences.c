@@ -4,30 +4,157 @@
 
 #include "tiny_nmea/internal/sentences.h"
 #include "tiny_nmea/internal/parse_sentence_fields.h"
+#include "tiny_nmea/internal/sentence_schema.h"
+#include "tiny_nmea/internal/nmea_0183_schema.h"
 
 #include <string.h>
 
-// helper to parse status character to bool ('A' = valid)
-static inline bool parse_status_valid(const field_t *f) {
-  return !field_empty(f) && f->ptr[0] == 'A';
+// decode the field under the cursor into the member at dst, false if empty or invalid
+// leaves the cursor on the comma ending the field
+static bool scan_schema_field(uint8_t kind, scan_cursor_t *c, void *dst) {
+  uint32_t tmp;
+  int32_t stmp;
+  char ch;
+
+  switch (kind) {
+    case TINY_NMEA_KIND_TIME:
+      return scan_time(c, dst);
+    case TINY_NMEA_KIND_DATE:
+      return scan_date(c, dst);
+    case TINY_NMEA_KIND_LATITUDE:
+      return scan_latitude(c, dst);
+    case TINY_NMEA_KIND_LONGITUDE:
+      return scan_longitude(c, dst);
+    case TINY_NMEA_KIND_FLOAT:
+      return scan_fixedpoint_float(c, dst);
+    case TINY_NMEA_KIND_CHAR:
+      return scan_char(c, dst);
+    case TINY_NMEA_KIND_STATUS:
+      if (!scan_char(c, &ch)) return false;
+      *(bool *)dst = ch == 'A';
+      return true;
+    case TINY_NMEA_KIND_U8:
+      if (!scan_uint(c, &tmp)) return false;
+      *(uint8_t *)dst = (uint8_t)tmp;
+      return true;
+    case TINY_NMEA_KIND_U16:
+      if (!scan_uint(c, &tmp)) return false;
+      *(uint16_t *)dst = (uint16_t)tmp;
+      return true;
+    case TINY_NMEA_KIND_I8:
+      if (!scan_int(c, &stmp)) return false;
+      *(int8_t *)dst = (int8_t)stmp;
+      return true;
+    case TINY_NMEA_KIND_PRN:
+      if (!scan_uint(c, &tmp)) return false;
+      *(TINY_NMEA_PRN_TYPE *)dst = (TINY_NMEA_PRN_TYPE)tmp;
+      return true;
+    case TINY_NMEA_KIND_FAA_MODE:
+      if (!scan_char(c, &ch)) {
+        *(tiny_nmea_faa_mode_t *)dst = TINY_NMEA_FAA_UNKNOWN;
+        return false;
+      }
+      *(tiny_nmea_faa_mode_t *)dst = parse_faa_mode(ch);
+      return true;
+    case TINY_NMEA_KIND_NAV_STATUS:
+      if (!scan_char(c, &ch)) {
+        *(tiny_nmea_nav_status_t *)dst = TINY_NMEA_NAV_STATUS_UNKNOWN;
+        return false;
+      }
+      *(tiny_nmea_nav_status_t *)dst = parse_nav_status(ch);
+      return true;
+    case TINY_NMEA_KIND_GSA_FIX:
+      if (!scan_char(c, &ch)) {
+        *(tiny_nmea_gsa_fix_t *)dst = TINY_NMEA_GSA_FIX_UNKNOWN;
+        return false;
+      }
+      *(tiny_nmea_gsa_fix_t *)dst = parse_gsa_fix(ch);
+      return true;
+    default:
+      scan_skip(c);
+      return false;
+  }
 }
 
-// helper to parse faa mode character to enum
-static inline tiny_nmea_faa_mode_t parse_faa_mode_field(const field_t *f) {
-  if (field_empty(f)) return TINY_NMEA_FAA_UNKNOWN;
-  return parse_faa_mode(f->ptr[0]);
+static tiny_nmea_res_t schema_field_error(uint8_t kind) {
+  switch (kind) {
+    case TINY_NMEA_KIND_TIME: return TINY_NMEA_ERR_INVALID_TIME;
+    case TINY_NMEA_KIND_DATE: return TINY_NMEA_ERR_INVALID_DATE;
+    case TINY_NMEA_KIND_LATITUDE:
+    case TINY_NMEA_KIND_LONGITUDE: return TINY_NMEA_ERR_INVALID_COORD;
+    default: return TINY_NMEA_ERR_INVALID_NUMBER;
+  }
 }
 
-// helper to parse nav status character to enum
-static inline tiny_nmea_nav_status_t parse_nav_status_field(const field_t *f) {
-  if (field_empty(f)) return TINY_NMEA_NAV_STATUS_UNKNOWN;
-  return parse_nav_status(f->ptr[0]);
+// generic schema driven decoder
+// one left to right pass: fields in the table are decoded while their
+// comma is searched for, the rest are skipped with memchr. field spans are
+// still recorded for the finish hook. entries must be in ascending index order
+// static inline so each handler below gets a copy specialized on its const table
+static inline tiny_nmea_res_t schema_decode(const tiny_nmea_sentence_schema_t *schema,
+                                            const char *sentence, size_t len, void *data) {
+  field_t f[TINY_NMEA_SCHEMA_MAX_FIELDS];
+  scan_cursor_t c = { .pos = sentence, .end = sentence + len };
+  const tiny_nmea_field_schema_t *e = schema->entries;
+  const tiny_nmea_field_schema_t *e_end = e + schema->entry_count;
+  tiny_nmea_res_t res = TINY_NMEA_OK;
+  uint8_t count = 0;
+
+  memset(data, 0, schema->size);
+
+  // no fields at all for empty data, same as tokenize()
+  while (len > 0 && count < schema->max_fields) {
+    f[count].ptr = c.pos;
+
+    // after a required field failed the rest is only counted
+    if (e != e_end && e->index == count && res == TINY_NMEA_OK) {
+      if (!scan_schema_field(e->kind, &c, (uint8_t *)data + e->offset) &&
+          e->flags == TINY_NMEA_FIELD_REQUIRED) {
+        res = schema_field_error(e->kind);
+      }
+      e++;
+    } else {
+      scan_skip(&c);
+    }
+
+    f[count].len = (uint8_t)(c.pos - f[count].ptr);
+    count++;
+
+    if (c.pos == c.end) break;
+    c.pos++;  // step over the comma
+  }
+
+  // field count is checked first so errors match the old tokenize then decode order
+  if (count < schema->min_fields) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
+  if (res != TINY_NMEA_OK) return res;
+
+  return schema->finish ? schema->finish(f, count, data) : TINY_NMEA_OK;
 }
 
-// helper to parse gsa fix type character to enum
-static inline tiny_nmea_gsa_fix_t parse_gsa_fix_field(const field_t *f) {
-  if (field_empty(f)) return TINY_NMEA_GSA_FIX_UNKNOWN;
-  return parse_gsa_fix(f->ptr[0]);
+// the single pass decoder relies on the table being sorted, and a coordinate
+// peeks at its hemisphere field so that one has to exist too
+static bool schema_valid(const tiny_nmea_sentence_schema_t *schema) {
+  if (schema->max_fields > TINY_NMEA_SCHEMA_MAX_FIELDS) return false;
+
+  for (uint8_t i = 0; i < schema->entry_count; i++) {
+    const tiny_nmea_field_schema_t *e = &schema->entries[i];
+
+    if (i > 0 && e->index <= schema->entries[i - 1].index) return false;
+    if ((e->kind == TINY_NMEA_KIND_LATITUDE || e->kind == TINY_NMEA_KIND_LONGITUDE) &&
+        e->index + 1 >= schema->max_fields) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+tiny_nmea_res_t handle_parse_schema(const tiny_nmea_sentence_schema_t *schema,
+                                    const char *sentence, size_t len, void *data) {
+  if (!schema || !sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
+  if (!schema_valid(schema)) return TINY_NMEA_INVALID_ARGS;
+
+  return schema_decode(schema, sentence, len, data);
 }
 
 // rmc - recommended minimum navigation information
@@ -52,55 +179,16 @@ static inline tiny_nmea_gsa_fix_t parse_gsa_fix_field(const field_t *f) {
 #define RMC_MIN_FIELDS 11
 #define RMC_MAX_FIELDS 13
 
+#if TINY_NMEA_ENABLE_RMC
+TINY_NMEA_DEFINE_SCHEMA(rmc_schema, tiny_nmea_rmc_t, TINY_NMEA_RMC_SCHEMA,
+                        RMC_MIN_FIELDS, RMC_MAX_FIELDS, NULL);
+
 tiny_nmea_res_t handle_parse_rmc(const char *sentence, size_t len, tiny_nmea_rmc_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  field_t f[RMC_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, RMC_MAX_FIELDS);
-
-  if (count < RMC_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: time (may be empty)
-  parse_time(&f[0], &data->time);
-
-  // field 1: status
-  data->status_valid = parse_status_valid(&f[1]);
-
-  // fields 2-3: latitude (may be empty if no fix)
-  parse_latitude(&f[2], &f[3], &data->latitude);
-
-  // fields 4-5: longitude (may be empty if no fix)
-  parse_longitude(&f[4], &f[5], &data->longitude);
-
-  // field 6: speed over ground
-  parse_fixedpoint_float(&f[6], &data->speed_knots);
-
-  // field 7: course over ground
-  parse_fixedpoint_float(&f[7], &data->course_deg);
-
-  // field 8: date (may be empty)
-  parse_date(&f[8], &data->date);
-
-  // field 9: magnetic variation (optional)
-  parse_fixedpoint_float(&f[9], &data->mag_variation);
-
-  // field 10: magnetic variation direction (optional)
-  parse_char(&f[10], &data->mag_var_dir);
-
-  // field 11: faa mode indicator (nmea 2.3+, optional)
-  if (count > 11) {
-    data->faa_mode = parse_faa_mode_field(&f[11]);
-  }
-
-  // field 12: navigation status (nmea 4.1+, optional)
-  if (count > 12) {
-    data->nav_status = parse_nav_status_field(&f[12]);
-  }
-
-  return TINY_NMEA_OK;
+  return schema_decode(&rmc_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_RMC
 
 // gga - global positioning system fix data
 // format: $xxGGA,time,lat,ns,lon,ew,qual,numsv,hdop,alt,M,sep,M,age,stnid*cs
@@ -125,55 +213,16 @@ tiny_nmea_res_t handle_parse_rmc(const char *sentence, size_t len, tiny_nmea_rmc
 #define GGA_MIN_FIELDS 14
 #define GGA_MAX_FIELDS 15
 
+#if TINY_NMEA_ENABLE_GGA
+TINY_NMEA_DEFINE_SCHEMA(gga_schema, tiny_nmea_gga_t, TINY_NMEA_GGA_SCHEMA,
+                        GGA_MIN_FIELDS, GGA_MAX_FIELDS, NULL);
+
 tiny_nmea_res_t handle_parse_gga(const char *sentence, size_t len, tiny_nmea_gga_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  field_t f[GGA_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, GGA_MAX_FIELDS);
-
-  if (count < GGA_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: time
-  parse_time(&f[0], &data->time);
-
-  // fields 1-2: latitude
-  parse_latitude(&f[1], &f[2], &data->latitude);
-
-  // fields 3-4: longitude
-  parse_longitude(&f[3], &f[4], &data->longitude);
-
-  // field 5: fix quality
-  uint32_t tmp;
-  if (parse_uint(&f[5], &tmp)) {
-    data->fix_quality = (tiny_nmea_fix_quality_t)tmp;
-  }
-
-  // field 6: number of satellites used
-  if (parse_uint(&f[6], &tmp)) {
-    data->satellites_used = (uint8_t)tmp;
-  }
-
-  // field 7: hdop
-  parse_fixedpoint_float(&f[7], &data->hdop);
-
-  // field 8: altitude (field 9 is units, always 'M')
-  parse_fixedpoint_float(&f[8], &data->altitude_m);
-
-  // field 10: geoidal separation (field 11 is units, always 'M')
-  parse_fixedpoint_float(&f[10], &data->geoid_sep_m);
-
-  // field 12: dgps age (optional, may be empty)
-  parse_fixedpoint_float(&f[12], &data->dgps_age_sec);
-
-  // field 13: dgps station id (optional, may be empty)
-  if (parse_uint(&f[13], &tmp)) {
-    data->dgps_station_id = (uint16_t)tmp;
-  }
-
-  return TINY_NMEA_OK;
+  return schema_decode(&gga_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_GGA
 
 // gns - gnss fix data (nmea 3.0+)
 // format: $xxGNS,time,lat,ns,lon,ew,mode,numsv,hdop,alt,sep,age,stnid[,navstatus]*cs
@@ -198,26 +247,12 @@ tiny_nmea_res_t handle_parse_gga(const char *sentence, size_t len, tiny_nmea_gga
 #define GNS_MIN_FIELDS 12
 #define GNS_MAX_FIELDS 14
 
-tiny_nmea_res_t handle_parse_gns(const char *sentence, size_t len, tiny_nmea_gns_t *data) {
-  if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
-
-  field_t f[GNS_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, GNS_MAX_FIELDS);
+#if TINY_NMEA_ENABLE_GNS
+// field 5: mode indicators (one char per constellation)
+static tiny_nmea_res_t gns_finish(const field_t *f, uint8_t count, void *out) {
+  (void)count;
+  tiny_nmea_gns_t *data = out;
 
-  if (count < GNS_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: time
-  parse_time(&f[0], &data->time);
-
-  // fields 1-2: latitude
-  parse_latitude(&f[1], &f[2], &data->latitude);
-
-  // fields 3-4: longitude
-  parse_longitude(&f[3], &f[4], &data->longitude);
-
-  // field 5: mode indicators (one char per constellation)
   if (!field_empty(&f[5])) {
     uint8_t mode_len = f[5].len;
     if (mode_len > TINY_NMEA_CONSTELLATION_COUNT) {
@@ -229,36 +264,18 @@ tiny_nmea_res_t handle_parse_gns(const char *sentence, size_t len, tiny_nmea_gns
     data->mode_count = mode_len;
   }
 
-  // field 6: number of satellites used
-  uint32_t tmp;
-  if (parse_uint(&f[6], &tmp)) {
-    data->satellites_used = (uint8_t)tmp;
-  }
-
-  // field 7: hdop
-  parse_fixedpoint_float(&f[7], &data->hdop);
-
-  // field 8: altitude
-  parse_fixedpoint_float(&f[8], &data->altitude_m);
-
-  // field 9: geoidal separation
-  parse_fixedpoint_float(&f[9], &data->geoid_sep_m);
-
-  // field 10: dgps age (optional)
-  parse_fixedpoint_float(&f[10], &data->dgps_age_sec);
+  return TINY_NMEA_OK;
+}
 
-  // field 11: dgps station id (optional)
-  if (parse_uint(&f[11], &tmp)) {
-    data->dgps_station_id = (uint16_t)tmp;
-  }
+TINY_NMEA_DEFINE_SCHEMA(gns_schema, tiny_nmea_gns_t, TINY_NMEA_GNS_SCHEMA,
+                        GNS_MIN_FIELDS, GNS_MAX_FIELDS, gns_finish);
 
-  // field 12: navigation status (nmea 4.1+, optional)
-  if (count > 12) {
-    data->nav_status = parse_nav_status_field(&f[12]);
-  }
+tiny_nmea_res_t handle_parse_gns(const char *sentence, size_t len, tiny_nmea_gns_t *data) {
+  if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  return TINY_NMEA_OK;
+  return schema_decode(&gns_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_GNS
 
 // gsa - gnss dop and active satellites
 // format: $xxGSA,mode,fix,sv1,sv2,...,sv12,pdop,hdop,vdop[,sysid]*cs
@@ -276,23 +293,12 @@ tiny_nmea_res_t handle_parse_gns(const char *sentence, size_t len, tiny_nmea_gns
 #define GSA_MIN_FIELDS 17
 #define GSA_MAX_FIELDS 18
 
-tiny_nmea_res_t handle_parse_gsa(const char *sentence, size_t len, tiny_nmea_gsa_t *data) {
-  if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
-
-  field_t f[GSA_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, GSA_MAX_FIELDS);
-
-  if (count < GSA_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
+#if TINY_NMEA_ENABLE_GSA
+// fields 2-13: satellite prns (may be empty)
+static tiny_nmea_res_t gsa_finish(const field_t *f, uint8_t count, void *out) {
+  (void)count;
+  tiny_nmea_gsa_t *data = out;
 
-  // field 0: mode selection
-  parse_char(&f[0], &data->mode_selection);
-
-  // field 1: fix type
-  data->fix_type = parse_gsa_fix_field(&f[1]);
-
-  // fields 2-13: satellite prns (may be empty)
   uint32_t tmp;
   data->satellite_count = 0;
   for (uint8_t i = 0; i < 12 && data->satellite_count < TINY_NMEA_MAX_SATS_GSA; i++) {
@@ -301,22 +307,18 @@ tiny_nmea_res_t handle_parse_gsa(const char *sentence, size_t len, tiny_nmea_gsa
     }
   }
 
-  // field 14: pdop
-  parse_fixedpoint_float(&f[14], &data->pdop);
-
-  // field 15: hdop
-  parse_fixedpoint_float(&f[15], &data->hdop);
+  return TINY_NMEA_OK;
+}
 
-  // field 16: vdop
-  parse_fixedpoint_float(&f[16], &data->vdop);
+TINY_NMEA_DEFINE_SCHEMA(gsa_schema, tiny_nmea_gsa_t, TINY_NMEA_GSA_SCHEMA,
+                        GSA_MIN_FIELDS, GSA_MAX_FIELDS, gsa_finish);
 
-  // field 17: system id (nmea 4.11+, optional)
-  if (count > 17 && parse_uint(&f[17], &tmp)) {
-    data->system_id = (uint8_t)tmp;
-  }
+tiny_nmea_res_t handle_parse_gsa(const char *sentence, size_t len, tiny_nmea_gsa_t *data) {
+  if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  return TINY_NMEA_OK;
+  return schema_decode(&gsa_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_GSA
 
 // gsv - gnss satellites in view
 // format: $xxGSV,total,msgnum,numsv[,prn,elev,az,snr]...[,sigid]*cs
@@ -336,6 +338,7 @@ tiny_nmea_res_t handle_parse_gsa(const char *sentence, size_t len, tiny_nmea_gsa
 #define GSV_MIN_FIELDS 3
 #define GSV_MAX_FIELDS 20
 
+#if TINY_NMEA_ENABLE_GSV
 tiny_nmea_res_t handle_parse_gsv(const char *sentence, size_t len, tiny_nmea_gsv_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
@@ -404,6 +407,7 @@ tiny_nmea_res_t handle_parse_gsv(const char *sentence, size_t len, tiny_nmea_gsv
 
   return TINY_NMEA_OK;
 }
+#endif // TINY_NMEA_ENABLE_GSV
 
 // vtg - course over ground and ground speed
 // format: $xxVTG,cogt,T,cogm,M,sog,N,sokph,K[,mode]*cs
@@ -423,35 +427,16 @@ tiny_nmea_res_t handle_parse_gsv(const char *sentence, size_t len, tiny_nmea_gsv
 #define VTG_MIN_FIELDS 8
 #define VTG_MAX_FIELDS 10
 
+#if TINY_NMEA_ENABLE_VTG
+TINY_NMEA_DEFINE_SCHEMA(vtg_schema, tiny_nmea_vtg_t, TINY_NMEA_VTG_SCHEMA,
+                        VTG_MIN_FIELDS, VTG_MAX_FIELDS, NULL);
+
 tiny_nmea_res_t handle_parse_vtg(const char *sentence, size_t len, tiny_nmea_vtg_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  field_t f[VTG_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, VTG_MAX_FIELDS);
-
-  if (count < VTG_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: course true (field 1 is 'T')
-  parse_fixedpoint_float(&f[0], &data->course_true_deg);
-
-  // field 2: course magnetic (field 3 is 'M')
-  parse_fixedpoint_float(&f[2], &data->course_mag_deg);
-
-  // field 4: speed knots (field 5 is 'N')
-  parse_fixedpoint_float(&f[4], &data->speed_knots);
-
-  // field 6: speed km/h (field 7 is 'K')
-  parse_fixedpoint_float(&f[6], &data->speed_kph);
-
-  // field 8: faa mode (nmea 2.3+, optional)
-  if (count > 8) {
-    data->faa_mode = parse_faa_mode_field(&f[8]);
-  }
-
-  return TINY_NMEA_OK;
+  return schema_decode(&vtg_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_VTG
 
 // gll - geographic position (latitude/longitude)
 // format: $xxGLL,lat,ns,lon,ew,time,status[,mode]*cs
@@ -469,35 +454,16 @@ tiny_nmea_res_t handle_parse_vtg(const char *sentence, size_t len, tiny_nmea_vtg
 #define GLL_MIN_FIELDS 6
 #define GLL_MAX_FIELDS 8
 
+#if TINY_NMEA_ENABLE_GLL
+TINY_NMEA_DEFINE_SCHEMA(gll_schema, tiny_nmea_gll_t, TINY_NMEA_GLL_SCHEMA,
+                        GLL_MIN_FIELDS, GLL_MAX_FIELDS, NULL);
+
 tiny_nmea_res_t handle_parse_gll(const char *sentence, size_t len, tiny_nmea_gll_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  field_t f[GLL_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, GLL_MAX_FIELDS);
-
-  if (count < GLL_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // fields 0-1: latitude
-  parse_latitude(&f[0], &f[1], &data->latitude);
-
-  // fields 2-3: longitude
-  parse_longitude(&f[2], &f[3], &data->longitude);
-
-  // field 4: time
-  parse_time(&f[4], &data->time);
-
-  // field 5: status
-  data->status_valid = parse_status_valid(&f[5]);
-
-  // field 6: faa mode (nmea 2.3+, optional)
-  if (count > 6) {
-    data->faa_mode = parse_faa_mode_field(&f[6]);
-  }
-
-  return TINY_NMEA_OK;
+  return schema_decode(&gll_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_GLL
 
 // zda - time and date
 // format: $xxZDA,time,day,month,year,ltzh,ltzn*cs
@@ -514,22 +480,12 @@ tiny_nmea_res_t handle_parse_gll(const char *sentence, size_t len, tiny_nmea_gll
 #define ZDA_MIN_FIELDS 6
 #define ZDA_MAX_FIELDS 7
 
-tiny_nmea_res_t handle_parse_zda(const char *sentence, size_t len, tiny_nmea_zda_t *data) {
-  if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
-
-  field_t f[ZDA_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, ZDA_MAX_FIELDS);
-
-  if (count < ZDA_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: time
-  if (!parse_time(&f[0], &data->time)) {
-    return TINY_NMEA_ERR_INVALID_TIME;
-  }
+#if TINY_NMEA_ENABLE_ZDA
+// fields 1-3: date (day, month, year as separate fields)
+static tiny_nmea_res_t zda_finish(const field_t *f, uint8_t count, void *out) {
+  (void)count;
+  tiny_nmea_zda_t *data = out;
 
-  // fields 1-3: date (day, month, year as separate fields)
   uint32_t tmp;
   if (parse_uint(&f[1], &tmp)) data->date.day = (uint8_t)tmp;
   if (parse_uint(&f[2], &tmp)) data->date.month = (uint8_t)tmp;
@@ -542,14 +498,19 @@ tiny_nmea_res_t handle_parse_zda(const char *sentence, size_t len, tiny_nmea_zda
   }
   data->date.valid = true;
 
-  // fields 4-5: local timezone offset (optional, may be empty)
-  int32_t stmp;
-  if (parse_int(&f[4], &stmp)) data->tz_hours = (int8_t)stmp;
-  if (parse_int(&f[5], &stmp)) data->tz_minutes = (uint8_t)stmp;
-
   return TINY_NMEA_OK;
 }
 
+TINY_NMEA_DEFINE_SCHEMA(zda_schema, tiny_nmea_zda_t, TINY_NMEA_ZDA_SCHEMA,
+                        ZDA_MIN_FIELDS, ZDA_MAX_FIELDS, zda_finish);
+
+tiny_nmea_res_t handle_parse_zda(const char *sentence, size_t len, tiny_nmea_zda_t *data) {
+  if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
+
+  return schema_decode(&zda_schema, sentence, len, data);
+}
+#endif // TINY_NMEA_ENABLE_ZDA
+
 // gbs - gnss satellite fault detection
 // format: $xxGBS,time,errlat,errlon,erralt,prn,prob,bias,stddev*cs
 //
@@ -567,37 +528,16 @@ tiny_nmea_res_t handle_parse_zda(const char *sentence, size_t len, tiny_nmea_zda
 #define GBS_MIN_FIELDS 8
 #define GBS_MAX_FIELDS 9
 
+#if TINY_NMEA_ENABLE_GBS
+TINY_NMEA_DEFINE_SCHEMA(gbs_schema, tiny_nmea_gbs_t, TINY_NMEA_GBS_SCHEMA,
+                        GBS_MIN_FIELDS, GBS_MAX_FIELDS, NULL);
+
 tiny_nmea_res_t handle_parse_gbs(const char *sentence, size_t len, tiny_nmea_gbs_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  field_t f[GBS_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, GBS_MAX_FIELDS);
-
-  if (count < GBS_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: time
-  parse_time(&f[0], &data->time);
-
-  // fields 1-3: expected errors
-  parse_fixedpoint_float(&f[1], &data->err_lat_m);
-  parse_fixedpoint_float(&f[2], &data->err_lon_m);
-  parse_fixedpoint_float(&f[3], &data->err_alt_m);
-
-  // field 4: failed satellite prn (optional)
-  uint32_t tmp;
-  if (parse_uint(&f[4], &tmp)) {
-    data->failed_sat_id = (uint8_t)tmp;
-  }
-
-  // fields 5-7: fault detection data (optional)
-  parse_fixedpoint_float(&f[5], &data->prob_missed);
-  parse_fixedpoint_float(&f[6], &data->bias_m);
-  parse_fixedpoint_float(&f[7], &data->bias_stddev_m);
-
-  return TINY_NMEA_OK;
+  return schema_decode(&gbs_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_GBS
 
 // gst - gnss pseudorange error statistics
 // format: $xxGST,time,rms,smaj,smin,orient,errlat,errlon,erralt*cs
@@ -616,30 +556,16 @@ tiny_nmea_res_t handle_parse_gbs(const char *sentence, size_t len, tiny_nmea_gbs
 #define GST_MIN_FIELDS 8
 #define GST_MAX_FIELDS 9
 
+#if TINY_NMEA_ENABLE_GST
+TINY_NMEA_DEFINE_SCHEMA(gst_schema, tiny_nmea_gst_t, TINY_NMEA_GST_SCHEMA,
+                        GST_MIN_FIELDS, GST_MAX_FIELDS, NULL);
+
 tiny_nmea_res_t handle_parse_gst(const char *sentence, size_t len, tiny_nmea_gst_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
-  field_t f[GST_MAX_FIELDS];
-  uint8_t count = tokenize(sentence, len, f, GST_MAX_FIELDS);
-
-  if (count < GST_MIN_FIELDS) return TINY_NMEA_ERR_TOO_FEW_FIELDS;
-
-  memset(data, 0, sizeof(*data));
-
-  // field 0: time
-  parse_time(&f[0], &data->time);
-
-  // fields 1-7: error statistics
-  parse_fixedpoint_float(&f[1], &data->rms_range);
-  parse_fixedpoint_float(&f[2], &data->std_major_m);
-  parse_fixedpoint_float(&f[3], &data->std_minor_m);
-  parse_fixedpoint_float(&f[4], &data->orient_deg);
-  parse_fixedpoint_float(&f[5], &data->std_lat_m);
-  parse_fixedpoint_float(&f[6], &data->std_lon_m);
-  parse_fixedpoint_float(&f[7], &data->std_alt_m);
-
-  return TINY_NMEA_OK;
+  return schema_decode(&gst_schema, sentence, len, data);
 }
+#endif // TINY_NMEA_ENABLE_GST
 
 // ais - vdm/vdo sentences (automatic identification system)
 // format: !xxVDM,fragcnt,fragnum,seqid,channel,payload,fillbits*cs
@@ -656,6 +582,7 @@ tiny_nmea_res_t handle_parse_gst(const char *sentence, size_t len, tiny_nmea_gst
 // * may be empty
 #define AIS_FIELDS 6
 
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
 tiny_nmea_res_t handle_parse_ais(const char *sentence, size_t len, tiny_nmea_ais_t *data) {
   if (!sentence || !data) return TINY_NMEA_ERR_NULL_PTR;
 
@@ -703,4 +630,41 @@ tiny_nmea_res_t handle_parse_ais(const char *sentence, size_t len, tiny_nmea_ais
   }
 
   return TINY_NMEA_OK;
-}
\ No newline at end of file
+}
+#endif // TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
+
+uint8_t handle_min_fields(tiny_nmea_sentence_type_t type) {
+  switch (type) {
+    case TINY_NMEA_SENTENCE_RMC: return RMC_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GGA: return GGA_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GNS: return GNS_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GSA: return GSA_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GSV: return GSV_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_VTG: return VTG_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GLL: return GLL_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_ZDA: return ZDA_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GBS: return GBS_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_GST: return GST_MIN_FIELDS;
+    case TINY_NMEA_SENTENCE_VDM:
+    case TINY_NMEA_SENTENCE_VDO: return AIS_FIELDS;
+    default: return 0;
+  }
+}
+
+uint8_t handle_max_fields(tiny_nmea_sentence_type_t type) {
+  switch (type) {
+    case TINY_NMEA_SENTENCE_RMC: return RMC_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GGA: return GGA_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GNS: return GNS_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GSA: return GSA_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GSV: return GSV_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_VTG: return VTG_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GLL: return GLL_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_ZDA: return ZDA_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GBS: return GBS_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_GST: return GST_MAX_FIELDS;
+    case TINY_NMEA_SENTENCE_VDM:
+    case TINY_NMEA_SENTENCE_VDO: return AIS_FIELDS;
+    default: return 0;
+  }
+}
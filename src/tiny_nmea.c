@@ -24,7 +24,9 @@ tiny_nmea_res_t tiny_nmea_init_callbacks(tiny_nmea_ctx_t *ctx,
     return TINY_NMEA_INVALID_ARGS; //todo: error handling before err callback registered?
   }
 
-  ringbuf_init(&ctx->ringbuf, buffer, buf_size);
+  if (!ringbuf_init(&ctx->ringbuf, buffer, buf_size)) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
 
   ctx->has_checksum = false;
 
@@ -33,17 +35,41 @@ tiny_nmea_res_t tiny_nmea_init_callbacks(tiny_nmea_ctx_t *ctx,
   ctx->error_callback = error_callback;
   ctx->error_user_data = error_user_data;
 
+  ctx->batch_callback = NULL;
+  ctx->batch_user_data = NULL;
+  ctx->batch_results = NULL;
+  ctx->batch_capacity = 0;
+  ctx->batch_count = 0;
+
+  ctx->lazy_callback = NULL;
+  ctx->lazy_user_data = NULL;
+
+  ctx->feed_callback = NULL;
+  ctx->feed_user_data = NULL;
+
   ctx->zda_century = 0;
 
   ctx->stats.sentences_parsed = 0;
   ctx->stats.checksum_errors = 0;
   ctx->stats.parse_errors = 0;
   ctx->stats.buffer_overflows = 0;
+  ctx->stats.sentences_filtered = 0;
+
+  ctx->sentence_filter = TINY_NMEA_SENTENCE_MASK_ENABLED;
 
-  ctx->working_buf_len = 0;
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  memset(&ctx->instr, 0, sizeof(ctx->instr));
+#endif
+
+  ctx->framing_mode = TINY_NMEA_FRAMING_COPY;
+  ctx->window_len = 0;
   ctx->parse_pos = 0;
   ctx->waiting_for_data = false;
 
+  ctx->src = NULL;
+  ctx->src_len = 0;
+  ctx->src_pos = 0;
+
   ctx->parser_state = TINY_NMEA_PARSE_FIND_START;
   memset(ctx->working_buf, 0, TINY_NMEA_WORKING_BUF_LEN * sizeof(ctx->working_buf[0]));
 
@@ -78,11 +104,150 @@ tiny_nmea_res_t tiny_nmea_set_error_callback(tiny_nmea_ctx_t *ctx,
 }
 
 
+tiny_nmea_res_t tiny_nmea_set_batch_callback(tiny_nmea_ctx_t *ctx,
+                                             tiny_nmea_type_t *results,
+                                             const size_t capacity,
+                                             const tiny_nmea_batch_callback_t batch_callback,
+                                             void *batch_user_data) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  // batch mode needs both somewhere to put results and someone to hand them to
+  if (batch_callback && (!results || capacity == 0)) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  ctx->batch_callback = batch_callback;
+  ctx->batch_user_data = batch_user_data;
+  ctx->batch_results = batch_callback ? results : NULL;
+  ctx->batch_capacity = batch_callback ? capacity : 0;
+  ctx->batch_count = 0;
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_set_lazy_callback(tiny_nmea_ctx_t *ctx,
+                                            const tiny_nmea_lazy_callback_t lazy_callback,
+                                            void *lazy_user_data) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  ctx->lazy_callback = lazy_callback;
+  ctx->lazy_user_data = lazy_user_data;
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_set_feed_callback(tiny_nmea_ctx_t *ctx,
+                                            const tiny_nmea_feed_callback_t feed_callback,
+                                            void *feed_user_data) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  ctx->feed_callback = feed_callback;
+  ctx->feed_user_data = feed_user_data;
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_set_sentence_filter(tiny_nmea_ctx_t *ctx,
+                                              const tiny_nmea_sentence_mask_t mask) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  // compiled out types have no handler, never let them through
+  ctx->sentence_filter = mask & TINY_NMEA_SENTENCE_MASK_ENABLED;
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_set_framing_mode(tiny_nmea_ctx_t *ctx,
+                                           const tiny_nmea_framing_mode_t mode) {
+  if (!ctx || (mode != TINY_NMEA_FRAMING_COPY && mode != TINY_NMEA_FRAMING_IN_PLACE)) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  // restart framing from the oldest unconsumed byte
+  // in-place framing never popped its window so those bytes are
+  // re-framed, a partial sentence already copied out is dropped
+  ctx->framing_mode = mode;
+  ctx->window_len = 0;
+  ctx->parse_pos = 0;
+  ctx->waiting_for_data = false;
+  ctx->parser_state = TINY_NMEA_PARSE_FIND_START;
+
+  return TINY_NMEA_OK;
+}
+
 tiny_nmea_res_t tiny_nmea_feed(tiny_nmea_ctx_t *ctx, const uint8_t *data, size_t len) {
   if (!ctx || !data) {
     return TINY_NMEA_INVALID_ARGS;
   }
 
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  // all or nothing, a cut off feed would run into the next producer's bytes
+  size_t res = ringbuf_push(&ctx->ringbuf, data, len, RINGBUF_PUSH_ATOMIC);
+#else
   size_t res = ringbuf_push(&ctx->ringbuf, data, len, RINGBUF_PUSH_DROP);
+#endif
+  if (res > 0 && ctx->feed_callback) {
+    ctx->feed_callback(&ctx->ringbuf, ctx->feed_user_data);
+  }
   return res == len ? TINY_NMEA_OK : TINY_NMEA_ERR_BUFFER_FULL;
 }
+
+tiny_nmea_res_t tiny_nmea_get_instrumentation(const tiny_nmea_ctx_t *ctx, tiny_nmea_instrumentation_t *out) {
+  if (!ctx || !out) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  *out = ctx->instr;
+  return TINY_NMEA_OK;
+#else
+  return TINY_NMEA_ERR_UNSUPPORTED;
+#endif
+}
+
+tiny_nmea_res_t tiny_nmea_reset_instrumentation(tiny_nmea_ctx_t *ctx) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  memset(&ctx->instr, 0, sizeof(ctx->instr));
+  return TINY_NMEA_OK;
+#else
+  return TINY_NMEA_ERR_UNSUPPORTED;
+#endif
+}
+
+tiny_nmea_res_t tiny_nmea_feed_reserve(tiny_nmea_ctx_t *ctx, ringbuf_span_t *span1, ringbuf_span_t *span2) {
+  if (!ctx || !span1 || !span2) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  return TINY_NMEA_ERR_UNSUPPORTED;
+#else
+  return ringbuf_reserve(&ctx->ringbuf, span1, span2) > 0 ? TINY_NMEA_OK : TINY_NMEA_ERR_BUFFER_FULL;
+#endif
+}
+
+tiny_nmea_res_t tiny_nmea_feed_commit(tiny_nmea_ctx_t *ctx, size_t len) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  if (ringbuf_commit(&ctx->ringbuf, len) != len) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+  if (len > 0 && ctx->feed_callback) {
+    ctx->feed_callback(&ctx->ringbuf, ctx->feed_user_data);
+  }
+  return TINY_NMEA_OK;
+}
@@ -8,6 +8,22 @@
 #include <string.h>
 
 tiny_nmea_res_t tiny_nmea_parse(const char *sentence, tiny_nmea_type_t *result) {
+  if (!sentence) {
+    return TINY_NMEA_ERR_NULL_PTR;
+  }
+  return tiny_nmea_parse_len(sentence, strlen(sentence), result);
+}
+
+tiny_nmea_res_t tiny_nmea_parse_len(const char *sentence, size_t len, tiny_nmea_type_t *result) {
+  if (!sentence || !result) {
+    return TINY_NMEA_ERR_NULL_PTR;
+  }
+
+  // 1 byte start, 2 bytes talker id, 3 bytes sentence type, 1 byte comma
+  if (len < 7) {
+    return TINY_NMEA_MALFORMED_SENTENCE;
+  }
+
   tiny_nmea_res_t parse_res = TINY_NMEA_OK;
   // if result does not have type, try to parse from the sentence
   if (!tiny_nmea_talker_valid(result->talker) || !tiny_nmea_sentence_valid(result->type)) {
@@ -22,44 +38,74 @@ tiny_nmea_res_t tiny_nmea_parse(const char *sentence, tiny_nmea_type_t *result)
 
   // 1 byte start, 2 bytes talker id, 3 bytes sentence type, 1 byte comma
   const char *field_data = sentence + 7;
-  size_t field_len = strlen(sentence) - 7;
+  size_t field_len = len - 7;
+  (void)field_data;  // unused with every sentence type compiled out
+  (void)field_len;
 
   // parsers get the sentence data from the first field, stripped comma
+  // only the handlers of sentence types enabled in config.h are dispatched to
   switch (result->type) {
+#if TINY_NMEA_ENABLE_RMC
     case TINY_NMEA_SENTENCE_RMC:
       parse_res = handle_parse_rmc(field_data, field_len, &result->data.rmc);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GGA
     case TINY_NMEA_SENTENCE_GGA:
       parse_res = handle_parse_gga(field_data, field_len, &result->data.gga);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GNS
     case TINY_NMEA_SENTENCE_GNS:
       parse_res = handle_parse_gns(field_data, field_len, &result->data.gns);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GSA
     case TINY_NMEA_SENTENCE_GSA:
       parse_res = handle_parse_gsa(field_data, field_len, &result->data.gsa);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GSV
     case TINY_NMEA_SENTENCE_GSV:
       parse_res = handle_parse_gsv(field_data, field_len, &result->data.gsv);
       break;
+#endif
+#if TINY_NMEA_ENABLE_VTG
     case TINY_NMEA_SENTENCE_VTG:
       parse_res = handle_parse_vtg(field_data, field_len, &result->data.vtg);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GLL
     case TINY_NMEA_SENTENCE_GLL:
       parse_res = handle_parse_gll(field_data, field_len, &result->data.gll);
       break;
+#endif
+#if TINY_NMEA_ENABLE_ZDA
     case TINY_NMEA_SENTENCE_ZDA:
       parse_res = handle_parse_zda(field_data, field_len, &result->data.zda);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GBS
     case TINY_NMEA_SENTENCE_GBS:
       parse_res = handle_parse_gbs(field_data, field_len, &result->data.gbs);
       break;
+#endif
+#if TINY_NMEA_ENABLE_GST
     case TINY_NMEA_SENTENCE_GST:
       parse_res = handle_parse_gst(field_data, field_len, &result->data.gst);
       break;
+#endif
+#if TINY_NMEA_ENABLE_VDM
     case TINY_NMEA_SENTENCE_VDM:
+#endif
+#if TINY_NMEA_ENABLE_VDO
     case TINY_NMEA_SENTENCE_VDO:
+#endif
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
       parse_res = handle_parse_ais(field_data, field_len, &result->data.ais);
       break;
+#endif
+    // not a sentence type or compiled out
     default:
       parse_res = TINY_NMEA_ERR_UNSUPPORTED;
       break;
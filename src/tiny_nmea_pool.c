@@ -0,0 +1,467 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// needed for pthread_setaffinity_np and CPU_SET
+#define _GNU_SOURCE
+
+#include "tiny_nmea/tiny_nmea_pool.h"
+#include "tiny_nmea/internal/delim_scan.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+struct pool_worker;
+
+typedef struct {
+  tiny_nmea_ctx_t ctx;
+  uint8_t *ring;
+  _Atomic bool pending;                  // fed since its worker last ran tiny_nmea_work()
+  tiny_nmea_parser_statistics_t stats;   // snapshot, guarded by the owning worker's stats_lock
+  struct pool_worker *worker;
+} pool_stream_t;
+
+typedef struct pool_worker {
+  tiny_nmea_pool_t *pool;
+  size_t index;
+  pthread_t thread;
+
+  // wakeup, signalled is set by the feeding side when one of
+  // the streams of this worker goes from idle to pending
+  pthread_mutex_t lock;
+  pthread_cond_t wake;
+  bool signalled;
+  bool stopping;
+
+  pthread_mutex_t stats_lock;
+} pool_worker_t;
+
+struct tiny_nmea_pool {
+  pool_stream_t *streams;
+  size_t stream_count;
+  pool_worker_t *workers;
+  size_t worker_count;
+  bool pin_workers;
+  bool running;
+};
+
+static size_t online_cores(void) {
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (size_t)n : 1;
+}
+
+static void stats_add(tiny_nmea_parser_statistics_t *sum, const tiny_nmea_parser_statistics_t *st) {
+  sum->sentences_parsed += st->sentences_parsed;
+  sum->checksum_errors += st->checksum_errors;
+  sum->parse_errors += st->parse_errors;
+  sum->buffer_overflows += st->buffer_overflows;
+  sum->sentences_filtered += st->sentences_filtered;
+}
+
+static void pin_worker(pool_worker_t *w) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET((int)(w->index % online_cores() % CPU_SETSIZE), &set);
+  // best effort, a restricted cpuset just leaves the worker unpinned
+  (void)pthread_setaffinity_np(w->thread, sizeof(set), &set);
+#else
+  (void)w;
+#endif
+}
+
+// run the parser on the streams of this worker, streams are
+// sharded round robin so worker i owns streams i, i + n, i + 2n...
+static void worker_drain(pool_worker_t *w, bool all) {
+  tiny_nmea_pool_t *pool = w->pool;
+
+  for (size_t s = w->index; s < pool->stream_count; s += pool->worker_count) {
+    pool_stream_t *st = &pool->streams[s];
+    if (!atomic_exchange_explicit(&st->pending, false, memory_order_acq_rel) && !all) continue;
+
+    tiny_nmea_work(&st->ctx);
+
+    pthread_mutex_lock(&w->stats_lock);
+    st->stats = st->ctx.stats;
+    pthread_mutex_unlock(&w->stats_lock);
+  }
+}
+
+static void *worker_main(void *arg) {
+  pool_worker_t *w = arg;
+
+  for (;;) {
+    pthread_mutex_lock(&w->lock);
+    while (!w->signalled && !w->stopping) {
+      pthread_cond_wait(&w->wake, &w->lock);
+    }
+    bool stopping = w->stopping;
+    w->signalled = false;
+    pthread_mutex_unlock(&w->lock);
+
+    // on stop, give every stream one last pass
+    worker_drain(w, stopping);
+    if (stopping) break;
+  }
+
+  return NULL;
+}
+
+static void pool_free(tiny_nmea_pool_t *pool, size_t workers_inited) {
+  for (size_t i = 0; i < workers_inited; i++) {
+    pthread_mutex_destroy(&pool->workers[i].lock);
+    pthread_cond_destroy(&pool->workers[i].wake);
+    pthread_mutex_destroy(&pool->workers[i].stats_lock);
+  }
+  if (pool->streams) {
+    for (size_t s = 0; s < pool->stream_count; s++) {
+      free(pool->streams[s].ring);
+    }
+  }
+  free(pool->streams);
+  free(pool->workers);
+  free(pool);
+}
+
+tiny_nmea_res_t tiny_nmea_pool_create(tiny_nmea_pool_t **out, const tiny_nmea_pool_config_t *config) {
+  if (!out || !config || config->stream_count == 0 || config->ring_size < 2) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+  *out = NULL;
+
+  tiny_nmea_pool_t *pool = calloc(1, sizeof(*pool));
+  if (!pool) return TINY_NMEA_ERR_NO_MEMORY;
+
+  size_t workers = config->worker_count ? config->worker_count : online_cores();
+  if (workers > config->stream_count) workers = config->stream_count;
+
+  pool->stream_count = config->stream_count;
+  pool->worker_count = workers;
+  pool->pin_workers = config->pin_workers;
+  pool->streams = calloc(pool->stream_count, sizeof(*pool->streams));
+  pool->workers = calloc(pool->worker_count, sizeof(*pool->workers));
+  if (!pool->streams || !pool->workers) {
+    pool_free(pool, 0);
+    return TINY_NMEA_ERR_NO_MEMORY;
+  }
+
+  for (size_t i = 0; i < workers; i++) {
+    pool_worker_t *w = &pool->workers[i];
+    w->pool = pool;
+    w->index = i;
+    if (pthread_mutex_init(&w->lock, NULL) != 0) {
+      pool_free(pool, i);
+      return TINY_NMEA_ERR_NO_MEMORY;
+    }
+    if (pthread_cond_init(&w->wake, NULL) != 0) {
+      pthread_mutex_destroy(&w->lock);
+      pool_free(pool, i);
+      return TINY_NMEA_ERR_NO_MEMORY;
+    }
+    if (pthread_mutex_init(&w->stats_lock, NULL) != 0) {
+      pthread_mutex_destroy(&w->lock);
+      pthread_cond_destroy(&w->wake);
+      pool_free(pool, i);
+      return TINY_NMEA_ERR_NO_MEMORY;
+    }
+  }
+
+  for (size_t s = 0; s < pool->stream_count; s++) {
+    pool_stream_t *st = &pool->streams[s];
+    st->ring = malloc(config->ring_size);
+    if (!st->ring) {
+      pool_free(pool, workers);
+      return TINY_NMEA_ERR_NO_MEMORY;
+    }
+
+    tiny_nmea_init_callbacks(&st->ctx, st->ring, config->ring_size,
+                             config->parse_callback, config->parse_user_data,
+                             config->error_callback, config->error_user_data);
+    atomic_init(&st->pending, false);
+    st->stats = st->ctx.stats;
+    st->worker = &pool->workers[s % workers];
+  }
+
+  *out = pool;
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_ctx_t *tiny_nmea_pool_stream(tiny_nmea_pool_t *pool, size_t stream) {
+  if (!pool || stream >= pool->stream_count) return NULL;
+  return &pool->streams[stream].ctx;
+}
+
+tiny_nmea_res_t tiny_nmea_pool_start(tiny_nmea_pool_t *pool) {
+  if (!pool || pool->running) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  for (size_t i = 0; i < pool->worker_count; i++) {
+    pool_worker_t *w = &pool->workers[i];
+    // start with a pass so data fed before start is not left waiting
+    w->signalled = true;
+    w->stopping = false;
+
+    if (pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+      // unwind the workers already running
+      for (size_t j = 0; j < i; j++) {
+        pthread_mutex_lock(&pool->workers[j].lock);
+        pool->workers[j].stopping = true;
+        pthread_cond_signal(&pool->workers[j].wake);
+        pthread_mutex_unlock(&pool->workers[j].lock);
+        pthread_join(pool->workers[j].thread, NULL);
+      }
+      return TINY_NMEA_ERR_NO_MEMORY;
+    }
+
+    if (pool->pin_workers) pin_worker(w);
+  }
+
+  pool->running = true;
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_pool_feed(tiny_nmea_pool_t *pool, size_t stream, const uint8_t *data, size_t len) {
+  if (!pool || stream >= pool->stream_count) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  pool_stream_t *st = &pool->streams[stream];
+  tiny_nmea_res_t res = tiny_nmea_feed(&st->ctx, data, len);
+
+  // only the idle to pending edge needs to wake the worker, if the stream
+  // was already pending its worker has yet to claim it and will see this data
+  if (!atomic_exchange_explicit(&st->pending, true, memory_order_acq_rel)) {
+    pool_worker_t *w = st->worker;
+    pthread_mutex_lock(&w->lock);
+    w->signalled = true;
+    pthread_cond_signal(&w->wake);
+    pthread_mutex_unlock(&w->lock);
+  }
+
+  return res;
+}
+
+tiny_nmea_res_t tiny_nmea_pool_stop(tiny_nmea_pool_t *pool) {
+  if (!pool || !pool->running) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  for (size_t i = 0; i < pool->worker_count; i++) {
+    pool_worker_t *w = &pool->workers[i];
+    pthread_mutex_lock(&w->lock);
+    w->stopping = true;
+    pthread_cond_signal(&w->wake);
+    pthread_mutex_unlock(&w->lock);
+  }
+
+  for (size_t i = 0; i < pool->worker_count; i++) {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+
+  pool->running = false;
+  return TINY_NMEA_OK;
+}
+
+void tiny_nmea_pool_destroy(tiny_nmea_pool_t *pool) {
+  if (!pool) return;
+  if (pool->running) tiny_nmea_pool_stop(pool);
+  pool_free(pool, pool->worker_count);
+}
+
+tiny_nmea_res_t tiny_nmea_pool_stream_stats(tiny_nmea_pool_t *pool, size_t stream,
+                                            tiny_nmea_parser_statistics_t *out) {
+  if (!pool || !out || stream >= pool->stream_count) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  pool_stream_t *st = &pool->streams[stream];
+  pthread_mutex_lock(&st->worker->stats_lock);
+  *out = st->stats;
+  pthread_mutex_unlock(&st->worker->stats_lock);
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_pool_stats(tiny_nmea_pool_t *pool, tiny_nmea_parser_statistics_t *out) {
+  if (!pool || !out) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  tiny_nmea_parser_statistics_t sum = {0};
+  for (size_t s = 0; s < pool->stream_count; s++) {
+    tiny_nmea_parser_statistics_t st;
+    tiny_nmea_pool_stream_stats(pool, s, &st);
+    stats_add(&sum, &st);
+  }
+
+  *out = sum;
+  return TINY_NMEA_OK;
+}
+
+// parallel chunked parsing
+
+size_t tiny_nmea_sentence_boundary(const uint8_t *data, size_t len, size_t from) {
+  if (!data || from >= len) return len;
+  if (from == 0) return 0;
+
+  // a start char right after a line end, anything else may be
+  // the middle of a sentence (or a '$' inside some garbage)
+  for (size_t pos = from; pos < len;) {
+    size_t i = delim_find(data + pos, len - pos, DELIM_START);
+    if (i == DELIM_NPOS) break;
+    pos += i;
+    if (data[pos - 1] == '\r' || data[pos - 1] == '\n') return pos;
+    pos++;
+  }
+  return len;
+}
+
+// a sentence as it came out of a chunk, delivered later in stream order
+typedef struct {
+  tiny_nmea_type_t result;
+  bool parsed;             // false if it went to the error callback
+} parallel_entry_t;
+
+typedef struct {
+  tiny_nmea_ctx_t ctx;
+  uint8_t ring[2];         // unused, parse_buffer never touches the ringbuf
+  const uint8_t *data;
+  size_t len;
+  pthread_t thread;
+
+  parallel_entry_t *entries;
+  size_t count;
+  size_t capacity;
+  bool no_memory;
+} parallel_chunk_t;
+
+static void chunk_push(parallel_chunk_t *c, const tiny_nmea_type_t *result, bool parsed) {
+  if (c->no_memory) return;
+  if (c->count == c->capacity) {
+    // start at about one sentence per 64 bytes of the chunk
+    size_t capacity = c->capacity ? c->capacity * 2 : c->len / 64 + 16;
+    parallel_entry_t *entries = realloc(c->entries, capacity * sizeof(*entries));
+    if (!entries) {
+      c->no_memory = true;
+      return;
+    }
+    c->entries = entries;
+    c->capacity = capacity;
+  }
+  c->entries[c->count].result = *result;
+  c->entries[c->count].parsed = parsed;
+  c->count++;
+}
+
+static void chunk_on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)stats;
+  chunk_push(user_data, result, true);
+}
+
+static void chunk_on_error(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)stats;
+  chunk_push(user_data, result, false);
+}
+
+static void *chunk_main(void *arg) {
+  parallel_chunk_t *c = arg;
+  tiny_nmea_parse_buffer(&c->ctx, c->data, c->len);
+  return NULL;
+}
+
+tiny_nmea_res_t tiny_nmea_parse_parallel(const uint8_t *data, size_t len,
+                                         const tiny_nmea_parallel_config_t *config,
+                                         tiny_nmea_parser_statistics_t *stats) {
+  if (!config || (!data && len > 0)) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  size_t n = config->chunk_count ? config->chunk_count : online_cores();
+  // not worth a thread for less than a few sentences
+  if (n > len / 256 + 1) n = len / 256 + 1;
+
+  parallel_chunk_t *chunks = calloc(n, sizeof(*chunks));
+  if (!chunks) return TINY_NMEA_ERR_NO_MEMORY;
+
+  // cut at even offsets, then move each cut forward to the next sentence start
+  size_t start = 0;
+  for (size_t i = 0; i < n; i++) {
+    size_t end = i + 1 == n ? len : tiny_nmea_sentence_boundary(data, len, len / n * (i + 1));
+    if (end < start) end = start;
+
+    parallel_chunk_t *c = &chunks[i];
+    tiny_nmea_init_callbacks(&c->ctx, c->ring, sizeof(c->ring), chunk_on_parse, c, chunk_on_error, c);
+    tiny_nmea_set_sentence_filter(&c->ctx, config->sentence_filter ? config->sentence_filter
+                                                                   : TINY_NMEA_SENTENCE_MASK_ALL);
+    c->data = data + start;
+    c->len = end - start;
+    start = end;
+  }
+
+  // chunk 0 runs on the calling thread
+  size_t started = 1;
+  for (; started < n; started++) {
+    if (pthread_create(&chunks[started].thread, NULL, chunk_main, &chunks[started]) != 0) break;
+  }
+  chunk_main(&chunks[0]);
+  // whatever could not get a thread runs here too
+  for (size_t i = started; i < n; i++) {
+    chunk_main(&chunks[i]);
+  }
+  for (size_t i = 1; i < started; i++) {
+    pthread_join(chunks[i].thread, NULL);
+  }
+
+  tiny_nmea_res_t res = TINY_NMEA_OK;
+  for (size_t i = 0; i < n; i++) {
+    if (chunks[i].no_memory) res = TINY_NMEA_ERR_NO_MEMORY;
+  }
+
+  // merge in stream order. each chunk only knew the century from its own
+  // ZDAs, so RMCs before the first ZDA of a chunk get the year from the
+  // century carried over from the chunks before it, as tiny_nmea_work() would
+  tiny_nmea_parser_statistics_t sum = {0};
+#if TINY_NMEA_ENABLE_ZDA && TINY_NMEA_ENABLE_RMC
+  uint8_t century = 0;
+#endif
+  for (size_t i = 0; i < n && res == TINY_NMEA_OK; i++) {
+    parallel_chunk_t *c = &chunks[i];
+    stats_add(&sum, &c->ctx.stats);
+
+    for (size_t e = 0; e < c->count; e++) {
+      tiny_nmea_type_t *r = &c->entries[e].result;
+
+      if (!c->entries[e].parsed) {
+        if (config->error_callback) config->error_callback(r, sum, config->error_user_data);
+        continue;
+      }
+
+#if TINY_NMEA_ENABLE_ZDA && TINY_NMEA_ENABLE_RMC
+      if (r->type == TINY_NMEA_SENTENCE_ZDA && r->data.zda.date.valid) {
+        const tiny_nmea_date_t *d = &r->data.zda.date;
+        century = d->year >= 100 ? (uint8_t)(d->year / 100) : 0;
+      } else if (r->type == TINY_NMEA_SENTENCE_RMC && r->data.rmc.date.year == 0 && century > 0) {
+        r->data.rmc.date.year = (uint16_t)century * 100 + r->data.rmc.date.year_yy;
+      }
+#endif
+
+      if (config->parse_callback) config->parse_callback(r, sum, config->parse_user_data);
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    free(chunks[i].entries);
+  }
+  free(chunks);
+
+  if (stats && res == TINY_NMEA_OK) *stats = sum;
+  return res;
+}
@@ -0,0 +1,52 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// needed for mmap, fstat and posix_madvise with -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include "tiny_nmea/tiny_nmea_replay.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+tiny_nmea_res_t tiny_nmea_replay_mmap(tiny_nmea_ctx_t *ctx, const char *path) {
+  if (!ctx || !path) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  // nothing to map, still resets framing like any other buffer
+  if (st.st_size == 0) {
+    close(fd);
+    return tiny_nmea_parse_buffer(ctx, NULL, 0);
+  }
+
+  const size_t len = (size_t)st.st_size;
+  void *map = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping keeps the file referenced
+  close(fd);
+  if (map == MAP_FAILED) {
+    return TINY_NMEA_ERR_NO_MEMORY;
+  }
+
+  // read once front to back, let the kernel read ahead aggressively
+  posix_madvise(map, len, POSIX_MADV_SEQUENTIAL);
+
+  tiny_nmea_res_t res = tiny_nmea_parse_buffer(ctx, (const uint8_t *)map, len);
+
+  munmap(map, len);
+  return res;
+}
@@ -0,0 +1,184 @@
+//
+// Created by Lin Yicheng on 2/10/26.
+//
+
+// needed for clock_gettime and poll with -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include "tiny_nmea/tiny_nmea_wakeup.h"
+#include "tiny_nmea/internal/ringbuf.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <time.h>
+#include <unistd.h>
+
+static void wakeup_signal(tiny_nmea_wakeup_t *w) {
+  const uint64_t one = 1;
+  // can only fail if the counter is saturated, it is signalled then anyway
+  ssize_t res = write(w->fd, &one, sizeof(one));
+  (void)res;
+}
+
+// watermark check, in-place framing leaves the partial sentence it is
+// waiting on in the ring, counting it would end every wait right away
+static bool wakeup_reached(const tiny_nmea_wakeup_t *w, const ringbuf_t *ringbuf) {
+  const size_t len = ringbuf_len(ringbuf);
+  const size_t held = atomic_load_explicit(&w->held, memory_order_relaxed);
+  return len > held && len - held >= w->watermark;
+}
+
+// feed callback, runs on the producer after every feed
+static void wakeup_on_feed(const ringbuf_t *ringbuf, void *feed_user_data) {
+  tiny_nmea_wakeup_t *w = feed_user_data;
+
+  // pairs with the fence in tiny_nmea_wakeup_arm(), either the consumer
+  // sees the bytes just pushed or this sees it armed, never neither
+  atomic_thread_fence(memory_order_seq_cst);
+  // acquire pairs with the release in tiny_nmea_wakeup_arm() for held
+  if (!atomic_load_explicit(&w->armed, memory_order_acquire)) {
+    return;
+  }
+  if (!wakeup_reached(w, ringbuf)) {
+    return;
+  }
+  // only one producer gets to signal per arm
+  if (atomic_exchange_explicit(&w->armed, false, memory_order_relaxed)) {
+    wakeup_signal(w);
+  }
+}
+
+tiny_nmea_res_t tiny_nmea_wakeup_init(tiny_nmea_wakeup_t *w, tiny_nmea_ctx_t *ctx, size_t watermark) {
+  if (!w || !ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  if (watermark == 0) {
+    watermark = 1;
+  }
+  // a watermark the ring can never reach would only ever time out
+  if (watermark > ringbuf_len(&ctx->ringbuf) + ringbuf_free(&ctx->ringbuf)) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  w->fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (w->fd < 0) {
+    return TINY_NMEA_ERR_NO_MEMORY;
+  }
+
+  w->ctx = ctx;
+  w->watermark = watermark;
+  atomic_init(&w->held, 0);
+  atomic_init(&w->armed, false);
+  atomic_init(&w->kicked, false);
+
+  return tiny_nmea_set_feed_callback(ctx, wakeup_on_feed, w);
+}
+
+bool tiny_nmea_wakeup_arm(tiny_nmea_wakeup_t *w) {
+  // only the consumer touches the framing window, so publish its size for
+  // the producers here, it can not change until the next tiny_nmea_work()
+  const tiny_nmea_ctx_t *ctx = w->ctx;
+  const size_t held = ctx->framing_mode == TINY_NMEA_FRAMING_IN_PLACE ? ctx->window_len : 0;
+  atomic_store_explicit(&w->held, held, memory_order_relaxed);
+
+  atomic_store_explicit(&w->armed, true, memory_order_release);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  if (wakeup_reached(w, &ctx->ringbuf)) {
+    atomic_store_explicit(&w->armed, false, memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+int tiny_nmea_wakeup_fd(const tiny_nmea_wakeup_t *w) {
+  return w->fd;
+}
+
+void tiny_nmea_wakeup_clear(tiny_nmea_wakeup_t *w) {
+  uint64_t count;
+  // nonblocking, EAGAIN just means there was nothing to drain
+  ssize_t res = read(w->fd, &count, sizeof(count));
+  (void)res;
+}
+
+void tiny_nmea_wakeup_wake(tiny_nmea_wakeup_t *w) {
+  atomic_store_explicit(&w->kicked, true, memory_order_release);
+  wakeup_signal(w);
+}
+
+// ms left until deadline, rounded up so a wait never ends early
+static int remaining_ms(const struct timespec *deadline) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  int64_t ns = (int64_t)(deadline->tv_sec - now.tv_sec) * 1000000000 + (deadline->tv_nsec - now.tv_nsec);
+  if (ns <= 0) {
+    return 0;
+  }
+  return (int)((ns + 999999) / 1000000);
+}
+
+tiny_nmea_res_t tiny_nmea_wakeup_wait(tiny_nmea_wakeup_t *w, const int timeout_ms) {
+  if (!w || w->fd < 0) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  struct timespec deadline = {0};
+  if (timeout_ms >= 0) {
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+      deadline.tv_sec++;
+      deadline.tv_nsec -= 1000000000;
+    }
+  }
+
+  for (;;) {
+    if (atomic_exchange_explicit(&w->kicked, false, memory_order_acquire)) {
+      return TINY_NMEA_OK;
+    }
+    if (tiny_nmea_wakeup_arm(w)) {
+      return TINY_NMEA_OK;
+    }
+
+    const int wait_ms = timeout_ms < 0 ? -1 : remaining_ms(&deadline);
+    struct pollfd pfd = {.fd = w->fd, .events = POLLIN, .revents = 0};
+    const int res = wait_ms == 0 ? 0 : poll(&pfd, 1, wait_ms);
+    atomic_store_explicit(&w->armed, false, memory_order_relaxed);
+
+    if (res > 0) {
+      // signalled, but maybe left over from an earlier arm, check again
+      tiny_nmea_wakeup_clear(w);
+      continue;
+    }
+    if (res < 0 && errno == EINTR) {
+      continue;
+    }
+    if (res < 0) {
+      return TINY_NMEA_INVALID_ARGS;
+    }
+
+    // timed out, a feed may still have landed right before disarming
+    return wakeup_reached(w, &w->ctx->ringbuf) ? TINY_NMEA_OK : TINY_NMEA_ERR_TIMEOUT;
+  }
+}
+
+void tiny_nmea_wakeup_deinit(tiny_nmea_wakeup_t *w) {
+  if (!w) {
+    return;
+  }
+
+  if (w->ctx && w->ctx->feed_user_data == w) {
+    tiny_nmea_set_feed_callback(w->ctx, NULL, NULL);
+  }
+  if (w->fd >= 0) {
+    close(w->fd);
+  }
+  w->fd = -1;
+  w->ctx = NULL;
+}
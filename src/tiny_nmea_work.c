@@ -3,13 +3,104 @@
 //
 
 #include "tiny_nmea/tiny_nmea.h"
+#include "tiny_nmea/internal/delim_scan.h"
 #include "tiny_nmea/internal/ringbuf.h"
 #include "tiny_nmea/internal/util.h"
 
 #include <string.h>
 
+// default instrumentation clock, see TINY_NMEA_INSTR_NOW in config.h
+#if TINY_NMEA_ENABLE_INSTRUMENTATION && !defined(TINY_NMEA_INSTR_NOW)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <x86intrin.h>
+#define TINY_NMEA_INSTR_NOW() ((uint64_t)__rdtsc())
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER)
+#include <intrin.h>
+#define TINY_NMEA_INSTR_NOW() ((uint64_t)__rdtsc())
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+static inline uint64_t instr_cntvct(void) {
+  uint64_t v;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+}
+#define TINY_NMEA_INSTR_NOW() instr_cntvct()
+#else
+#include <time.h>
+static inline uint64_t instr_timespec_ns(void) {
+  struct timespec ts;
+  timespec_get(&ts, TIME_UTC);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#define TINY_NMEA_INSTR_NOW() instr_timespec_ns()
+#endif
+#endif
+
+// offset sentinel for "not found" in the framing window
+#define WINDOW_NPOS DELIM_NPOS
+
+// instrumentation hooks, all of them compile away without
+// TINY_NMEA_ENABLE_INSTRUMENTATION
+static inline uint64_t instr_now(void) {
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  return TINY_NMEA_INSTR_NOW();
+#else
+  return 0;
+#endif
+}
+
+static inline void instr_state(tiny_nmea_ctx_t *ctx, tiny_nmea_parser_fsm_state_t state, uint64_t t0) {
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  ctx->instr.state_ticks[state] += instr_now() - t0;
+  ctx->instr.state_steps[state]++;
+#else
+  (void)ctx; (void)state; (void)t0;
+#endif
+}
+
+static inline void instr_parse(tiny_nmea_ctx_t *ctx, tiny_nmea_sentence_type_t type, uint64_t t0) {
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  const uint64_t ticks = instr_now() - t0;
+  ctx->instr.parse_ticks += ticks;
+  // bucket by bit length, [2^(i-1), 2^i) lands in bucket i
+  unsigned bucket = ticks ? 64 - clz64(ticks) : 0;
+  if (bucket >= TINY_NMEA_INSTR_HIST_BUCKETS) bucket = TINY_NMEA_INSTR_HIST_BUCKETS - 1;
+  ctx->instr.parse_hist[type][bucket]++;
+#else
+  (void)ctx; (void)type; (void)t0;
+#endif
+}
+
+static inline void instr_callback(tiny_nmea_ctx_t *ctx, uint64_t t0) {
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  ctx->instr.callback_ticks += instr_now() - t0;
+#else
+  (void)ctx; (void)t0;
+#endif
+}
+
+static inline void instr_find_start_discard(tiny_nmea_ctx_t *ctx, size_t amt) {
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  ctx->instr.find_start_discarded += amt;
+#else
+  (void)ctx; (void)amt;
+#endif
+}
+
+// xor of [start, end), eight bytes at a time folded down to one
+// byte order does not matter since every byte lands in the same fold
 static uint8_t nmea_checksum_helper(const char *start, const char *end) {
-  uint8_t cs = 0;
+  uint64_t acc = 0;
+  while (end - start >= 8) {
+    uint64_t w;
+    memcpy(&w, start, sizeof(w));
+    acc ^= w;
+    start += 8;
+  }
+  acc ^= acc >> 32;
+  acc ^= acc >> 16;
+  acc ^= acc >> 8;
+
+  uint8_t cs = (uint8_t)acc;
   while (start < end) {
     cs ^= *start++;
   }
@@ -21,68 +112,294 @@ static inline uint8_t date_get_century_helper(const tiny_nmea_date_t *d) {
 }
 
 void parse_post_process(tiny_nmea_ctx_t *ctx, tiny_nmea_type_t *result) {
+  (void)ctx;  // unused with ZDA and RMC compiled out
   switch (result->type) {
+#if TINY_NMEA_ENABLE_ZDA
   case TINY_NMEA_SENTENCE_ZDA:
     // ZDA gives us the century so we can keep track
     if (result->data.zda.date.valid) {
       ctx->zda_century = date_get_century_helper(&result->data.zda.date);
     }
     break;
+#endif
 
+#if TINY_NMEA_ENABLE_RMC
   case TINY_NMEA_SENTENCE_RMC:
     // compute correct full year from 2 digit year if century known
     if (ctx->zda_century > 0) {
       result->data.rmc.date.year = (uint16_t)ctx->zda_century * 100 + result->data.rmc.date.year_yy;
     }
     break;
+#endif
 
   default:
     break;
   }
 }
 
-#define RESET_WORKBUF_BYTES(c, len) {               \
-  (c)->working_buf_len = (len);                     \
-  (c)->parse_pos = 0;                               \
-  (c)->parser_state = TINY_NMEA_PARSE_FIND_START;   \
+// the framing window is the run of bytes the FSM is currently looking at,
+// always starting at the first unconsumed byte. with copy framing the bytes
+// are popped into the linear working_buf. with in-place framing they are left
+// in the ringbuf storage, so the window can be split in two at the wrap point.
+// tiny_nmea_parse_buffer() frames straight out of the caller's buffer instead
+// of the ringbuf, which is like in-place framing that never wraps
+typedef struct {
+  const uint8_t *ptr[2];
+  size_t len[2];
+} window_view_t;
+
+static inline bool framing_in_place(const tiny_nmea_ctx_t *ctx) {
+  return ctx->framing_mode == TINY_NMEA_FRAMING_IN_PLACE;
+}
+
+static inline void window_get_view(const tiny_nmea_ctx_t *ctx, window_view_t *v) {
+  if (ctx->src) {
+    v->ptr[0] = ctx->src + ctx->src_pos;
+    v->len[0] = ctx->window_len;
+    v->ptr[1] = NULL;
+    v->len[1] = 0;
+  } else if (framing_in_place(ctx)) {
+    // the window is the front of the readable data, it never
+    // extends past what the ringbuf reported when it was grown
+    ringbuf_span_t s1, s2;
+    ringbuf_peek_spans(&ctx->ringbuf, &s1, &s2);
+    v->ptr[0] = s1.ptr;
+    v->len[0] = min_size(ctx->window_len, s1.len);
+    v->ptr[1] = s2.ptr;
+    v->len[1] = ctx->window_len - v->len[0];
+  } else {
+    v->ptr[0] = ctx->working_buf;
+    v->len[0] = ctx->window_len;
+    v->ptr[1] = NULL;
+    v->len[1] = 0;
+  }
+}
+
+static inline uint8_t window_at(const window_view_t *v, size_t off) {
+  return off < v->len[0] ? v->ptr[0][off] : v->ptr[1][off - v->len[0]];
+}
+
+// find the first delimiter of the wanted DELIM_* classes at or
+// after offset from, WINDOW_NPOS if none
+static size_t window_find(const window_view_t *v, size_t from, uint8_t want) {
+  if (from < v->len[0]) {
+    const size_t i = delim_find(v->ptr[0] + from, v->len[0] - from, want);
+    if (i != DELIM_NPOS) return from + i;
+    from = v->len[0];
+  }
+
+  const size_t off = from - v->len[0];
+  if (off < v->len[1]) {
+    const size_t i = delim_find(v->ptr[1] + off, v->len[1] - off, want);
+    if (i != DELIM_NPOS) return from + i;
+  }
+  return WINDOW_NPOS;
+}
+
+static void window_copy(const window_view_t *v, size_t from, size_t len, uint8_t *dst) {
+  if (from < v->len[0]) {
+    const size_t n = min_size(len, v->len[0] - from);
+    memcpy(dst, v->ptr[0] + from, n);
+    dst += n;
+    len -= n;
+    from = v->len[0];
+  }
+  if (len > 0) {
+    memcpy(dst, v->ptr[1] + (from - v->len[0]), len);
+  }
+}
+
+static uint8_t window_checksum(const window_view_t *v, size_t from, size_t to) {
+  uint8_t cs = 0;
+  if (from < v->len[0]) {
+    const size_t end = min_size(to, v->len[0]);
+    cs ^= nmea_checksum_helper((const char *)v->ptr[0] + from, (const char *)v->ptr[0] + end);
+    from = end;
+  }
+  if (from < to) {
+    cs ^= nmea_checksum_helper((const char *)v->ptr[1] + (from - v->len[0]),
+                               (const char *)v->ptr[1] + (to - v->len[0]));
+  }
+  return cs;
+}
+
+// get a contiguous pointer to the first len bytes of the window
+// only copies when the sentence straddles the ringbuf wrap point
+static const char *window_linearize(tiny_nmea_ctx_t *ctx, const window_view_t *v, size_t len) {
+  if (len <= v->len[0]) {
+    return (const char *)v->ptr[0];
+  }
+  window_copy(v, 0, len, ctx->working_buf);
+  return (const char *)ctx->working_buf;
+}
+
+// bytes in the ringbuf that are not yet part of the window
+static inline size_t window_unread(const tiny_nmea_ctx_t *ctx) {
+  if (ctx->src) return ctx->src_len - ctx->src_pos - ctx->window_len;
+  const size_t avail = ringbuf_len(&ctx->ringbuf);
+  return framing_in_place(ctx) ? avail - ctx->window_len : avail;
+}
+
+static inline void window_extend(tiny_nmea_ctx_t *ctx, size_t amt) {
+  if (ctx->src || framing_in_place(ctx)) {
+    // bytes are already in place, just widen the view
+    ctx->window_len += amt;
+  } else {
+    ctx->window_len += ringbuf_pop(&ctx->ringbuf, ctx->working_buf + ctx->window_len, amt);
+  }
 }
 
 static inline void discard_bytes(tiny_nmea_ctx_t *ctx, size_t amt) {
-  if (amt >= ctx->working_buf_len) {
-    ctx->working_buf_len = 0;
-    return;
+  if (amt > ctx->window_len) {
+    amt = ctx->window_len;
+  }
+  if (ctx->src) {
+    ctx->src_pos += amt;
+  } else if (framing_in_place(ctx)) {
+    // consuming in place just releases the bytes back to the producer
+    ringbuf_discard(&ctx->ringbuf, amt);
+  } else if (amt < ctx->window_len) {
+    memmove(ctx->working_buf, ctx->working_buf + amt, ctx->window_len - amt);
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+    ctx->instr.memmove_bytes += ctx->window_len - amt;
+#endif
+  }
+  ctx->window_len -= amt;
+}
+
+// hand the pending batch over to the user
+static inline void flush_batch(tiny_nmea_ctx_t *ctx) {
+  if (ctx->batch_count > 0) {
+    const uint64_t t0 = instr_now();
+    ctx->batch_callback(ctx->batch_results, ctx->batch_count, &ctx->stats, ctx->batch_user_data);
+    instr_callback(ctx, t0);
+    ctx->batch_count = 0;
   }
-  memmove(ctx->working_buf, ctx->working_buf + amt, ctx->working_buf_len - amt);
-  ctx->working_buf_len -= amt;
 }
 
-#define RESET_TO_START(c) RESET_WORKBUF_BYTES(c, 0)
+// fully decode the framed sentence and hand it to the batch or parse callback
+static void deliver_parsed(tiny_nmea_ctx_t *ctx, const char *data_start) {
+  // in batch mode parse straight into the next free batch slot
+  tiny_nmea_type_t local_result;
+  tiny_nmea_type_t *result = ctx->batch_callback ?
+    &ctx->batch_results[ctx->batch_count] : &local_result;
+  memset(result, 0, sizeof(*result));
+
+  // use pre-parsed type and talker to save time
+  result->type = ctx->current_type;
+  result->talker = ctx->current_talker;
+  // hand off parsing
+  uint64_t t0 = instr_now();
+  tiny_nmea_res_t parse_res = tiny_nmea_parse_len(data_start, ctx->data_end, result);
+  instr_parse(ctx, ctx->current_type, t0);
+
+  if (parse_res == TINY_NMEA_OK) {
+    ctx->stats.sentences_parsed++;
+  } else {
+    ctx->stats.parse_errors++;
+  }
 
-tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
-  if (!ctx) {
-    return TINY_NMEA_INVALID_ARGS;
+  // invoke callback if parsing succeeded
+  if (parse_res == TINY_NMEA_OK) {
+    parse_post_process(ctx, result);
+    if (ctx->batch_callback) {
+      // keep the slot, flush early only if the array is full
+      if (++ctx->batch_count == ctx->batch_capacity) flush_batch(ctx);
+    } else if (ctx->parse_callback) {
+      t0 = instr_now();
+      ctx->parse_callback(result, ctx->stats, ctx->parse_user_data);
+      instr_callback(ctx, t0);
+    }
+  } else if (ctx->error_callback) {
+    t0 = instr_now();
+    ctx->error_callback(result, ctx->stats, ctx->error_user_data);
+    instr_callback(ctx, t0);
+  }
+}
+
+// only tokenize the framed sentence and let the lazy callback decode what it needs
+static void deliver_lazy(tiny_nmea_ctx_t *ctx, const char *data_start) {
+  tiny_nmea_lazy_t lazy;
+
+  // use pre-parsed type and talker to save time
+  lazy.type = ctx->current_type;
+  lazy.talker = ctx->current_talker;
+  uint64_t t0 = instr_now();
+  tiny_nmea_res_t parse_res = tiny_nmea_lazy_parse(data_start, ctx->data_end, &lazy);
+  instr_parse(ctx, ctx->current_type, t0);
+
+  if (parse_res != TINY_NMEA_OK) {
+    ctx->stats.parse_errors++;
+    if (ctx->error_callback) {
+      tiny_nmea_type_t result;
+      memset(&result, 0, sizeof(result));
+      result.type = lazy.type;
+      result.talker = lazy.talker;
+      t0 = instr_now();
+      ctx->error_callback(&result, ctx->stats, ctx->error_user_data);
+      instr_callback(ctx, t0);
+    }
+    return;
+  }
+
+  ctx->stats.sentences_parsed++;
+
+  // ZDA still has to be decoded up front to keep the century tracking going
+  if (lazy.type == TINY_NMEA_SENTENCE_ZDA) {
+    tiny_nmea_date_t date;
+    if (tiny_nmea_lazy_date(&lazy, &date)) {
+      ctx->zda_century = date_get_century_helper(&date);
+    }
   }
+  lazy.century = ctx->zda_century;
 
-  // while the ringbuf has more bytes to process, or our current working buffer
-  // has unprocessed bytes (when ctx->parse_pos < ctx->working_buf_len)
-  while (!ringbuf_empty(&ctx->ringbuf) ||
-       (ctx->working_buf_len > ctx->parse_pos)) {
-    size_t bytes_avail = ringbuf_len(&ctx->ringbuf);
+  t0 = instr_now();
+  ctx->lazy_callback(&lazy, ctx->stats, ctx->lazy_user_data);
+  instr_callback(ctx, t0);
+}
+
+#define RESET_FSM(c) {                              \
+  (c)->parse_pos = 0;                               \
+  (c)->parser_state = TINY_NMEA_PARSE_FIND_START;   \
+}
+
+#define RESET_TO_START(c) {                         \
+  discard_bytes((c), (c)->window_len);              \
+  RESET_FSM(c);                                     \
+}
+
+// drop a rejected sentence up to its line end but keep whatever
+// follows in the window, so the next sentence does not depend on
+// how much of it happened to be read along with this one
+#define DROP_LINE(c) {                              \
+  discard_bytes((c), (c)->line_end);                \
+  RESET_FSM(c);                                     \
+}
+
+// run the FSM until the window source runs dry
+static void work_fsm(tiny_nmea_ctx_t *ctx) {
+  // while the ringbuf has more bytes to process, or our current window
+  // has unprocessed bytes (when ctx->parse_pos < ctx->window_len)
+  for (;;) {
+    // the step is charged to the state it started in
+    const uint64_t step_t0 = instr_now();
+    const tiny_nmea_parser_fsm_state_t step_state = ctx->parser_state;
+
+    size_t bytes_avail = window_unread(ctx);
+    if (bytes_avail == 0 && ctx->window_len <= ctx->parse_pos) break;
 
     // break immediately if waiting for data but none avail, nothing to do
     if (ctx->waiting_for_data && bytes_avail == 0) break;
 
     // if there is even data in the ringbuffer
-    // fill the rest of the linear working buffer with whatever
-    // data is available, and whatever we transfer, pop it from
-    // the ringbuffer
-    size_t space_in_workbuf = TINY_NMEA_MAX_SENTENCE_LEN - ctx->working_buf_len;
-    size_t to_pop = min_size(space_in_workbuf, bytes_avail);
-    if (to_pop > 0) {
-      ctx->working_buf_len += ringbuf_pop(&ctx->ringbuf,
-          ctx->working_buf + ctx->working_buf_len, to_pop);
-    } else if (space_in_workbuf == 0 && ctx->waiting_for_data) {
-      // buffer full but waiting for data
+    // grow the window with whatever data is available
+    // (copy framing pops it into the working buffer)
+    size_t space_in_window = TINY_NMEA_MAX_SENTENCE_LEN - ctx->window_len;
+    size_t to_take = min_size(space_in_window, bytes_avail);
+    if (to_take > 0) {
+      window_extend(ctx, to_take);
+    } else if (space_in_window == 0 && ctx->waiting_for_data) {
+      // window full but waiting for data
       // overran buffer, reset buffer
       ctx->stats.buffer_overflows++;
       RESET_TO_START(ctx);
@@ -92,61 +409,56 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
     ctx->waiting_for_data = false;
 
     // check if anything to do this loop
-    if ((ctx->working_buf_len - ctx->parse_pos) == 0) {
-      if (ringbuf_empty(&ctx->ringbuf)) {
+    if ((ctx->window_len - ctx->parse_pos) == 0) {
+      if (window_unread(ctx) == 0) {
         break;  // nothing to do
       }
-      // buffer empty but ringbuf has data
-      // try to read into the buffer next iteration
+      // window empty but ringbuf has data
+      // try to grow the window next iteration
       continue;
     }
 
+    window_view_t view;
+    window_get_view(ctx, &view);
+
     // proceed with FSM
     // enforce that when TINY_NMEA_PARSE_FIND_START is reached, the parse_pos
-    // is always at 0 and at the start of the working buffer
+    // is always at 0 and at the start of the window
     switch (ctx->parser_state) {
       case TINY_NMEA_PARSE_FIND_START: {
         // in this case we just finished parsing a sentence
         // or we just reset to the known state. this means we
-        // can assume that the start of the linear working buffer
-        // is the start of the unprocessed information
+        // can assume that the start of the window is the
+        // start of the unprocessed information
 
         // we actually have data to work with
         // now try to find the start char '$' or '!' in the
-        // data we peeked using memchr
-        // which is hopefully faster than parsing byte-by-byte
+        // window with the delimiter scanner, both in one pass
         ctx->has_checksum = false;
-        uint8_t *start = NULL;
-        if (ctx->working_buf[0] == '$' || ctx->working_buf[0] == '!') {
+        size_t start = WINDOW_NPOS;
+        if (delim_class(window_at(&view, 0)) == DELIM_START) {
           // short circuit case in case of common situation
           // where we just finished parsing a sentence
-          start = &ctx->working_buf[0];
+          start = 0;
         } else {
-          uint8_t *start_dollar = memchr(ctx->working_buf, '$', ctx->working_buf_len);
-          uint8_t *start_exclam = memchr(ctx->working_buf, '!', ctx->working_buf_len);
-          if (start_dollar && start_exclam) {
-            // both are found, pick the minimum
-            start = min_ptr(start_dollar, start_exclam);
-          } else {
-            // only one is found, use whichever is not null
-            start = start_dollar ? start_dollar : start_exclam;
-          }
+          start = window_find(&view, 0, DELIM_START);
         }
 
-        if (start) {
+        if (start != WINDOW_NPOS) {
           // managed to find a start char
           // discard all the bytes before the start char
-          size_t start_offset = start - ctx->working_buf;
-          discard_bytes(ctx, start_offset);
+          instr_find_start_discard(ctx, start);
+          discard_bytes(ctx, start);
           ctx->parse_pos = 1;// skip start char
           ctx->computed_checksum = 0; // reset running checksum
 
           // change FSM state to proceed with parsing
           ctx->parser_state = TINY_NMEA_PARSE_FIND_TALKER_AND_TYPE;
         } else {
-          // not found, discard the contents of the working buffer
+          // not found, discard the contents of the window
           // since there is no start. FSM state does not change
           // do not count this as an error
+          instr_find_start_discard(ctx, ctx->window_len);
           RESET_TO_START(ctx);
         }
         break;
@@ -158,7 +470,7 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
         // sentence 3 bytes and end with a comma
 
         // check if we have enough data
-        if ((ctx->working_buf_len - ctx->parse_pos) < 6) {
+        if ((ctx->window_len - ctx->parse_pos) < 6) {
           // there is insufficient data for the talker id and sentence type
           // indicate we are waiting for more bytes
           ctx->waiting_for_data = true;
@@ -166,26 +478,38 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
           break;
         }
 
+        // the header may straddle the ringbuf wrap, so grab a copy
+        char header[7];
+        window_copy(&view, 0, sizeof(header), (uint8_t *)header);
+
         // there is sufficient data for the talker id and sentence type
         // parse talker (bytes 1-2) and sentence type (bytes 3-5)
-        ctx->current_talker = parse_talker_id((const char *)&ctx->working_buf[1]);
-        ctx->current_type = parse_sentence_type((const char *)&ctx->working_buf[3]);
+        ctx->current_talker = parse_talker_id(&header[1]);
+        ctx->current_type = parse_sentence_type(&header[3]);
 
         // check that talker id and sentence type are valid
         // and that a comma follows
         if (!tiny_nmea_talker_valid(ctx->current_talker) ||
               !tiny_nmea_sentence_valid(ctx->current_type) ||
-              (ctx->working_buf[6] != ',')) {
+              (header[6] != ',')) {
           // invalid header
           // skip one char and restart search
           discard_bytes(ctx, 1);
 
           // revert back to finding a start
           ctx->stats.parse_errors++;
-          RESET_WORKBUF_BYTES(ctx, ctx->working_buf_len);
+          RESET_FSM(ctx);
+        } else if (!(ctx->sentence_filter & TINY_NMEA_SENTENCE_BIT(ctx->current_type))) {
+          // valid but not wanted, skip it without
+          // checksumming or parsing anything
+          ctx->stats.sentences_filtered++;
+          ctx->parse_pos += 6;
+          ctx->parser_state = TINY_NMEA_PARSE_SKIP_TO_END;
         } else {
           // both are valid
-          // continue parsing
+          // continue parsing, the running checksum starts
+          // with the header after the start char
+          ctx->computed_checksum = nmea_checksum_helper(&header[1], &header[7]);
           ctx->parse_pos += 6;
           ctx->parser_state = TINY_NMEA_PARSE_FIND_CHECKSUM_OR_END;
         }
@@ -196,59 +520,39 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
         // now we try to either find the asterisk '*' indicating
         // presence of a checksum, or we try to find the line end
         // this serves the purpose of finding the data end
-        size_t remaining = ctx->working_buf_len - ctx->parse_pos;
-        uint8_t *search_start = ctx->working_buf + ctx->parse_pos;
-
-        // scan for '*' using memchr if there is checksum
-        uint8_t *asterisk = memchr(search_start, '*', remaining);
 
-        // also scan for end tokens since checksum is optional
-        // in nmea 0183 sentences
-        uint8_t *cr = memchr(search_start, '\r', remaining);
-        uint8_t *lf = memchr(search_start, '\n', remaining);
-
-        // pick the earliest of all the line endings
-        ctx->line_end = NULL;
-        if (cr && lf) {
-          ctx->line_end = min_ptr(cr, lf);
-        } else {
-          // only one found
-          // technically malformed, but just take earliest?
-          // todo: add a compile flag to strictly require the line endings or strictly require one of the endings
-          ctx->line_end = cr ? cr : lf;
-        }
-
-        // determine which comes first, asterisk or line ending
-        uint8_t *data_end = NULL;
-        bool has_checksum = false;
-        if (asterisk && ctx->line_end) {
-          has_checksum = asterisk < ctx->line_end;
-          data_end = has_checksum ? asterisk : ctx->line_end;
-        } else if (ctx->line_end) {
-          // found line end but no asterisk
-          // there is definitely no checksum
-          has_checksum = false;
-          data_end = ctx->line_end;
-        } else if (asterisk) {
-          // found asterisk but no line end
-          // there is definitely a checksum
-          has_checksum = true;
-          data_end = asterisk;
-        } else {
+        // scan for '*' if there is checksum, and for the line end
+        // since checksum is optional in nmea 0183 sentences
+        // a single pass finds whichever of them comes first
+        // CR or LF alone is technically malformed, but just take earliest?
+        // todo: add a compile flag to strictly require the line endings or strictly require one of the endings
+        size_t data_end = window_find(&view, ctx->parse_pos, DELIM_STAR | DELIM_EOL);
+        if (data_end == WINDOW_NPOS) {
           // may need more data, wait first
           if (ctx->parse_pos > TINY_NMEA_MAX_SENTENCE_LEN) {
             ctx->stats.parse_errors++;
             discard_bytes(ctx, ctx->parse_pos);
-            RESET_WORKBUF_BYTES(ctx, ctx->working_buf_len);
+            RESET_FSM(ctx);
           } else {
-            ctx->parse_pos = ctx->working_buf_len;
+            // fold the scanned bytes into the running checksum
+            // so they are never read again
+            ctx->computed_checksum ^= window_checksum(&view, ctx->parse_pos, ctx->window_len);
+            ctx->parse_pos = ctx->window_len;
             ctx->waiting_for_data = true;
           }
           break;
         }
 
+        // the rest of the data up to the '*' or line end
+        ctx->computed_checksum ^= window_checksum(&view, ctx->parse_pos, data_end);
+
+        // a checksum exists if the asterisk comes before any line end
+        // in which case the line end is searched for from there on
+        bool has_checksum = delim_class(window_at(&view, data_end)) == DELIM_STAR;
+        ctx->line_end = has_checksum ? WINDOW_NPOS : data_end;
+
         // else update parse position
-        ctx->parse_pos = data_end - ctx->working_buf;
+        ctx->parse_pos = data_end;
         ctx->has_checksum = has_checksum;
         ctx->data_end = data_end;
 
@@ -263,38 +567,25 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
       }
       case TINY_NMEA_PARSE_FIND_END: {
         // we have found '*' which indicates there is a checksum
-        // so now we try to find the actual end of the sentence (if it was
-        // not already found) and we parse the checksum
+        // so now we try to find the actual end of the sentence
+        // and we parse the checksum
         // if there is no checksum, the earlier step would skip to
         // the sentence completed state
 
-        // check if we already found line end min and max from the earlier
-        // step, so we can skip line finding to save time
-        if (!ctx->line_end) {
-          // find line ending which could be CR, LF, or CRLF
-          // todo: should i add a define to enable stricter checking of line endings? or prefer one over the other?
-          size_t remaining = ctx->working_buf_len - ctx->parse_pos;
-          uint8_t *search_start = ctx->working_buf + ctx->parse_pos;
-
-          uint8_t *cr = memchr(search_start, '\r', remaining);
-          uint8_t *lf = memchr(search_start, '\n', remaining);
-
-          if (cr && lf) {
-            ctx->line_end = min_ptr(cr, lf);
-          } else {
-            ctx->line_end = cr ? cr : lf;
-          }
-        }
+        // find line ending which could be CR, LF, or CRLF
+        // parse_pos only covers bytes not scanned yet
+        // todo: should i add a define to enable stricter checking of line endings? or prefer one over the other?
+        ctx->line_end = window_find(&view, ctx->parse_pos, DELIM_EOL);
 
         // check if we actually found line end
-        if (!ctx->line_end) {
+        if (ctx->line_end == WINDOW_NPOS) {
           // may need more bytes until line end
           if (ctx->parse_pos > TINY_NMEA_MAX_SENTENCE_LEN) {
             ctx->stats.parse_errors++;
             discard_bytes(ctx, ctx->parse_pos);
-            RESET_WORKBUF_BYTES(ctx, ctx->working_buf_len);
+            RESET_FSM(ctx);
           } else {
-            ctx->parse_pos = ctx->working_buf_len;
+            ctx->parse_pos = ctx->window_len;
             ctx->waiting_for_data = true;
           }
           break;
@@ -302,90 +593,138 @@ tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
         }
 
         // check if we actually have 2 chars between asterisk and end
-        uint8_t *hex_start = ctx->data_end + 1;
-        if (ctx->line_end <= hex_start || (size_t)(ctx->line_end - hex_start) != 2) {
-          // wrong num of chars for checksum, reset and
+        size_t hex_start = ctx->data_end + 1;
+        if (ctx->line_end <= hex_start || (ctx->line_end - hex_start) != 2) {
+          // wrong num of chars for checksum, drop the line and
           // break immediately, do not attempt parsing
           ctx->stats.parse_errors++;
-          RESET_TO_START(ctx);
+          DROP_LINE(ctx);
           break;
         }
 
         // check if we have a valid hex byte
-        if (parse_hex_byte((const char *)hex_start, &ctx->received_checksum) != 2) {
-          // not valid hex chars in checksum, reset and
+        const char hex[2] = {(char)window_at(&view, hex_start), (char)window_at(&view, hex_start + 1)};
+        if (parse_hex_byte(hex, &ctx->received_checksum) != 2) {
+          // not valid hex chars in checksum, drop the line and
           // break immediately, do not attempt parsing
           ctx->stats.parse_errors++;
-          RESET_TO_START(ctx);
+          DROP_LINE(ctx);
           break;
         }
 
-        // compute our data checksum
-        ctx->computed_checksum = nmea_checksum_helper(
-          // start from talker id (sentence is always positioned at
-          // the start of the workbuf) so we start 1 char after
-          (const char *)ctx->working_buf + 1,
-          (const char *)ctx->data_end
-        );
-
+        // the data checksum was folded in while searching for the '*'
         if (ctx->computed_checksum == ctx->received_checksum) {
           // checksum matches, sentence complete, handoff to parsers
           ctx->parser_state = TINY_NMEA_SENTENCE_COMPLETE;
         } else {
-          // checksum exists but does not match, reject, reset
-          // and break immediately, do not attempt parsing
+          // checksum exists but does not match, reject, drop the
+          // line and break immediately, do not attempt parsing
           ctx->stats.checksum_errors++;
-          RESET_TO_START(ctx);
+          DROP_LINE(ctx);
+        }
+        break;
+      }
+      case TINY_NMEA_PARSE_SKIP_TO_END: {
+        // filtered sentence, stop at the line end or at the next
+        // start char in case the line was cut short
+        size_t end = window_find(&view, ctx->parse_pos, DELIM_EOL | DELIM_START);
+
+        if (end == WINDOW_NPOS) {
+          // nothing in the window is needed, release it
+          // and keep skipping with the next bytes
+          discard_bytes(ctx, ctx->window_len);
+          ctx->parse_pos = 0;
+        } else {
+          // leave the line ending or start char to FIND_START
+          discard_bytes(ctx, end);
+          RESET_FSM(ctx);
         }
         break;
       }
       case TINY_NMEA_SENTENCE_COMPLETE: {
         // handle completed sentence
 
-        // null-terminate the data field for parsing
-        // the sentence is always positioned at the start of the workbuf
+        // the sentence is always positioned at the start of the window
         // data_end points to '*' (if checksum) or line ending (if no checksum)
-        const char *data_start = (const char *)ctx->working_buf;
-        *ctx->data_end = '\0';
-
-        tiny_nmea_type_t result = {0};
-        // use pre-parsed type and talker to save time
-        result.type = ctx->current_type;
-        result.talker = ctx->current_talker;
-        // hand off parsing
-        tiny_nmea_res_t parse_res = tiny_nmea_parse(data_start, &result);
-
-        if (parse_res == TINY_NMEA_OK) {
-          ctx->stats.sentences_parsed++;
-        } else {
-          ctx->stats.parse_errors++;
-        }
+        // parsers are length bounded, so there is no need to null-terminate
+        // which lets us hand out a pointer straight into the ringbuf storage
+        const char *data_start = window_linearize(ctx, &view, ctx->data_end);
 
-        // invoke callback if parsing succeeded
-        if (parse_res == TINY_NMEA_OK) {
-          parse_post_process(ctx, &result);
-          if (ctx->parse_callback) ctx->parse_callback(&result, ctx->stats, ctx->parse_user_data);
-        } else if (ctx->error_callback) {
-          ctx->error_callback(&result, ctx->stats, ctx->error_user_data);
+        if (ctx->lazy_callback) {
+          deliver_lazy(ctx, data_start);
+        } else {
+          deliver_parsed(ctx, data_start);
         }
 
         // eagerly skip any remaining line ending characters
-        uint8_t *sentence_end = ctx->line_end;
-        while (sentence_end < ctx->working_buf + ctx->working_buf_len &&
-           (*sentence_end == '\r' || *sentence_end == '\n' || *sentence_end == '\0')) {
+        size_t sentence_end = ctx->line_end;
+        while (sentence_end < ctx->window_len) {
+          uint8_t c = window_at(&view, sentence_end);
+          if (c != '\r' && c != '\n') break;
           sentence_end++;
         }
 
-        size_t consumed = sentence_end - ctx->working_buf;
-        discard_bytes(ctx, consumed);
+        discard_bytes(ctx, sentence_end);
 
         // revert back to finding a start
-        RESET_WORKBUF_BYTES(ctx, ctx->working_buf_len);
+        RESET_FSM(ctx);
         break;
       }
       default: break;
     }
+
+    instr_state(ctx, step_state, step_t0);
+  }
+}
+
+tiny_nmea_res_t tiny_nmea_work(tiny_nmea_ctx_t *ctx) {
+  if (!ctx) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+#if TINY_NMEA_ENABLE_INSTRUMENTATION
+  // the consumer sees the ring at its fullest right before draining it
+  const size_t occupancy = ringbuf_len(&ctx->ringbuf);
+  if (occupancy > ctx->instr.ring_high_water) ctx->instr.ring_high_water = occupancy;
+#endif
+
+  work_fsm(ctx);
+
+  if (ctx->batch_callback) {
+    flush_batch(ctx);
+  }
+
+  return TINY_NMEA_OK;
+}
+
+tiny_nmea_res_t tiny_nmea_parse_buffer(tiny_nmea_ctx_t *ctx, const uint8_t *data, size_t len) {
+  if (!ctx || (!data && len > 0)) {
+    return TINY_NMEA_INVALID_ARGS;
+  }
+
+  // restart framing at the start of data, like switching framing modes
+  // a sentence partially framed out of the ringbuf is dropped (copy)
+  // or framed again by the next tiny_nmea_work() (in-place)
+  ctx->window_len = 0;
+  ctx->waiting_for_data = false;
+  RESET_FSM(ctx);
+
+  ctx->src = data;
+  ctx->src_len = len;
+  ctx->src_pos = 0;
+
+  work_fsm(ctx);
+
+  // an unterminated sentence at the end of the buffer can not be
+  // continued by the next call, drop it
+  ctx->src = NULL;
+  ctx->window_len = 0;
+  ctx->waiting_for_data = false;
+  RESET_FSM(ctx);
+
+  if (ctx->batch_callback) {
+    flush_batch(ctx);
   }
 
   return TINY_NMEA_OK;
-}
\ No newline at end of file
+}
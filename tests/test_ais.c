@@ -0,0 +1,605 @@
+//
+// unit tests for ais payload decoding
+//
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea.h"
+#include "tiny_nmea/ais.h"
+#include "tiny_nmea/internal/sentences.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// build payloads bit by bit to cover layouts without a reference message
+
+typedef struct {
+  uint8_t bits[TINY_NMEA_AIS_MAX_BITS];
+  uint16_t len;
+} bit_writer_t;
+
+static void put_uint(bit_writer_t *w, uint32_t v, uint8_t width) {
+  for (int i = width - 1; i >= 0; i--) {
+    w->bits[w->len++] = (v >> i) & 1;
+  }
+}
+
+static void put_text(bit_writer_t *w, const char *s, uint8_t nchars) {
+  for (uint8_t i = 0; i < nchars; i++) {
+    char c = *s ? *s++ : '@';
+    put_uint(w, (uint8_t)(c >= 64 ? c - 64 : c), 6);
+  }
+}
+
+// armor the written bits, returns the fill bits
+static uint8_t armor(const bit_writer_t *w, char *out) {
+  size_t n = (w->len + 5) / 6;
+  for (size_t i = 0; i < n; i++) {
+    uint8_t v = 0;
+    for (size_t k = 0; k < 6; k++) {
+      size_t bit = i * 6 + k;
+      v = (uint8_t)((v << 1) | (bit < w->len ? w->bits[bit] : 0));
+    }
+    out[i] = (char)(v < 40 ? v + 48 : v + 56);
+  }
+  out[n] = '\0';
+  return (uint8_t)(n * 6 - w->len);
+}
+
+static tiny_nmea_res_t decode_payload(const char *payload, uint8_t fill, tiny_nmea_ais_msg_t *msg) {
+  tiny_nmea_ais_bits_t bits;
+  tiny_nmea_res_t res = tiny_nmea_ais_dearmor(payload, strlen(payload), fill, &bits);
+  if (res != TINY_NMEA_OK) return res;
+  return tiny_nmea_ais_decode_bits(&bits, msg);
+}
+
+// de-armor and bit reader tests
+
+static void test_ais_dearmor(void) {
+  TEST_CASE("dearmor alphabet edges") {
+    tiny_nmea_ais_bits_t bits;
+    // '0' = 0, 'W' = 39, '`' = 40, 'w' = 63
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_dearmor("0W`w", 4, 0, &bits));
+    TEST_ASSERT_EQ(24, bits.bit_len);
+    TEST_ASSERT_EQ(0, tiny_nmea_ais_get_uint(&bits, 0, 6));
+    TEST_ASSERT_EQ(39, tiny_nmea_ais_get_uint(&bits, 6, 6));
+    TEST_ASSERT_EQ(40, tiny_nmea_ais_get_uint(&bits, 12, 6));
+    TEST_ASSERT_EQ(63, tiny_nmea_ais_get_uint(&bits, 18, 6));
+    TEST_PASS();
+  }
+
+  TEST_CASE("dearmor rejects chars outside the alphabet") {
+    tiny_nmea_ais_bits_t bits;
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INVALID_FORMAT, tiny_nmea_ais_dearmor("15X", 3, 0, &bits));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INVALID_FORMAT, tiny_nmea_ais_dearmor("15,0", 4, 0, &bits));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INVALID_FORMAT, tiny_nmea_ais_dearmor("15", 2, 6, &bits));
+    TEST_PASS();
+  }
+
+  TEST_CASE("dearmor fill bits are dropped and zeroed") {
+    tiny_nmea_ais_bits_t bits;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_dearmor("ww", 2, 4, &bits));
+    TEST_ASSERT_EQ(8, bits.bit_len);
+    TEST_ASSERT_EQ(0xFF, tiny_nmea_ais_get_uint(&bits, 0, 8));
+    // past the end reads as zero
+    TEST_ASSERT_EQ(0, tiny_nmea_ais_get_uint(&bits, 8, 32));
+    TEST_PASS();
+  }
+
+  TEST_CASE("dearmor overlong payload") {
+    char payload[TINY_NMEA_AIS_MAX_CHARS + 2];
+    memset(payload, '1', sizeof(payload));
+    tiny_nmea_ais_bits_t bits;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_dearmor(payload, TINY_NMEA_AIS_MAX_CHARS, 0, &bits));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_OVERFLOW, tiny_nmea_ais_dearmor(payload, sizeof(payload), 0, &bits));
+    TEST_PASS();
+  }
+
+  TEST_CASE("bit reader signed and text fields") {
+    bit_writer_t w = {0};
+    put_uint(&w, 0x5, 3);
+    put_uint(&w, (uint32_t)-3 & 0xFF, 8);
+    put_uint(&w, 0x3FFFFFFF, 31);
+    put_text(&w, "AB 1 ", 6);
+
+    char payload[64];
+    uint8_t fill = armor(&w, payload);
+    tiny_nmea_ais_bits_t bits;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_dearmor(payload, strlen(payload), fill, &bits));
+
+    TEST_ASSERT_EQ(5, tiny_nmea_ais_get_uint(&bits, 0, 3));
+    TEST_ASSERT_EQ(-3, tiny_nmea_ais_get_int(&bits, 3, 8));
+    TEST_ASSERT_EQ(0x3FFFFFFF, tiny_nmea_ais_get_int(&bits, 11, 31));
+    TEST_ASSERT_EQ(-1, tiny_nmea_ais_get_int(&bits, 3, 2));
+
+    // trailing space stripped, '@' padding ends the string
+    char text[8];
+    TEST_ASSERT_EQ(4, tiny_nmea_ais_get_text(&bits, 42, 6, text, sizeof(text)));
+    TEST_ASSERT_STR_EQ("AB 1", text);
+
+    // truncated to the output size
+    TEST_ASSERT_EQ(2, tiny_nmea_ais_get_text(&bits, 42, 6, text, 3));
+    TEST_ASSERT_STR_EQ("AB", text);
+    TEST_PASS();
+  }
+}
+
+// message tests, reference values from the published AIVDM examples
+
+static void test_ais_position_report(void) {
+  TEST_CASE("type 1 position report") {
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload("15RTgt0PAso;90TKcjM8h6g208CQ", 0, &msg));
+    TEST_ASSERT_EQ(1, msg.type);
+    TEST_ASSERT_EQ(0, msg.repeat);
+    TEST_ASSERT_EQ(371798000, msg.mmsi);
+
+    const tiny_nmea_ais_pos_report_t *pos = &msg.data.pos;
+    TEST_ASSERT_EQ(0, pos->nav_status);
+    TEST_ASSERT_EQ(-127, pos->rot);
+    TEST_ASSERT_EQ(123, pos->sog);
+    TEST_ASSERT(pos->accuracy);
+    TEST_ASSERT_FLOAT_EQ(-123.395383, tiny_nmea_ais_to_degrees(pos->lon), 0.000001);
+    TEST_ASSERT_FLOAT_EQ(48.381633, tiny_nmea_ais_to_degrees(pos->lat), 0.000001);
+    TEST_ASSERT_EQ(2240, pos->cog);
+    TEST_ASSERT_EQ(215, pos->heading);
+    TEST_ASSERT_EQ(33, pos->second);
+    TEST_ASSERT(!pos->raim);
+    TEST_ASSERT_EQ(34017, pos->radio);
+    TEST_PASS();
+  }
+
+  TEST_CASE("type 1 too short") {
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TOO_FEW_FIELDS, decode_payload("15RTgt0PAso;90TKcjM8h6g2", 0, &msg));
+    // header is still decoded
+    TEST_ASSERT_EQ(371798000, msg.mmsi);
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TOO_FEW_FIELDS, decode_payload("15RT", 0, &msg));
+    TEST_PASS();
+  }
+
+  TEST_CASE("type 18 class B position report") {
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload("B5NJ;PP005l4ot5Isbl03wsUkP06", 0, &msg));
+    TEST_ASSERT_EQ(18, msg.type);
+    TEST_ASSERT_EQ(367430530, msg.mmsi);
+
+    const tiny_nmea_ais_class_b_pos_t *b = &msg.data.class_b;
+    TEST_ASSERT_EQ(0, b->sog);
+    TEST_ASSERT_FLOAT_EQ(-122.267320, tiny_nmea_ais_to_degrees(b->lon), 0.000001);
+    TEST_ASSERT_FLOAT_EQ(37.785035, tiny_nmea_ais_to_degrees(b->lat), 0.000001);
+    TEST_ASSERT_EQ(TINY_NMEA_AIS_HEADING_NA, b->heading);
+    TEST_ASSERT_EQ(55, b->second);
+    TEST_ASSERT(b->cs_unit);
+    TEST_PASS();
+  }
+
+  TEST_CASE("type 19 extended class B report") {
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK,
+                   decode_payload("C5N3SRgPEnJGEBT>NhWAwwo862PaLELTBJ:V00000000S0D:R220", 0, &msg));
+    TEST_ASSERT_EQ(19, msg.type);
+    TEST_ASSERT_EQ(367059850, msg.mmsi);
+
+    const tiny_nmea_ais_class_b_ext_t *b = &msg.data.class_b_ext;
+    TEST_ASSERT_STR_EQ("CAPT.J.RIMES", b->shipname);
+    TEST_ASSERT_EQ(70, b->ship_type);
+    TEST_ASSERT_FLOAT_EQ(-88.810392, tiny_nmea_ais_to_degrees(b->lon), 0.000001);
+    TEST_ASSERT_FLOAT_EQ(29.543695, tiny_nmea_ais_to_degrees(b->lat), 0.000001);
+    TEST_PASS();
+  }
+}
+
+static void test_ais_static_data(void) {
+  TEST_CASE("type 5 from two joined fragments") {
+    const char *frag1 = "55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8";
+    const char *frag2 = "88888888880";
+    char payload[TINY_NMEA_AIS_MAX_CHARS + 1];
+    strcpy(payload, frag1);
+    strcat(payload, frag2);
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload(payload, 2, &msg));
+    TEST_ASSERT_EQ(5, msg.type);
+    TEST_ASSERT_EQ(351759000, msg.mmsi);
+
+    const tiny_nmea_ais_static_voyage_t *v = &msg.data.voyage;
+    TEST_ASSERT_EQ(9134270, v->imo);
+    TEST_ASSERT_STR_EQ("3FOF8", v->callsign);
+    TEST_ASSERT_STR_EQ("EVER DIADEM", v->shipname);
+    TEST_ASSERT_EQ(70, v->ship_type);
+    TEST_ASSERT_EQ(225, v->dims.to_bow);
+    TEST_ASSERT_EQ(70, v->dims.to_stern);
+    TEST_ASSERT_EQ(1, v->dims.to_port);
+    TEST_ASSERT_EQ(31, v->dims.to_starboard);
+    TEST_ASSERT_EQ(5, v->eta_month);
+    TEST_ASSERT_EQ(15, v->eta_day);
+    TEST_ASSERT_EQ(14, v->eta_hour);
+    TEST_ASSERT_EQ(0, v->eta_minute);
+    TEST_ASSERT_EQ(122, v->draught);
+    TEST_ASSERT_STR_EQ("NEW YORK", v->destination);
+    TEST_PASS();
+  }
+
+  TEST_CASE("type 21 aid to navigation with name extension") {
+    bit_writer_t w = {0};
+    put_uint(&w, 21, 6);
+    put_uint(&w, 0, 2);
+    put_uint(&w, 992271234, 30);
+    put_uint(&w, 14, 5);
+    put_text(&w, "NORTH BREAKWATER LIG", 20);
+    put_uint(&w, 1, 1);
+    put_uint(&w, (uint32_t)(-600000) & 0xFFFFFFF, 28);
+    put_uint(&w, 30000000, 27);
+    put_uint(&w, 5, 9);
+    put_uint(&w, 6, 9);
+    put_uint(&w, 2, 6);
+    put_uint(&w, 3, 6);
+    put_uint(&w, 7, 4);
+    put_uint(&w, 61, 6);
+    put_uint(&w, 1, 1);    // off position
+    put_uint(&w, 0, 8);
+    put_uint(&w, 0, 1);
+    put_uint(&w, 1, 1);    // virtual
+    put_uint(&w, 0, 1);
+    put_uint(&w, 0, 1);
+    put_text(&w, "HT", 2);
+
+    char payload[TINY_NMEA_AIS_MAX_CHARS + 1];
+    uint8_t fill = armor(&w, payload);
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload(payload, fill, &msg));
+    TEST_ASSERT_EQ(21, msg.type);
+    TEST_ASSERT_EQ(992271234, msg.mmsi);
+
+    const tiny_nmea_ais_aton_t *a = &msg.data.aton;
+    TEST_ASSERT_EQ(14, a->aid_type);
+    TEST_ASSERT_STR_EQ("NORTH BREAKWATER LIGHT", a->name);
+    TEST_ASSERT(a->accuracy);
+    TEST_ASSERT_EQ(-600000, a->lon);
+    TEST_ASSERT_EQ(30000000, a->lat);
+    TEST_ASSERT_EQ(5, a->dims.to_bow);
+    TEST_ASSERT_EQ(3, a->dims.to_starboard);
+    TEST_ASSERT_EQ(7, a->epfd);
+    TEST_ASSERT_EQ(61, a->second);
+    TEST_ASSERT(a->off_position);
+    TEST_ASSERT(a->virtual_aid);
+    TEST_ASSERT(!a->assigned);
+    TEST_PASS();
+  }
+
+  TEST_CASE("type 24 part A and part B") {
+    bit_writer_t w = {0};
+    put_uint(&w, 24, 6);
+    put_uint(&w, 0, 2);
+    put_uint(&w, 338091445, 30);
+    put_uint(&w, 0, 2);
+    put_text(&w, "SEA DREAMER", 20);
+
+    char payload[TINY_NMEA_AIS_MAX_CHARS + 1];
+    uint8_t fill = armor(&w, payload);
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload(payload, fill, &msg));
+    TEST_ASSERT_EQ(24, msg.type);
+    TEST_ASSERT_EQ(0, msg.data.static_data.part_num);
+    TEST_ASSERT_STR_EQ("SEA DREAMER", msg.data.static_data.shipname);
+
+    memset(&w, 0, sizeof(w));
+    put_uint(&w, 24, 6);
+    put_uint(&w, 0, 2);
+    put_uint(&w, 338091445, 30);
+    put_uint(&w, 1, 2);
+    put_uint(&w, 37, 8);
+    put_text(&w, "FEC", 3);
+    put_uint(&w, 2, 4);
+    put_uint(&w, 123456, 20);
+    put_text(&w, "WDE4321", 7);
+    put_uint(&w, 10, 9);
+    put_uint(&w, 4, 9);
+    put_uint(&w, 2, 6);
+    put_uint(&w, 2, 6);
+    put_uint(&w, 0, 6);
+    fill = armor(&w, payload);
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload(payload, fill, &msg));
+    const tiny_nmea_ais_static_data_t *sd = &msg.data.static_data;
+    TEST_ASSERT_EQ(1, sd->part_num);
+    TEST_ASSERT_EQ(37, sd->ship_type);
+    TEST_ASSERT_STR_EQ("FEC", sd->vendor_id);
+    TEST_ASSERT_EQ(2, sd->model);
+    TEST_ASSERT_EQ(123456, sd->serial);
+    TEST_ASSERT_STR_EQ("WDE4321", sd->callsign);
+    TEST_ASSERT_EQ(10, sd->dims.to_bow);
+    TEST_ASSERT_EQ(4, sd->dims.to_stern);
+    TEST_ASSERT_EQ(0, sd->mothership_mmsi);
+    TEST_PASS();
+  }
+
+  TEST_CASE("type 24 part B auxiliary craft") {
+    bit_writer_t w = {0};
+    put_uint(&w, 24, 6);
+    put_uint(&w, 0, 2);
+    put_uint(&w, 983191234, 30);
+    put_uint(&w, 1, 2);
+    put_uint(&w, 0, 8);
+    put_text(&w, "", 3);
+    put_uint(&w, 0, 24);
+    put_text(&w, "", 7);
+    put_uint(&w, 316001234, 30);
+    put_uint(&w, 0, 6);
+
+    char payload[TINY_NMEA_AIS_MAX_CHARS + 1];
+    uint8_t fill = armor(&w, payload);
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, decode_payload(payload, fill, &msg));
+    TEST_ASSERT_EQ(316001234, msg.data.static_data.mothership_mmsi);
+    TEST_ASSERT_EQ(0, msg.data.static_data.dims.to_bow);
+    TEST_PASS();
+  }
+}
+
+// decoding straight from a parsed sentence
+
+// sentence level decoding, compiled out with the AIS sentences
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
+static void test_ais_decode_sentence(void) {
+  TEST_CASE("decode from a VDM sentence") {
+    const char *fields = "1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0";
+    tiny_nmea_ais_t ais;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, handle_parse_ais(fields, strlen(fields), &ais));
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_decode(&ais, &msg));
+    TEST_ASSERT_EQ(371798000, msg.mmsi);
+    TEST_PASS();
+  }
+
+  TEST_CASE("decode rejects a single fragment of many") {
+    const char *fields = "2,1,1,A,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0";
+    tiny_nmea_ais_t ais;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, handle_parse_ais(fields, strlen(fields), &ais));
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_decode(&ais, &msg));
+    TEST_PASS();
+  }
+
+  TEST_CASE("decode unsupported type") {
+    // type 4 base station report
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_UNSUPPORTED, decode_payload("403OviQuMGCqWrRO9>E6fE700@GO", 0, &msg));
+    TEST_ASSERT_EQ(4, msg.type);
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_NULL_PTR, tiny_nmea_ais_decode(NULL, &msg));
+    TEST_PASS();
+  }
+}
+
+static tiny_nmea_type_t make_vdm(const char *fields) {
+  tiny_nmea_type_t sentence;
+  memset(&sentence, 0, sizeof(sentence));
+  sentence.type = TINY_NMEA_SENTENCE_VDM;
+  sentence.talker = TINY_NMEA_TALKER_AI;
+  handle_parse_ais(fields, strlen(fields), &sentence.data.ais);
+  return sentence;
+}
+
+static void test_ais_reassembly(void) {
+  const char *frag1 = "55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8";
+  const char *frag2 = "88888888880";
+
+  TEST_CASE("reassembly in order") {
+    tiny_nmea_ais_reasm_t r;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_init(&r, 0));
+    TEST_ASSERT_EQ(TINY_NMEA_AIS_REASM_TIMEOUT_MS, r.timeout_ms);
+
+    tiny_nmea_ais_payload_t out;
+    tiny_nmea_type_t s1 = make_vdm("2,1,3,B,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0");
+    tiny_nmea_type_t s2 = make_vdm("2,2,3,B,88888888880,2");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s1, 100, &out));
+    TEST_ASSERT_EQ(1, r.active);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &s2, 150, &out));
+    TEST_ASSERT_EQ(0, r.active);
+    TEST_ASSERT_EQ(1, r.stats.completed);
+
+    TEST_ASSERT_EQ(TINY_NMEA_TALKER_AI, out.talker);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_VDM, out.type);
+    TEST_ASSERT_EQ('B', out.channel);
+    TEST_ASSERT_EQ(2, out.fill_bits);
+    TEST_ASSERT_EQ(strlen(frag1) + strlen(frag2), out.len);
+    TEST_ASSERT_EQ(0, strncmp(out.payload, frag1, strlen(frag1)));
+    TEST_ASSERT_STR_EQ(frag2, &out.payload[strlen(frag1)]);
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_decode_payload(&out, &msg));
+    TEST_ASSERT_EQ(5, msg.type);
+    TEST_ASSERT_STR_EQ("EVER DIADEM", msg.data.voyage.shipname);
+    TEST_PASS();
+  }
+
+  TEST_CASE("reassembly out of order") {
+    tiny_nmea_ais_reasm_t r;
+    tiny_nmea_ais_reasm_init(&r, 0);
+
+    tiny_nmea_ais_payload_t out;
+    tiny_nmea_type_t s1 = make_vdm("2,1,3,B,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8,0");
+    tiny_nmea_type_t s2 = make_vdm("2,2,3,B,88888888880,2");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s2, 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &s1, 10, &out));
+    TEST_ASSERT_EQ(2, out.fill_bits);
+    TEST_ASSERT_EQ(0, strncmp(out.payload, frag1, strlen(frag1)));
+    TEST_ASSERT_STR_EQ(frag2, &out.payload[strlen(frag1)]);
+    TEST_PASS();
+  }
+
+  TEST_CASE("reassembly single fragment passes through") {
+    tiny_nmea_ais_reasm_t r;
+    tiny_nmea_ais_reasm_init(&r, 0);
+
+    tiny_nmea_ais_payload_t out;
+    tiny_nmea_type_t s = make_vdm("1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0");
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &s, 0, &out));
+    TEST_ASSERT_STR_EQ("15RTgt0PAso;90TKcjM8h6g208CQ", out.payload);
+    TEST_ASSERT_EQ(0, r.active);
+
+    tiny_nmea_ais_msg_t msg;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_decode_payload(&out, &msg));
+    TEST_ASSERT_EQ(371798000, msg.mmsi);
+    TEST_PASS();
+  }
+
+  TEST_CASE("reassembly keeps interleaved keys apart") {
+    tiny_nmea_ais_reasm_t r;
+    tiny_nmea_ais_reasm_init(&r, 0);
+
+    tiny_nmea_ais_payload_t out;
+    tiny_nmea_type_t a1 = make_vdm("2,1,1,A,AAAA,0");
+    tiny_nmea_type_t b1 = make_vdm("2,1,1,B,BBBB,0");
+    tiny_nmea_type_t c1 = make_vdm("2,1,2,A,CCCC,0");
+    tiny_nmea_type_t d1 = make_vdm("2,1,1,A,DDDD,0");
+    d1.type = TINY_NMEA_SENTENCE_VDO;
+    tiny_nmea_type_t a2 = make_vdm("2,2,1,A,aa,1");
+    tiny_nmea_type_t b2 = make_vdm("2,2,1,B,bb,2");
+    tiny_nmea_type_t c2 = make_vdm("2,2,2,A,cc,3");
+    tiny_nmea_type_t d2 = make_vdm("2,2,1,A,dd,4");
+    d2.type = TINY_NMEA_SENTENCE_VDO;
+
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &a1, 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &b1, 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &c1, 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &d1, 0, &out));
+    TEST_ASSERT_EQ(4, r.active);
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &c2, 1, &out));
+    TEST_ASSERT_STR_EQ("CCCCcc", out.payload);
+    TEST_ASSERT_EQ(3, out.fill_bits);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &a2, 1, &out));
+    TEST_ASSERT_STR_EQ("AAAAaa", out.payload);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &d2, 1, &out));
+    TEST_ASSERT_STR_EQ("DDDDdd", out.payload);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_VDO, out.type);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &b2, 1, &out));
+    TEST_ASSERT_STR_EQ("BBBBbb", out.payload);
+    TEST_ASSERT_EQ('B', out.channel);
+    TEST_ASSERT_EQ(0, r.active);
+    TEST_ASSERT_EQ(4, r.stats.completed);
+    TEST_PASS();
+  }
+
+  TEST_CASE("reassembly timeout") {
+    tiny_nmea_ais_reasm_t r;
+    tiny_nmea_ais_reasm_init(&r, 1000);
+
+    tiny_nmea_ais_payload_t out;
+    tiny_nmea_type_t s1 = make_vdm("2,1,5,A,AAAA,0");
+    tiny_nmea_type_t s2 = make_vdm("2,2,5,A,aa,0");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s1, 0, &out));
+    TEST_ASSERT_EQ(0, tiny_nmea_ais_reasm_expire(&r, 999));
+    TEST_ASSERT_EQ(1, tiny_nmea_ais_reasm_expire(&r, 1000));
+    TEST_ASSERT_EQ(1, r.stats.timed_out);
+    TEST_ASSERT_EQ(0, r.active);
+
+    // a late second half starts a new message instead of completing the old one
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s2, 1500, &out));
+
+    // expired on the next add too, across the clock wrapping around
+    tiny_nmea_ais_reasm_init(&r, 1000);
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s1, UINT32_MAX - 100, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s2, 1000, &out));
+    TEST_ASSERT_EQ(1, r.stats.timed_out);
+    TEST_ASSERT_EQ(0, r.stats.completed);
+    TEST_PASS();
+  }
+
+  TEST_CASE("reassembly evicts the oldest when full") {
+    tiny_nmea_ais_reasm_t r;
+    tiny_nmea_ais_reasm_init(&r, 0);
+
+    tiny_nmea_ais_payload_t out;
+    char fields[32];
+    for (uint8_t i = 0; i < TINY_NMEA_AIS_REASM_SLOTS; i++) {
+      snprintf(fields, sizeof(fields), "2,1,%u,%c,AAAA,0", i % 10, i < 10 ? 'A' : 'B');
+      tiny_nmea_type_t s = make_vdm(fields);
+      TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s, i, &out));
+    }
+    TEST_ASSERT_EQ(TINY_NMEA_AIS_REASM_SLOTS, r.active);
+
+    // first one in gets dropped
+    tiny_nmea_type_t extra = make_vdm("2,1,9,2,EEEE,0");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &extra, 100, &out));
+    TEST_ASSERT_EQ(1, r.stats.evicted);
+    TEST_ASSERT_EQ(TINY_NMEA_AIS_REASM_SLOTS, r.active);
+
+    tiny_nmea_type_t lost = make_vdm("2,2,0,A,aa,0");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &lost, 101, &out));
+    TEST_ASSERT_EQ(2, r.stats.evicted);
+
+    // the rest are still there and findable after the shifts
+    for (uint8_t i = 2; i < TINY_NMEA_AIS_REASM_SLOTS; i++) {
+      snprintf(fields, sizeof(fields), "2,2,%u,%c,aa,0", i % 10, i < 10 ? 'A' : 'B');
+      tiny_nmea_type_t s = make_vdm(fields);
+      TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &s, 102, &out));
+      TEST_ASSERT_STR_EQ("AAAAaa", out.payload);
+    }
+    tiny_nmea_type_t extra2 = make_vdm("2,2,9,2,ee,0");
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &extra2, 103, &out));
+    TEST_ASSERT_STR_EQ("EEEEee", out.payload);
+    TEST_ASSERT_EQ(1, r.active);
+    TEST_PASS();
+  }
+
+  TEST_CASE("reassembly drops bad fragments") {
+    tiny_nmea_ais_reasm_t r;
+    tiny_nmea_ais_reasm_init(&r, 0);
+
+    tiny_nmea_ais_payload_t out;
+    tiny_nmea_type_t bad = make_vdm("2,3,1,A,AAAA,0");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INVALID_FORMAT, tiny_nmea_ais_reasm_add(&r, &bad, 0, &out));
+    TEST_ASSERT_EQ(1, r.stats.dropped);
+
+    // a repeated first fragment restarts the message
+    tiny_nmea_type_t s1 = make_vdm("2,1,1,A,AAAA,0");
+    tiny_nmea_type_t s1b = make_vdm("2,1,1,A,XXXX,0");
+    tiny_nmea_type_t s2 = make_vdm("2,2,1,A,aa,0");
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s1, 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &s1b, 0, &out));
+    TEST_ASSERT_EQ(2, r.stats.dropped);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_ais_reasm_add(&r, &s2, 0, &out));
+    TEST_ASSERT_STR_EQ("XXXXaa", out.payload);
+
+    // joined payload longer than the longest message
+    char fields[80];
+    tiny_nmea_type_t parts[4];
+    for (uint8_t i = 0; i < 4; i++) {
+      snprintf(fields, sizeof(fields), "4,%u,2,A,%s,0", i + 1,
+               "000000000000000000000000000000000000000000000000000000000000");
+      parts[i] = make_vdm(fields);
+    }
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &parts[0], 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INCOMPLETE, tiny_nmea_ais_reasm_add(&r, &parts[1], 0, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_OVERFLOW, tiny_nmea_ais_reasm_add(&r, &parts[2], 0, &out));
+    TEST_ASSERT_EQ(0, r.active);
+
+    tiny_nmea_type_t gga;
+    memset(&gga, 0, sizeof(gga));
+    gga.type = TINY_NMEA_SENTENCE_GGA;
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_ais_reasm_add(&r, &gga, 0, &out));
+    TEST_PASS();
+  }
+}
+#endif
+
+int main(void) {
+  TEST_TITLE("ais decoding tests");
+
+  test_ais_dearmor();
+  test_ais_position_report();
+  test_ais_static_data();
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
+  test_ais_decode_sentence();
+  test_ais_reassembly();
+#endif
+
+  TEST_SUMMARY();
+}
@@ -45,6 +45,7 @@ static void on_error(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics
 // bit flip corruption tests
 
 static void test_corrupt_bit_flip_in_data(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt bit flip in data field") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -64,9 +65,11 @@ static void test_corrupt_bit_flip_in_data(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_corrupt_bit_flip_in_checksum(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt bit flip in checksum") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -83,11 +86,13 @@ static void test_corrupt_bit_flip_in_checksum(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // byte drop tests
 
 static void test_corrupt_dropped_start_char(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("corrupt dropped start character") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -106,6 +111,7 @@ static void test_corrupt_dropped_start_char(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_corrupt_dropped_comma(void) {
@@ -127,6 +133,7 @@ static void test_corrupt_dropped_comma(void) {
 }
 
 static void test_corrupt_dropped_crlf(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt dropped line ending") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -146,11 +153,13 @@ static void test_corrupt_dropped_crlf(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // byte insertion tests
 
 static void test_corrupt_extra_bytes(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt extra bytes inserted") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -168,9 +177,11 @@ static void test_corrupt_extra_bytes(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_corrupt_duplicate_start(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt duplicate start character") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -186,11 +197,13 @@ static void test_corrupt_duplicate_start(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // null byte tests
 
 static void test_corrupt_null_byte_in_data(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt null byte in data") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -212,11 +225,13 @@ static void test_corrupt_null_byte_in_data(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // high byte corruption tests
 
 static void test_corrupt_high_bytes(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt high bytes (0x80-0xFF)") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -244,11 +259,13 @@ static void test_corrupt_high_bytes(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // line noise simulation
 
 static void test_corrupt_line_noise_burst(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt line noise burst") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -278,11 +295,13 @@ static void test_corrupt_line_noise_burst(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // truncated sentence tests
 
 static void test_corrupt_truncated_midfield(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt truncated mid-field") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -302,9 +321,11 @@ static void test_corrupt_truncated_midfield(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_corrupt_truncated_checksum(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt truncated checksum") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -328,11 +349,13 @@ static void test_corrupt_truncated_checksum(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // buffer overflow attack simulation
 
 static void test_corrupt_overlong_field(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt overlong field") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -357,9 +380,11 @@ static void test_corrupt_overlong_field(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_corrupt_many_fields(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt many fields") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -380,11 +405,13 @@ static void test_corrupt_many_fields(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // rapid corruption recovery
 
 static void test_corrupt_recovery_rapid(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt rapid recovery") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -411,11 +438,13 @@ static void test_corrupt_recovery_rapid(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // uart framing error simulation
 
 static void test_corrupt_uart_framing_error(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt uart framing error pattern") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -446,11 +475,13 @@ static void test_corrupt_uart_framing_error(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // incremental corruption stress test
 
 static void test_corrupt_incremental_stress(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("corrupt incremental stress test") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -481,6 +512,7 @@ static void test_corrupt_incremental_stress(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 int main(void) {
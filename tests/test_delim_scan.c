@@ -0,0 +1,110 @@
+//
+// unit tests for the delimiter scanner
+//
+
+#include "test.h"
+#include "tiny_nmea/internal/delim_scan.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+// reference mask, one byte at a time
+static uint64_t naive_mask(const uint8_t *p, size_t len) {
+  uint64_t mask = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = p[i];
+    if (c == '$' || c == '!' || c == '*' || c == '\r' || c == '\n') {
+      mask |= (uint64_t)1 << i;
+    }
+  }
+  return mask;
+}
+
+static void test_delim_class(void) {
+  TEST_CASE("delim class table") {
+    TEST_ASSERT_EQ(DELIM_START, delim_class('$'));
+    TEST_ASSERT_EQ(DELIM_START, delim_class('!'));
+    TEST_ASSERT_EQ(DELIM_STAR, delim_class('*'));
+    TEST_ASSERT_EQ(DELIM_EOL, delim_class('\r'));
+    TEST_ASSERT_EQ(DELIM_EOL, delim_class('\n'));
+    TEST_ASSERT_EQ(0, delim_class(','));
+    TEST_ASSERT_EQ(0, delim_class(0x00));
+    TEST_ASSERT_EQ(0, delim_class(0xAA));  // '*' | 0x80
+    TEST_ASSERT_EQ(0, delim_class(0xA4));  // '$' | 0x80
+    TEST_PASS();
+  }
+}
+
+static void test_delim_scan_sentence(void) {
+  TEST_CASE("delim scan sentence") {
+    const char *s = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+    size_t len = strlen(s);
+
+    // first block holds '$' and '*', the line end spills into the next
+    uint64_t mask = delim_scan_block((const uint8_t *)s, DELIM_BLOCK_LEN);
+    TEST_ASSERT_EQ_U(((uint64_t)1 << 0) | ((uint64_t)1 << 62), mask);
+    mask = delim_scan_block((const uint8_t *)s + DELIM_BLOCK_LEN, len - DELIM_BLOCK_LEN);
+    TEST_ASSERT_EQ_U(0x6, mask);
+
+    TEST_ASSERT_EQ(0, delim_find((const uint8_t *)s, len, DELIM_START));
+    TEST_ASSERT_EQ(62, delim_find((const uint8_t *)s, len, DELIM_STAR | DELIM_EOL));
+    TEST_ASSERT_EQ(65, delim_find((const uint8_t *)s, len, DELIM_EOL));
+    TEST_ASSERT_EQ_U(DELIM_NPOS, delim_find((const uint8_t *)s + 1, len - 1, DELIM_START));
+
+    TEST_PASS();
+  }
+}
+
+static void test_delim_scan_random(void) {
+  TEST_CASE("delim scan kernels match reference") {
+    // biased random bytes so every block has some delimiters
+    // and every length/alignment is covered
+    static const uint8_t alphabet[] = {'$', '!', '*', '\r', '\n', ',', 'A', '0', 0x00, 0xFF, 0x8A, 0xA4};
+    uint8_t buf[DELIM_BLOCK_LEN + 16];
+    srand(1234);
+
+    for (int round = 0; round < 2000; round++) {
+      for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = (rand() % 4 == 0) ? alphabet[rand() % sizeof(alphabet)] : (uint8_t)rand();
+      }
+      size_t off = (size_t)(rand() % 16);
+      size_t len = (size_t)(rand() % (DELIM_BLOCK_LEN + 1));
+
+      uint64_t expected = naive_mask(buf + off, len);
+      TEST_ASSERT_EQ_U(expected, delim_scan_block(buf + off, len));
+      TEST_ASSERT_EQ_U(expected, delim_scan_block_portable(buf + off, len));
+    }
+
+    TEST_PASS();
+  }
+}
+
+static void test_delim_find_long(void) {
+  TEST_CASE("delim find across blocks") {
+    uint8_t buf[300];
+    memset(buf, 'x', sizeof(buf));
+    buf[70] = '*';
+    buf[150] = '\n';
+    buf[299] = '!';
+
+    TEST_ASSERT_EQ(70, delim_find(buf, sizeof(buf), DELIM_STAR | DELIM_EOL));
+    TEST_ASSERT_EQ(150, delim_find(buf, sizeof(buf), DELIM_EOL));
+    TEST_ASSERT_EQ(299, delim_find(buf, sizeof(buf), DELIM_START));
+    TEST_ASSERT_EQ_U(DELIM_NPOS, delim_find(buf, 299, DELIM_START));
+    TEST_ASSERT_EQ_U(DELIM_NPOS, delim_find(buf, 0, DELIM_START));
+
+    TEST_PASS();
+  }
+}
+
+int main(void) {
+  TEST_TITLE("delimiter scan tests");
+  printf("  kernel: %s\n", delim_scan_kernel_name());
+
+  test_delim_class();
+  test_delim_scan_sentence();
+  test_delim_scan_random();
+  test_delim_find_long();
+
+  TEST_SUMMARY();
+}
@@ -6,7 +6,10 @@
 #include "tiny_nmea/internal/parse_sentence_fields.h"
 #include "tiny_nmea/internal/data_formats.h"
 #include "tiny_nmea/internal/fixed_point.h"
+#include "tiny_nmea/internal/nmea_0183_types.h"
+#include "tiny_nmea/internal/swar_digits.h"
 
+#include <stdio.h>
 #include <string.h>
 #include <math.h>
 
@@ -168,6 +171,207 @@ static void test_parse_uint(void) {
   }
 }
 
+// SWAR digit kernel tests
+
+// byte at a time reference for parse_uint
+static bool ref_parse_uint(const char *p, size_t n, uint32_t *out) {
+  uint64_t val = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (!IS_DIGIT(p[i])) return false;
+    val = val * 10 + (uint64_t)(p[i] - '0');
+    if (val > UINT32_MAX) return false;
+  }
+  *out = (uint32_t)val;
+  return true;
+}
+
+static void test_swar_digits(void) {
+  TEST_CASE("swar digits values") {
+    uint32_t v = 0;
+    TEST_ASSERT(swar_parse_digits8("7", 1, &v));
+    TEST_ASSERT_EQ(7u, v);
+    TEST_ASSERT(swar_parse_digits8("12345678", 8, &v));
+    TEST_ASSERT_EQ(12345678u, v);
+    TEST_ASSERT(swar_parse_digits8("00000042", 8, &v));
+    TEST_ASSERT_EQ(42u, v);
+    TEST_ASSERT(swar_parse_digits8("99999", 5, &v));
+    TEST_ASSERT_EQ(99999u, v);
+    TEST_ASSERT(swar_parse_u32("4294967295", 10, &v));
+    TEST_ASSERT_EQ(4294967295u, v);
+    TEST_ASSERT(!swar_parse_u32("4294967296", 10, &v));
+    TEST_ASSERT(swar_parse_u32("0000000000000123", 16, &v));
+    TEST_ASSERT_EQ(123u, v);
+    TEST_PASS();
+  }
+
+  TEST_CASE("swar digits reject every non digit byte") {
+    char buf[8];
+    uint32_t v;
+    for (int c = 0; c < 256; c++) {
+      bool digit = c >= '0' && c <= '9';
+      for (size_t pos = 0; pos < 8; pos++) {
+        memset(buf, '5', sizeof(buf));
+        buf[pos] = (char)c;
+        TEST_ASSERT_EQ(digit, swar_parse_digits8(buf, 8, &v));
+        TEST_ASSERT_EQ(digit ? 8u : pos, swar_digit_span(buf, 8));
+      }
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("swar digits only look at n bytes") {
+    uint32_t v = 0;
+    TEST_ASSERT(swar_parse_digits8("123,4567", 3, &v));
+    TEST_ASSERT_EQ(123u, v);
+    TEST_ASSERT_EQ(3u, swar_digit_span("123,4567", 8));
+    TEST_ASSERT_EQ(2u, swar_digit_span("123", 2));
+    TEST_ASSERT_EQ(0u, swar_digit_span("", 0));
+    TEST_PASS();
+  }
+
+  TEST_CASE("parse_uint matches byte at a time reference") {
+    // xorshift so the run is repeatable
+    uint32_t state = 0x2545F491u;
+    char buf[17];
+    for (int iter = 0; iter < 20000; iter++) {
+      state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+      size_t n = 1 + state % 16;
+      for (size_t i = 0; i < n; i++) {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        // mostly digits, sometimes a separator or a high byte
+        buf[i] = (state & 63) == 0 ? (char)(state >> 8) : (char)('0' + (state >> 8) % 10);
+      }
+      buf[n] = '\0';
+
+      field_t f = {.ptr = buf, .len = (uint8_t)n};
+      uint32_t got = 0, want = 0;
+      bool ok = parse_uint(&f, &got);
+      TEST_ASSERT_EQ(ref_parse_uint(buf, n, &want), ok);
+      if (ok) TEST_ASSERT_EQ(want, got);
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("fixedpoint fast path matches reference") {
+    uint32_t state = 0x9E3779B9u;
+    const char alphabet[] = "0123456789012345678901234567890123456789..-+x";
+    char buf[20];
+    for (int iter = 0; iter < 20000; iter++) {
+      state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+      size_t n = 1 + state % 12;
+      for (size_t i = 0; i < n; i++) {
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        // sign only up front most of the time
+        buf[i] = alphabet[(state >> 8) % (i == 0 ? sizeof(alphabet) - 1 : sizeof(alphabet) - 4)];
+      }
+      buf[n] = '\0';
+
+      // reference: sign, integer digits, optional '.', fraction digits
+      const char *p = buf;
+      bool neg = *p == '-';
+      if (*p == '-' || *p == '+') p++;
+      uint64_t mant = 0;
+      size_t digits = 0, frac = 0, dots = 0;
+      bool bad = false;
+      for (; *p; p++) {
+        if (*p == '.') { dots++; continue; }
+        if (!IS_DIGIT(*p)) { bad = true; break; }
+        mant = mant * 10 + (uint64_t)(*p - '0');
+        digits++;
+        if (dots) frac++;
+      }
+      if (!dots) frac = digits;
+      bool want_ok = !bad && dots <= 1 && digits > 0 && frac <= 9 && mant <= INT32_MAX;
+
+      tiny_nmea_float_t got;
+      field_t f = {.ptr = buf, .len = (uint8_t)n};
+      TEST_ASSERT_EQ(want_ok, parse_fixedpoint_float(&f, &got));
+      if (want_ok) {
+        TEST_ASSERT_EQ(neg ? -(int32_t)mant : (int32_t)mant, got.value);
+        TEST_ASSERT_EQ(tiny_nmea_pow10[frac], got.scale);
+      }
+
+      // the single pass scanner with the rest of a sentence behind the field
+      char line[40];
+      snprintf(line, sizeof(line), "%s,1.5,N*00", buf);
+      scan_cursor_t c = {.pos = line, .end = line + strlen(line)};
+      tiny_nmea_float_t got2;
+      TEST_ASSERT_EQ(want_ok, scan_fixedpoint_float(&c, &got2));
+      TEST_ASSERT(c.pos == line + n);
+      if (want_ok) {
+        TEST_ASSERT_EQ(got.value, got2.value);
+        TEST_ASSERT_EQ(got.scale, got2.scale);
+      }
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("time kernel range check on every hh mm ss") {
+    // one of the three pairs swept 00-99, the others kept valid
+    char buf[16];
+    for (int which = 0; which < 3; which++) {
+      for (int v = 0; v < 100; v++) {
+        int h = which == 0 ? v : 12, m = which == 1 ? v : 30, sec = which == 2 ? v : 45;
+        snprintf(buf, sizeof(buf), "%02d%02d%02d.50,", h, m, sec);
+        tiny_nmea_time_t t = {0};
+        bool want = h <= 23 && m <= 59 && sec <= 60;
+        TEST_ASSERT_EQ(want, swar_decode_time(buf, strlen(buf), &t) != 0);
+        if (want) {
+          TEST_ASSERT(t.valid);
+          TEST_ASSERT_EQ(h, t.hours);
+          TEST_ASSERT_EQ(m, t.minutes);
+          TEST_ASSERT_EQ(sec, t.seconds);
+          TEST_ASSERT_EQ(500000u, t.microseconds);
+        } else {
+          TEST_ASSERT(!t.valid);
+        }
+      }
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("time kernel fraction digits") {
+    tiny_nmea_time_t t;
+    TEST_ASSERT_EQ(13u, swar_decode_time("123519.123456,", 14, &t));
+    TEST_ASSERT_EQ(123456u, t.microseconds);
+    // digits past the 6th are left for the caller to skip
+    TEST_ASSERT_EQ(13u, swar_decode_time("123519.1234567", 14, &t));
+    TEST_ASSERT_EQ(123456u, t.microseconds);
+    TEST_ASSERT_EQ(8u, swar_decode_time("123519.5", 8, &t));
+    TEST_ASSERT_EQ(500000u, t.microseconds);
+    TEST_ASSERT_EQ(7u, swar_decode_time("123519.,", 8, &t));
+    TEST_ASSERT_EQ(0u, t.microseconds);
+    // the field ends right after the digits, no over-read
+    TEST_ASSERT_EQ(6u, swar_decode_time("123519", 6, &t));
+    TEST_ASSERT_EQ(0u, t.microseconds);
+    TEST_ASSERT_EQ(0u, swar_decode_time("12351", 5, &t));
+    TEST_ASSERT_EQ(0u, swar_decode_time("1235:9", 6, &t));
+    TEST_PASS();
+  }
+
+  TEST_CASE("date kernel range check on every dd mm") {
+    char buf[16];
+    for (int which = 0; which < 2; which++) {
+      for (int v = 0; v < 100; v++) {
+        int d = which == 0 ? v : 15, m = which == 1 ? v : 6;
+        snprintf(buf, sizeof(buf), "%02d%02d94,", d, m);
+        tiny_nmea_date_t date = {0};
+        bool want = d >= 1 && d <= 31 && m >= 1 && m <= 12;
+        TEST_ASSERT_EQ(want, swar_decode_date(buf, 6, &date));
+        if (want) {
+          TEST_ASSERT_EQ(d, date.day);
+          TEST_ASSERT_EQ(m, date.month);
+          TEST_ASSERT_EQ(94, date.year_yy);
+          TEST_ASSERT_EQ(0, date.year);
+        }
+      }
+    }
+    TEST_ASSERT(!swar_decode_date("23039", 5, &(tiny_nmea_date_t){0}));
+    TEST_ASSERT(!swar_decode_date("2303/4", 6, &(tiny_nmea_date_t){0}));
+    TEST_PASS();
+  }
+}
+
 // parse_int tests
 
 static void test_parse_int(void) {
@@ -642,12 +846,391 @@ static void test_conversions(void) {
   }
 }
 
+// fixed-point math tests
+
+static void test_fixed_point_math(void) {
+  TEST_CASE("div_pow10 matches integer divide") {
+    const uint32_t xs[] = {0, 1, 9, 10, 99, 12345, 999999999, 1000000000,
+                           2147483647u, 2147483648u};
+    for (size_t i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+      uint64_t d = 1;
+      for (uint8_t e = 0; e <= 11; e++, d *= 10) {
+        TEST_ASSERT_EQ((uint32_t)(xs[i] / d), tiny_nmea_div_pow10(xs[i], e));
+      }
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("rescale by powers of ten") {
+    tiny_nmea_float_t f = {.value = -123456, .scale = 1000};
+    TEST_ASSERT_EQ(-123456, tiny_nmea_rescale(&f, 1000));
+    TEST_ASSERT_EQ(-12345600, tiny_nmea_rescale(&f, 100000));
+    TEST_ASSERT_EQ(-1234, tiny_nmea_rescale(&f, 10));   // truncates toward zero
+    TEST_ASSERT_EQ(-123, tiny_nmea_rescale(&f, 1));
+
+    f = (tiny_nmea_float_t){.value = INT32_MIN, .scale = 1000000000};
+    TEST_ASSERT_EQ(-2, tiny_nmea_rescale(&f, 1));
+    TEST_PASS();
+  }
+
+  TEST_CASE("rescale arbitrary scales") {
+    // scale 60 is not a power of ten, takes the divide path
+    tiny_nmea_float_t f = tiny_nmea_fp_div_int(&(tiny_nmea_float_t){.value = 90, .scale = 1}, 60);
+    TEST_ASSERT_EQ(60, f.scale);
+    TEST_ASSERT_EQ(1500, tiny_nmea_rescale(&f, 1000));
+    TEST_ASSERT_EQ(0, tiny_nmea_rescale(&f, 0));
+    TEST_PASS();
+  }
+
+  TEST_CASE("fp_add mixed scales") {
+    tiny_nmea_float_t a = {.value = 155, .scale = 10};
+    tiny_nmea_float_t b = {.value = -2025, .scale = 1000};
+    tiny_nmea_float_t sum = tiny_nmea_fp_add(&a, &b);
+    TEST_ASSERT_EQ(13475, sum.value);
+    TEST_ASSERT_EQ(1000, sum.scale);
+    sum = tiny_nmea_fp_add(&b, &a);
+    TEST_ASSERT_EQ(13475, sum.value);
+    TEST_ASSERT_EQ(1000, sum.scale);
+    TEST_PASS();
+  }
+
+  TEST_CASE("coord to fixed degrees every scale") {
+    // 48 07.038 N at 1..5 fractional digits, and a 9 digit scale
+    const tiny_nmea_coord_t coords[] = {
+      {{480704, 100}, 'N'}, {{4807038, 1000}, 'N'}, {{48070380, 10000}, 'S'},
+      {{481173, 10000}, 'N'}, {{1131000, 1000}, 'W'}, {{1, 1000000000}, 'E'},
+      {{2147483647, 100000}, 'E'},
+    };
+    for (size_t i = 0; i < sizeof(coords) / sizeof(coords[0]); i++) {
+      // reference: the plain 64-bit divide formula
+      int64_t raw = coords[i].raw.value, scale = coords[i].raw.scale;
+      int64_t deg = raw / (100 * scale);
+      int64_t ref = deg * 10000000 + ((raw - deg * 100 * scale) * 10000000) / (60 * scale);
+      if (coords[i].hemisphere == 'S' || coords[i].hemisphere == 'W') ref = -ref;
+      TEST_ASSERT_EQ((int32_t)ref, tiny_nmea_coord_to_fixed_degrees(&coords[i]));
+    }
+
+    tiny_nmea_coord_t c = {{4807038, 1000}, 'N'};
+    TEST_ASSERT_EQ(481173000, tiny_nmea_coord_to_fixed_degrees(&c));
+    TEST_PASS();
+  }
+
+  TEST_CASE("fixedpoint rejects more than 9 fractional digits") {
+    tiny_nmea_float_t f;
+    field_t fld = make_field("0.123456789");
+    TEST_ASSERT(parse_fixedpoint_float(&fld, &f));
+    TEST_ASSERT_EQ(1000000000, f.scale);
+    fld = make_field("0.1234567890");
+    TEST_ASSERT(!parse_fixedpoint_float(&fld, &f));
+    TEST_PASS();
+  }
+}
+
+// compact layout tests
+
+static void test_compact_layout(void) {
+  TEST_CASE("fixed-point exponent round trip") {
+    tiny_nmea_float_t f = {.value = -123456, .scale = 1000};
+    uint8_t exp = tiny_nmea_fp_exponent(&f);
+    TEST_ASSERT_EQ(3, exp);
+    tiny_nmea_float_t back = tiny_nmea_fp_from_exponent(f.value, exp);
+    TEST_ASSERT_EQ(f.value, back.value);
+    TEST_ASSERT_EQ(f.scale, back.scale);
+
+    f = (tiny_nmea_float_t){.value = 7, .scale = 1};
+    TEST_ASSERT_EQ(0, tiny_nmea_fp_exponent(&f));
+    f.scale = 1000000000;
+    TEST_ASSERT_EQ(9, tiny_nmea_fp_exponent(&f));
+    TEST_PASS();
+  }
+
+  TEST_CASE("fixed-point exponent invalid") {
+    tiny_nmea_float_t f = {.value = 5, .scale = 0};
+    TEST_ASSERT_EQ(TINY_NMEA_FP_EXP_INVALID, tiny_nmea_fp_exponent(&f));
+    f.scale = 60;
+    TEST_ASSERT_EQ(TINY_NMEA_FP_EXP_INVALID, tiny_nmea_fp_exponent(&f));
+
+    tiny_nmea_float_t back = tiny_nmea_fp_from_exponent(5, TINY_NMEA_FP_EXP_INVALID);
+    TEST_ASSERT(!tiny_nmea_float_valid(&back));
+    back = tiny_nmea_fp_from_exponent(5, 10);
+    TEST_ASSERT(!tiny_nmea_float_valid(&back));
+    TEST_PASS();
+  }
+
+  TEST_CASE("time pack round trip") {
+    tiny_nmea_time_t t = {.hours = 12, .minutes = 35, .seconds = 19,
+                          .microseconds = 250000, .valid = true};
+    tiny_nmea_time_ms_t ms = tiny_nmea_time_pack(&t);
+    TEST_ASSERT_EQ(45319250u, ms);
+
+    tiny_nmea_time_t back = tiny_nmea_time_unpack(ms);
+    TEST_ASSERT(back.valid);
+    TEST_ASSERT_EQ(12, back.hours);
+    TEST_ASSERT_EQ(35, back.minutes);
+    TEST_ASSERT_EQ(19, back.seconds);
+    TEST_ASSERT_EQ(250000u, back.microseconds);
+    TEST_PASS();
+  }
+
+  TEST_CASE("time pack drops sub-millisecond digits") {
+    tiny_nmea_time_t t = {.seconds = 1, .microseconds = 123456, .valid = true};
+    tiny_nmea_time_t back = tiny_nmea_time_unpack(tiny_nmea_time_pack(&t));
+    TEST_ASSERT_EQ(123000u, back.microseconds);
+    TEST_PASS();
+  }
+
+  TEST_CASE("time pack leap second and invalid") {
+    tiny_nmea_time_t t = {.hours = 23, .minutes = 59, .seconds = 60,
+                          .microseconds = 500000, .valid = true};
+    tiny_nmea_time_t back = tiny_nmea_time_unpack(tiny_nmea_time_pack(&t));
+    TEST_ASSERT(back.valid);
+    TEST_ASSERT_EQ(23, back.hours);
+    TEST_ASSERT_EQ(59, back.minutes);
+    TEST_ASSERT_EQ(60, back.seconds);
+    TEST_ASSERT_EQ(500000u, back.microseconds);
+
+    t.valid = false;
+    TEST_ASSERT_EQ(TINY_NMEA_TIME_MS_INVALID, tiny_nmea_time_pack(&t));
+    TEST_ASSERT(!tiny_nmea_time_unpack(TINY_NMEA_TIME_MS_INVALID).valid);
+    TEST_ASSERT(!tiny_nmea_time_unpack(86401000u).valid);
+    TEST_PASS();
+  }
+
+  TEST_CASE("date pack round trip") {
+    // RMC date, century unknown
+    tiny_nmea_date_t d = {.day = 23, .month = 3, .year = 0, .year_yy = 94, .valid = true};
+    tiny_nmea_date_t back = tiny_nmea_date_unpack(tiny_nmea_date_pack(&d));
+    TEST_ASSERT(back.valid);
+    TEST_ASSERT_EQ(23, back.day);
+    TEST_ASSERT_EQ(3, back.month);
+    TEST_ASSERT_EQ(0, back.year);
+    TEST_ASSERT_EQ(94, back.year_yy);
+
+    // ZDA date, full year only
+    d = (tiny_nmea_date_t){.day = 31, .month = 12, .year = 2099, .year_yy = 0, .valid = true};
+    back = tiny_nmea_date_unpack(tiny_nmea_date_pack(&d));
+    TEST_ASSERT_EQ(31, back.day);
+    TEST_ASSERT_EQ(12, back.month);
+    TEST_ASSERT_EQ(2099, back.year);
+    TEST_ASSERT_EQ(0, back.year_yy);
+
+    d.valid = false;
+    TEST_ASSERT_EQ(TINY_NMEA_DATE_PACKED_INVALID, tiny_nmea_date_pack(&d));
+    TEST_ASSERT(!tiny_nmea_date_unpack(TINY_NMEA_DATE_PACKED_INVALID).valid);
+    TEST_PASS();
+  }
+
+  TEST_CASE("coord pack folds hemisphere into sign") {
+    tiny_nmea_coord_t c = {.raw = {.value = 1131000, .scale = 1000}, .hemisphere = 'W'};
+    uint8_t exp = 0;
+    int32_t v = tiny_nmea_coord_pack(&c, &exp);
+    TEST_ASSERT_EQ(-1131000, v);
+    TEST_ASSERT_EQ(3, exp & TINY_NMEA_COORD_EXP_MASK);
+    TEST_ASSERT_EQ(TINY_NMEA_COORD_HEMI_NEG, exp >> TINY_NMEA_COORD_HEMI_SHIFT);
+
+    tiny_nmea_coord_t back = tiny_nmea_coord_unpack(v, exp, true);
+    TEST_ASSERT_EQ('W', back.hemisphere);
+    TEST_ASSERT_EQ(1131000, back.raw.value);
+    TEST_ASSERT_EQ(1000, back.raw.scale);
+
+    back = tiny_nmea_coord_unpack(4807038, 3, false);
+    TEST_ASSERT_EQ('N', back.hemisphere);
+
+    c = (tiny_nmea_coord_t){0};
+    TEST_ASSERT_EQ(0, tiny_nmea_coord_pack(&c, &exp));
+    TEST_ASSERT_EQ(TINY_NMEA_FP_EXP_INVALID, exp);
+    back = tiny_nmea_coord_unpack(0, exp, false);
+    TEST_ASSERT(!tiny_nmea_coord_valid(&back));
+    TEST_PASS();
+  }
+
+  TEST_CASE("coord pack round trips zero and missing halves") {
+    const tiny_nmea_coord_t cases[] = {
+      {.raw = {.value = 0, .scale = 10000}, .hemisphere = 'S'},
+      {.raw = {.value = 0, .scale = 1}, .hemisphere = 'W'},
+      {.raw = {.value = 0, .scale = 100}, .hemisphere = 'N'},
+      {.raw = {.value = 4807038, .scale = 1000}, .hemisphere = '\0'},
+      {.raw = {.value = 0, .scale = 0}, .hemisphere = 'S'},
+      {.raw = {.value = 0, .scale = 0}, .hemisphere = '\0'},
+      {.raw = {.value = 1131000, .scale = 1000000000}, .hemisphere = 'E'},
+    };
+    const bool is_lon[] = {false, true, false, false, false, false, true};
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+      uint8_t exp = 0;
+      int32_t v = tiny_nmea_coord_pack(&cases[i], &exp);
+      tiny_nmea_coord_t back = tiny_nmea_coord_unpack(v, exp, is_lon[i]);
+      TEST_ASSERT_EQ(cases[i].hemisphere, back.hemisphere);
+      TEST_ASSERT_EQ(cases[i].raw.value, back.raw.value);
+      TEST_ASSERT_EQ(cases[i].raw.scale, back.raw.scale);
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("rmc compact round trip") {
+    TEST_ASSERT(sizeof(tiny_nmea_rmc_compact_t) <= 40);
+    TEST_ASSERT(sizeof(tiny_nmea_rmc_compact_t) < sizeof(tiny_nmea_rmc_t));
+
+    tiny_nmea_rmc_t rmc = {
+      .time = {.hours = 12, .minutes = 35, .seconds = 19, .microseconds = 0, .valid = true},
+      .date = {.day = 23, .month = 3, .year = 0, .year_yy = 94, .valid = true},
+      .status_valid = true,
+      .latitude = {.raw = {.value = 4807038, .scale = 1000}, .hemisphere = 'S'},
+      .longitude = {.raw = {.value = 1131000, .scale = 1000}, .hemisphere = 'E'},
+      .speed_knots = {.value = 224, .scale = 10},
+      .course_deg = {.value = 0, .scale = 0},
+      .mag_variation = {.value = 31, .scale = 10},
+      .mag_var_dir = 'W',
+      .faa_mode = TINY_NMEA_FAA_AUTONOMOUS,
+    };
+
+    tiny_nmea_rmc_compact_t c;
+    tiny_nmea_rmc_compact(&rmc, &c);
+    TEST_ASSERT_EQ(-4807038, c.latitude);
+    TEST_ASSERT_EQ(TINY_NMEA_FP_EXP_INVALID, c.course_deg_exp);
+
+    tiny_nmea_rmc_t back;
+    memset(&back, 0xAA, sizeof(back));
+    tiny_nmea_rmc_expand(&c, &back);
+    TEST_ASSERT(back.time.valid);
+    TEST_ASSERT_EQ(19, back.time.seconds);
+    TEST_ASSERT_EQ(94, back.date.year_yy);
+    TEST_ASSERT(back.status_valid);
+    TEST_ASSERT_EQ('S', back.latitude.hemisphere);
+    TEST_ASSERT_EQ(4807038, back.latitude.raw.value);
+    TEST_ASSERT_EQ('E', back.longitude.hemisphere);
+    TEST_ASSERT_EQ(224, back.speed_knots.value);
+    TEST_ASSERT_EQ(10, back.speed_knots.scale);
+    TEST_ASSERT(!tiny_nmea_float_valid(&back.course_deg));
+    TEST_ASSERT_EQ(31, back.mag_variation.value);
+    TEST_ASSERT_EQ('W', back.mag_var_dir);
+    TEST_ASSERT_EQ(TINY_NMEA_FAA_AUTONOMOUS, back.faa_mode);
+    TEST_ASSERT_EQ(TINY_NMEA_NAV_STATUS_UNKNOWN, back.nav_status);
+    TEST_PASS();
+  }
+}
+
+// single pass scanner tests
+
+// scan one field out of a sentence so the comma after it is part of the data
+static scan_cursor_t make_cursor(const char *str) {
+  scan_cursor_t c = {.pos = str, .end = str + strlen(str)};
+  return c;
+}
+
+static void test_scan_fields(void) {
+  TEST_CASE("scanners match parse_* on the same field") {
+    static const char *inputs[] = {
+      "123", "0", "007", "4294967295", "4294967296", "12a", "", "-5", "+7", "-",
+      "123.456", "-45.5", ".5", "42.", ".", "1.2.3", "3855.4487", "0.1234567890",
+      "123519", "123519.25", "235959.1234567", "246000", "12345", "12x519",
+      "230394", "320394", "A", "V",
+    };
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+      char buf[32];
+      // trailing comma and a following field the scanner must not touch
+      snprintf(buf, sizeof(buf), "%s,9", inputs[i]);
+      field_t f = make_field(inputs[i]);
+      size_t field_len = strlen(inputs[i]);
+
+      uint32_t u1 = 0, u2 = 0;
+      scan_cursor_t c = make_cursor(buf);
+      TEST_ASSERT_EQ(parse_uint(&f, &u1), scan_uint(&c, &u2));
+      TEST_ASSERT_EQ(u1, u2);
+      TEST_ASSERT(c.pos == buf + field_len);
+
+      int32_t s1 = 0, s2 = 0;
+      c = make_cursor(buf);
+      TEST_ASSERT_EQ(parse_int(&f, &s1), scan_int(&c, &s2));
+      TEST_ASSERT_EQ(s1, s2);
+      TEST_ASSERT(c.pos == buf + field_len);
+
+      tiny_nmea_float_t fl1, fl2;
+      c = make_cursor(buf);
+      TEST_ASSERT_EQ(parse_fixedpoint_float(&f, &fl1), scan_fixedpoint_float(&c, &fl2));
+      TEST_ASSERT_EQ(fl1.value, fl2.value);
+      TEST_ASSERT_EQ(fl1.scale, fl2.scale);
+      TEST_ASSERT(c.pos == buf + field_len);
+
+      // zeroed so padding compares equal
+      tiny_nmea_time_t t1, t2;
+      memset(&t1, 0, sizeof(t1));
+      memset(&t2, 0, sizeof(t2));
+      c = make_cursor(buf);
+      TEST_ASSERT_EQ(parse_time(&f, &t1), scan_time(&c, &t2));
+      TEST_ASSERT(memcmp(&t1, &t2, sizeof(t1)) == 0);
+      TEST_ASSERT(c.pos == buf + field_len);
+
+      tiny_nmea_date_t d1, d2;
+      memset(&d1, 0, sizeof(d1));
+      memset(&d2, 0, sizeof(d2));
+      c = make_cursor(buf);
+      TEST_ASSERT_EQ(parse_date(&f, &d1), scan_date(&c, &d2));
+      TEST_ASSERT(memcmp(&d1, &d2, sizeof(d1)) == 0);
+      TEST_ASSERT(c.pos == buf + field_len);
+    }
+    TEST_PASS();
+  }
+
+  TEST_CASE("scan latitude peeks at the hemisphere field") {
+    tiny_nmea_coord_t coord;
+    scan_cursor_t c = make_cursor("4807.038,N,01131.000");
+    TEST_ASSERT(scan_latitude(&c, &coord));
+    TEST_ASSERT_EQ(4807038, coord.raw.value);
+    TEST_ASSERT_EQ('N', coord.hemisphere);
+    // left on the comma, the hemisphere is still the next field
+    TEST_ASSERT_EQ(',', *c.pos);
+    TEST_ASSERT_EQ('N', c.pos[1]);
+
+    c = make_cursor("4807.038,,01131.000");
+    TEST_ASSERT(scan_latitude(&c, &coord));
+    TEST_ASSERT_EQ('\0', coord.hemisphere);
+
+    c = make_cursor("4807.038,E");
+    TEST_ASSERT(!scan_latitude(&c, &coord));
+
+    c = make_cursor("4807.038");
+    TEST_ASSERT(scan_latitude(&c, &coord));
+    TEST_ASSERT(c.pos == c.end);
+    TEST_PASS();
+  }
+
+  TEST_CASE("scan longitude") {
+    tiny_nmea_coord_t coord;
+    scan_cursor_t c = make_cursor("01131.000,W,1");
+    TEST_ASSERT(scan_longitude(&c, &coord));
+    TEST_ASSERT_EQ(1131000, coord.raw.value);
+    TEST_ASSERT_EQ('W', coord.hemisphere);
+
+    c = make_cursor("01131.000,N");
+    TEST_ASSERT(!scan_longitude(&c, &coord));
+    TEST_PASS();
+  }
+
+  TEST_CASE("scan skip and char") {
+    char ch = 0;
+    scan_cursor_t c = make_cursor("AB,C");
+    TEST_ASSERT(scan_char(&c, &ch));
+    TEST_ASSERT_EQ('A', ch);
+    TEST_ASSERT(c.pos == c.end - 2);
+
+    c.pos++;
+    scan_skip(&c);
+    TEST_ASSERT(c.pos == c.end);
+    TEST_ASSERT(scan_at_sep(&c));
+    TEST_ASSERT(!scan_char(&c, &ch));
+    TEST_PASS();
+  }
+}
+
 int main(void) {
   TEST_TITLE("field parsing tests");
 
   test_tokenize_basic();
   test_field_empty();
   test_parse_uint();
+  test_swar_digits();
   test_parse_int();
   test_parse_char();
   test_parse_fixedpoint_float();
@@ -656,6 +1239,9 @@ int main(void) {
   test_parse_latitude();
   test_parse_longitude();
   test_conversions();
+  test_fixed_point_math();
+  test_compact_layout();
+  test_scan_fields();
 
   TEST_SUMMARY();
 }
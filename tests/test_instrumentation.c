@@ -0,0 +1,142 @@
+//
+// unit tests for a build with the hot path instrumentation compiled in
+//
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea.h"
+
+#include <string.h>
+
+#if !TINY_NMEA_ENABLE_INSTRUMENTATION
+#error "test_instrumentation must be built with TINY_NMEA_ENABLE_INSTRUMENTATION=1"
+#endif
+
+static tiny_nmea_ctx_t ctx;
+static uint8_t ring[512];
+static int parse_count;
+
+static void on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t st, void *user_data) {
+  (void)result;
+  (void)st;
+  (void)user_data;
+  parse_count++;
+}
+
+static const char *burst =
+  "garbage$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+  "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+  "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+
+static uint32_t hist_total(const tiny_nmea_instrumentation_t *in, tiny_nmea_sentence_type_t type) {
+  uint32_t n = 0;
+  for (size_t i = 0; i < TINY_NMEA_INSTR_HIST_BUCKETS; i++) n += in->parse_hist[type][i];
+  return n;
+}
+
+static void test_instr_copy_framing(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSV
+  TEST_CASE("instrumentation counts copy framing") {
+    parse_count = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)burst, strlen(burst));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(3, parse_count);
+
+    tiny_nmea_instrumentation_t in;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_get_instrumentation(&ctx, &in));
+
+    // the leading garbage is all FIND_START threw away
+    TEST_ASSERT_EQ(strlen("garbage"), in.find_start_discarded);
+    TEST_ASSERT_EQ(strlen(burst), in.ring_high_water);
+    // the rest of each window is shifted down after every sentence
+    TEST_ASSERT(in.memmove_bytes > 0);
+
+    TEST_ASSERT_EQ(1, hist_total(&in, TINY_NMEA_SENTENCE_RMC));
+    TEST_ASSERT_EQ(2, hist_total(&in, TINY_NMEA_SENTENCE_GGA));
+    TEST_ASSERT_EQ(0, hist_total(&in, TINY_NMEA_SENTENCE_GSV));
+
+    for (size_t s = 0; s < TINY_NMEA_PARSE_STATE_COUNT; s++) {
+      if (s == TINY_NMEA_PARSE_FIND_END || s == TINY_NMEA_PARSE_SKIP_TO_END) continue;
+      TEST_ASSERT(in.state_steps[s] > 0);
+    }
+    TEST_ASSERT_EQ(3, in.state_steps[TINY_NMEA_PARSE_FIND_END]);
+    TEST_ASSERT_EQ(3, in.state_steps[TINY_NMEA_SENTENCE_COMPLETE]);
+    TEST_ASSERT_EQ(0, in.state_steps[TINY_NMEA_PARSE_SKIP_TO_END]);
+
+    // parsing and the callback happen inside the COMPLETE steps
+    TEST_ASSERT(in.state_ticks[TINY_NMEA_SENTENCE_COMPLETE] >= in.parse_ticks + in.callback_ticks);
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_instr_in_place(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA
+  TEST_CASE("instrumentation in-place framing never memmoves") {
+    parse_count = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+    tiny_nmea_set_framing_mode(&ctx, TINY_NMEA_FRAMING_IN_PLACE);
+    tiny_nmea_set_sentence_filter(&ctx, TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_GGA));
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)burst, strlen(burst));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(2, parse_count);
+
+    tiny_nmea_instrumentation_t in;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_get_instrumentation(&ctx, &in));
+    TEST_ASSERT_EQ(0, in.memmove_bytes);
+    // skipping stops at the line end, FIND_START drops the CRLF
+    TEST_ASSERT_EQ(strlen("garbage") + 2, in.find_start_discarded);
+
+    // the filtered RMC is skipped, never parsed
+    TEST_ASSERT(in.state_steps[TINY_NMEA_PARSE_SKIP_TO_END] > 0);
+    TEST_ASSERT_EQ(0, hist_total(&in, TINY_NMEA_SENTENCE_RMC));
+    TEST_ASSERT_EQ(2, hist_total(&in, TINY_NMEA_SENTENCE_GGA));
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_instr_high_water_and_reset(void) {
+#if TINY_NMEA_ENABLE_GGA
+  TEST_CASE("instrumentation high-water mark and reset") {
+    parse_count = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+
+    // the mark keeps the largest backlog across work calls
+    tiny_nmea_feed(&ctx, (const uint8_t *)burst, strlen(burst));
+    tiny_nmea_work(&ctx);
+    tiny_nmea_feed(&ctx, (const uint8_t *)"$GPGGA,", 7);
+    tiny_nmea_work(&ctx);
+
+    tiny_nmea_instrumentation_t in;
+    tiny_nmea_get_instrumentation(&ctx, &in);
+    TEST_ASSERT_EQ(strlen(burst), in.ring_high_water);
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_reset_instrumentation(&ctx));
+    tiny_nmea_get_instrumentation(&ctx, &in);
+    TEST_ASSERT_EQ(0, in.ring_high_water);
+    TEST_ASSERT_EQ(0, in.find_start_discarded);
+    TEST_ASSERT_EQ(0, in.state_steps[TINY_NMEA_PARSE_FIND_START]);
+    TEST_ASSERT_EQ(0, hist_total(&in, TINY_NMEA_SENTENCE_GGA));
+
+    // the stats are separate and untouched
+    TEST_ASSERT_EQ(3, ctx.stats.sentences_parsed);
+
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_get_instrumentation(&ctx, NULL));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_reset_instrumentation(NULL));
+    TEST_PASS();
+  }
+#endif
+}
+
+int main(void) {
+  TEST_TITLE("instrumentation tests");
+
+  test_instr_copy_framing();
+  test_instr_in_place();
+  test_instr_high_water_and_reset();
+
+  TEST_SUMMARY();
+}
@@ -0,0 +1,309 @@
+//
+// tests for the multi-stream parser pool
+//
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_STREAMS 8
+#define POOL_SENTENCES 200
+
+static const char *rmc = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n";
+static const char *gsv = "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n";
+
+static atomic_uint stream_parsed[POOL_STREAMS];
+
+static void on_stream_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)result;
+  (void)stats;
+  atomic_fetch_add((atomic_uint *)user_data, 1);
+}
+
+static tiny_nmea_pool_t *make_pool(size_t workers) {
+  tiny_nmea_pool_config_t config = {
+    .stream_count = POOL_STREAMS,
+    .ring_size = 32 * 1024,
+    .worker_count = workers,
+    .pin_workers = true,
+  };
+
+  tiny_nmea_pool_t *pool = NULL;
+  if (tiny_nmea_pool_create(&pool, &config) != TINY_NMEA_OK) return NULL;
+
+  for (size_t s = 0; s < POOL_STREAMS; s++) {
+    atomic_store(&stream_parsed[s], 0);
+    tiny_nmea_set_parse_callback(tiny_nmea_pool_stream(pool, s), on_stream_parse, &stream_parsed[s]);
+  }
+  return pool;
+}
+
+static void test_pool_create(void) {
+  TEST_CASE("pool create rejects bad config") {
+    tiny_nmea_pool_t *pool = NULL;
+    tiny_nmea_pool_config_t config = {0};
+
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_pool_create(&pool, &config));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_pool_create(NULL, &config));
+
+    config.stream_count = 2;
+    config.ring_size = 256;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_create(&pool, &config));
+    TEST_ASSERT(tiny_nmea_pool_stream(pool, 1) != NULL);
+    TEST_ASSERT(tiny_nmea_pool_stream(pool, 2) == NULL);
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_pool_stop(pool));
+    tiny_nmea_pool_destroy(pool);
+
+    TEST_PASS();
+  }
+}
+
+static void test_pool_single_feeder(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("pool single feeder thread") {
+    tiny_nmea_pool_t *pool = make_pool(3);
+    TEST_ASSERT(pool != NULL);
+    tiny_nmea_set_sentence_filter(tiny_nmea_pool_stream(pool, 3), TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_RMC));
+
+    // data fed before start is picked up by the first pass
+    for (size_t s = 0; s < POOL_STREAMS; s++) {
+      TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_feed(pool, s, (const uint8_t *)rmc, strlen(rmc)));
+    }
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_start(pool));
+
+    for (size_t i = 1; i < POOL_SENTENCES; i++) {
+      for (size_t s = 0; s < POOL_STREAMS; s++) {
+        const char *sentence = (s == 3 && i % 10 == 0) ? gsv : rmc;
+        tiny_nmea_pool_feed(pool, s, (const uint8_t *)sentence, strlen(sentence));
+      }
+    }
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_stop(pool));
+
+    tiny_nmea_parser_statistics_t stats;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_stream_stats(pool, 0, &stats));
+    TEST_ASSERT_EQ(POOL_SENTENCES, stats.sentences_parsed);
+    TEST_ASSERT_EQ(POOL_SENTENCES, atomic_load(&stream_parsed[0]));
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_stream_stats(pool, 3, &stats));
+    TEST_ASSERT_EQ(19, stats.sentences_filtered);
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_stats(pool, &stats));
+    TEST_ASSERT_EQ(POOL_STREAMS * POOL_SENTENCES - 19, stats.sentences_parsed);
+    TEST_ASSERT_EQ(19, stats.sentences_filtered);
+
+    tiny_nmea_pool_destroy(pool);
+    TEST_PASS();
+  }
+#endif
+}
+
+typedef struct {
+  tiny_nmea_pool_t *pool;
+  size_t first_stream;
+} feeder_arg_t;
+
+// each feeder owns two streams and feeds them in small chunks
+static void *feeder_main(void *arg) {
+  feeder_arg_t *f = arg;
+  size_t len = strlen(rmc);
+
+  for (size_t i = 0; i < POOL_SENTENCES; i++) {
+    for (size_t s = f->first_stream; s < f->first_stream + 2; s++) {
+      for (size_t off = 0; off < len; off += 16) {
+        size_t chunk = (len - off < 16) ? len - off : 16;
+        tiny_nmea_pool_feed(f->pool, s, (const uint8_t *)rmc + off, chunk);
+      }
+    }
+  }
+  return NULL;
+}
+
+static void test_pool_many_feeders(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("pool one feeder thread per stream pair") {
+    tiny_nmea_pool_t *pool = make_pool(0);
+    TEST_ASSERT(pool != NULL);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_start(pool));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_pool_start(pool));
+
+    pthread_t feeders[POOL_STREAMS / 2];
+    feeder_arg_t args[POOL_STREAMS / 2];
+    for (size_t i = 0; i < POOL_STREAMS / 2; i++) {
+      args[i].pool = pool;
+      args[i].first_stream = i * 2;
+      pthread_create(&feeders[i], NULL, feeder_main, &args[i]);
+    }
+    for (size_t i = 0; i < POOL_STREAMS / 2; i++) {
+      pthread_join(feeders[i], NULL);
+    }
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_pool_stop(pool));
+
+    tiny_nmea_parser_statistics_t stats;
+    tiny_nmea_pool_stats(pool, &stats);
+    TEST_ASSERT_EQ(POOL_STREAMS * POOL_SENTENCES, stats.sentences_parsed);
+    TEST_ASSERT_EQ(0, stats.buffer_overflows);
+    for (size_t s = 0; s < POOL_STREAMS; s++) {
+      TEST_ASSERT_EQ(POOL_SENTENCES, atomic_load(&stream_parsed[s]));
+    }
+
+    tiny_nmea_pool_destroy(pool);
+    TEST_PASS();
+  }
+#endif
+}
+
+// parallel chunked parsing
+
+#define PARALLEL_MAX_RESULTS 4096
+
+static tiny_nmea_type_t ordered[PARALLEL_MAX_RESULTS];
+static size_t ordered_count;
+static size_t ordered_errors;
+
+static void on_ordered_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)stats;
+  (void)user_data;
+  if (ordered_count < PARALLEL_MAX_RESULTS) ordered[ordered_count++] = *result;
+}
+
+static void on_ordered_error(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)result;
+  (void)stats;
+  (void)user_data;
+  ordered_errors++;
+}
+
+static void test_pool_parse_parallel(void) {
+  TEST_CASE("sentence boundary") {
+    const char *data = "$GPGLL,1*00\r\n$GP$GP\r\n\r\n!AI\n";
+    const uint8_t *d = (const uint8_t *)data;
+    size_t len = strlen(data);
+
+    TEST_ASSERT_EQ(0, tiny_nmea_sentence_boundary(d, len, 0));
+    TEST_ASSERT_EQ(13, tiny_nmea_sentence_boundary(d, len, 1));
+    TEST_ASSERT_EQ(13, tiny_nmea_sentence_boundary(d, len, 13));
+    // the '$' inside the line is not a boundary
+    TEST_ASSERT_EQ(23, tiny_nmea_sentence_boundary(d, len, 14));
+    TEST_ASSERT_EQ(len, tiny_nmea_sentence_boundary(d, len, 24));
+    TEST_ASSERT_EQ(len, tiny_nmea_sentence_boundary(d, len, len + 5));
+    TEST_PASS();
+  }
+
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GLL && TINY_NMEA_ENABLE_ZDA
+  TEST_CASE("parse parallel matches a single pass") {
+    // RMCs before the ZDA get no year, the ZDA sits somewhere in the middle
+    const char *pre = "$GPRMC,120001,A,4807.038,N,01131.000,E,022.4,084.4,150125,003.1,W*68\r\n";
+    const char *zda = "$GPZDA,120000.00,15,01,2025,00,00*65\r\n";
+    const char *bad = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+                      "$GPRMC,123519,A,4807.038,N\r\n"
+                      "$GPGLL,4916.45,N,12311.12,W,225444,A*3A\r\n";
+
+    size_t cap = 2000 * (strlen(pre) + strlen(bad)) + strlen(zda);
+    char *data = malloc(cap + 1);
+    TEST_ASSERT(data != NULL);
+    size_t len = 0;
+    for (int i = 0; i < 2000; i++) {
+      if (i == 700) {
+        memcpy(&data[len], zda, strlen(zda));
+        len += strlen(zda);
+      }
+      memcpy(&data[len], pre, strlen(pre));
+      len += strlen(pre);
+      if (i % 4 == 0) {
+        memcpy(&data[len], bad, strlen(bad));
+        len += strlen(bad);
+      }
+    }
+
+    // single pass reference
+    static tiny_nmea_ctx_t ctx;
+    static uint8_t ring[16];
+    ordered_count = 0;
+    ordered_errors = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_ordered_parse, NULL, on_ordered_error, NULL);
+    tiny_nmea_parse_buffer(&ctx, (const uint8_t *)data, len);
+    size_t single_count = ordered_count;
+    size_t single_errors = ordered_errors;
+    uint16_t first_year = ordered[0].data.rmc.date.year;
+    uint16_t last_year = ordered[ordered_count - 1].data.rmc.date.year;
+
+    TEST_ASSERT_EQ(0, first_year);
+    TEST_ASSERT_EQ(2025, last_year);
+    TEST_ASSERT(single_errors > 0);
+
+    tiny_nmea_parallel_config_t config = {
+      .chunk_count = 7,
+      .parse_callback = on_ordered_parse,
+      .error_callback = on_ordered_error,
+    };
+    tiny_nmea_parser_statistics_t stats;
+    ordered_count = 0;
+    ordered_errors = 0;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse_parallel((const uint8_t *)data, len, &config, &stats));
+    TEST_ASSERT_EQ(single_count, ordered_count);
+    TEST_ASSERT_EQ(single_errors, ordered_errors);
+    TEST_ASSERT_EQ(ctx.stats.sentences_parsed, stats.sentences_parsed);
+    TEST_ASSERT_EQ(ctx.stats.parse_errors, stats.parse_errors);
+    TEST_ASSERT_EQ(ctx.stats.checksum_errors, stats.checksum_errors);
+    TEST_ASSERT(stats.checksum_errors > 0);
+
+    // in order, and every RMC after the ZDA has the full year even in later chunks
+    bool ordered_ok = true;
+    size_t zda_at = 0;
+    for (size_t i = 0; i < ordered_count; i++) {
+      if (ordered[i].type == TINY_NMEA_SENTENCE_ZDA) zda_at = i;
+      if (ordered[i].type != TINY_NMEA_SENTENCE_RMC) continue;
+      uint16_t want = zda_at ? 2025 : 0;
+      if (ordered[i].data.rmc.date.year != want) ordered_ok = false;
+    }
+    TEST_ASSERT(zda_at > 0);
+    TEST_ASSERT(ordered_ok);
+
+    // filter and the default chunk count
+    config.chunk_count = 0;
+    config.sentence_filter = TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_ZDA);
+    ordered_count = 0;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse_parallel((const uint8_t *)data, len, &config, &stats));
+    TEST_ASSERT_EQ(1, ordered_count);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_ZDA, ordered[0].type);
+
+    free(data);
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_GLL
+  TEST_CASE("parse parallel edge cases") {
+    tiny_nmea_parallel_config_t config = { .chunk_count = 4, .parse_callback = on_ordered_parse };
+    ordered_count = 0;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse_parallel(NULL, 0, &config, NULL));
+    TEST_ASSERT_EQ(0, ordered_count);
+
+    // fewer bytes than chunks
+    const char *gll = "$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n";
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse_parallel((const uint8_t *)gll, strlen(gll), &config, NULL));
+    TEST_ASSERT_EQ(1, ordered_count);
+
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_parse_parallel(NULL, 1, &config, NULL));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_parse_parallel((const uint8_t *)gll, 1, NULL, NULL));
+    TEST_PASS();
+  }
+#endif
+}
+
+int main(void) {
+  TEST_TITLE("parser pool tests");
+
+  test_pool_create();
+  test_pool_single_feeder();
+  test_pool_many_feeders();
+  test_pool_parse_parallel();
+
+  TEST_SUMMARY();
+}
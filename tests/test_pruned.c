@@ -0,0 +1,82 @@
+//
+// unit tests for a build with only RMC and GGA compiled in
+//
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea.h"
+
+#include <string.h>
+
+#if TINY_NMEA_ENABLE_GSV || TINY_NMEA_ENABLE_VDM || !TINY_NMEA_ENABLE_RMC || !TINY_NMEA_ENABLE_GGA
+#error "test_pruned must be built with only RMC and GGA enabled"
+#endif
+
+static int parse_count;
+static tiny_nmea_type_t last_result;
+
+static void on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t st, void *user_data) {
+  (void)st;
+  (void)user_data;
+  last_result = *result;
+  parse_count++;
+}
+
+static void test_pruned_types(void) {
+  TEST_CASE("pruned union only holds the enabled sentences") {
+    tiny_nmea_type_t t;
+    size_t biggest = sizeof(t.data.rmc) > sizeof(t.data.gga) ? sizeof(t.data.rmc) : sizeof(t.data.gga);
+    TEST_ASSERT_EQ(biggest, sizeof(t.data));
+
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_RMC) | TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_GGA),
+                   TINY_NMEA_SENTENCE_MASK_ENABLED);
+    TEST_PASS();
+  }
+
+  TEST_CASE("pruned parse rejects compiled out types") {
+    tiny_nmea_type_t result;
+    memset(&result, 0, sizeof(result));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,", &result));
+    TEST_ASSERT_EQ(8, result.data.gga.satellites_used);
+
+    memset(&result, 0, sizeof(result));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_UNSUPPORTED, tiny_nmea_parse("$GPGLL,4916.45,N,12311.12,W,225444,A", &result));
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GLL, result.type);
+    TEST_PASS();
+  }
+}
+
+static void test_pruned_stream(void) {
+  TEST_CASE("pruned stream skips compiled out types") {
+    static tiny_nmea_ctx_t ctx;
+    static uint8_t ring[512];
+    parse_count = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+
+    const char *data =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n"
+      "!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    TEST_ASSERT_EQ(2, parse_count);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GGA, last_result.type);
+    TEST_ASSERT_EQ(2, ctx.stats.sentences_filtered);
+    TEST_ASSERT_EQ(0, ctx.stats.parse_errors);
+
+    // asking for everything still only gets what is compiled in
+    tiny_nmea_set_sentence_filter(&ctx, TINY_NMEA_SENTENCE_MASK_ALL);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_MASK_ENABLED, ctx.sentence_filter);
+    TEST_PASS();
+  }
+}
+
+int main(void) {
+  TEST_TITLE("pruned build tests");
+
+  test_pruned_types();
+  test_pruned_stream();
+
+  TEST_SUMMARY();
+}
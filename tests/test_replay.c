@@ -0,0 +1,77 @@
+//
+// unit tests for the mmap log replay driver
+//
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea_replay.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *log_path = "tiny_nmea_test_replay.nmea";
+
+static int parsed;
+
+static void on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t st, void *user_data) {
+  (void)result;
+  (void)st;
+  (void)user_data;
+  parsed++;
+}
+
+static int write_log(const char *data, size_t len) {
+  FILE *f = fopen(log_path, "wb");
+  if (!f) return -1;
+  size_t written = fwrite(data, 1, len, f);
+  fclose(f);
+  return written == len ? 0 : -1;
+}
+
+static void test_replay_mmap(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_VDM
+  TEST_CASE("replay a log file") {
+    const char *data =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+      "!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A\r\n";
+    TEST_ASSERT_EQ(0, write_log(data, strlen(data)));
+
+    static tiny_nmea_ctx_t ctx;
+    static uint8_t ring[256];
+    parsed = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_replay_mmap(&ctx, log_path));
+    TEST_ASSERT_EQ(3, parsed);
+    TEST_ASSERT_EQ(3, ctx.stats.sentences_parsed);
+
+    remove(log_path);
+    TEST_PASS();
+  }
+#endif
+
+  TEST_CASE("replay an empty or missing file") {
+    static tiny_nmea_ctx_t ctx;
+    static uint8_t ring[256];
+    parsed = 0;
+    tiny_nmea_init_callbacks(&ctx, ring, sizeof(ring), on_parse, NULL, NULL, NULL);
+
+    TEST_ASSERT_EQ(0, write_log("", 0));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_replay_mmap(&ctx, log_path));
+    TEST_ASSERT_EQ(0, parsed);
+    remove(log_path);
+
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_replay_mmap(&ctx, log_path));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_replay_mmap(&ctx, "."));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_replay_mmap(NULL, log_path));
+    TEST_PASS();
+  }
+}
+
+int main(void) {
+  TEST_TITLE("log replay tests");
+
+  test_replay_mmap();
+
+  TEST_SUMMARY();
+}
@@ -23,6 +23,20 @@ static void test_ringbuf_init(void) {
 
     TEST_PASS();
   }
+
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  TEST_CASE("ringbuf init rejects storage the indices can not reach") {
+    uint8_t buf[64];
+    ringbuf_t rb;
+    TEST_ASSERT(ringbuf_init(&rb, buf, sizeof(buf)));
+
+    // never touched, only the size is checked
+    TEST_ASSERT(!ringbuf_init(&rb, buf, RINGBUF_MAX_SIZE + 1));
+    TEST_ASSERT_EQ(63, ringbuf_free(&rb));
+
+    TEST_PASS();
+  }
+#endif
 }
 
 // test basic push and pop
@@ -317,6 +331,123 @@ static void test_ringbuf_large_data(void) {
   }
 }
 
+// test reading the ring storage in place
+static void test_ringbuf_peek_spans(void) {
+  TEST_CASE("ringbuf peek spans and discard") {
+    uint8_t buf[8];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(0, ringbuf_peek_spans(&rb, &s1, &s2));
+    TEST_ASSERT_EQ(0, s1.len + s2.len);
+
+    ringbuf_push(&rb, (uint8_t *)"abc", 3, RINGBUF_PUSH_DROP);
+    TEST_ASSERT_EQ(3, ringbuf_peek_spans(&rb, &s1, &s2));
+    TEST_ASSERT(s1.ptr == buf);
+    TEST_ASSERT_EQ(3, s1.len);
+    TEST_ASSERT_EQ(0, s2.len);
+
+    // move the data across the wrap point
+    ringbuf_discard(&rb, 3);
+    ringbuf_push(&rb, (uint8_t *)"defghij", 7, RINGBUF_PUSH_DROP);
+    TEST_ASSERT_EQ(7, ringbuf_peek_spans(&rb, &s1, &s2));
+    TEST_ASSERT(s1.ptr == buf + 3);
+    TEST_ASSERT_EQ(5, s1.len);
+    TEST_ASSERT_MEM_EQ("defgh", s1.ptr, 5);
+    TEST_ASSERT(s2.ptr == buf);
+    TEST_ASSERT_EQ(2, s2.len);
+    TEST_ASSERT_MEM_EQ("ij", s2.ptr, 2);
+
+    // peeking does not consume, discard commits the read
+    TEST_ASSERT_EQ(7, ringbuf_len(&rb));
+    TEST_ASSERT_EQ(6, ringbuf_discard(&rb, 6));
+    TEST_ASSERT_EQ(1, ringbuf_peek_spans(&rb, &s1, &s2));
+    TEST_ASSERT(s1.ptr == buf + 1);
+    TEST_ASSERT_EQ('j', s1.ptr[0]);
+    TEST_ASSERT_EQ(0, s2.len);
+
+    TEST_PASS();
+  }
+}
+
+// test writing straight into the ring storage
+static void test_ringbuf_reserve_commit(void) {
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  TEST_CASE("ringbuf reserve unavailable with multiple producers") {
+    uint8_t buf[8];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(0, ringbuf_reserve(&rb, &s1, &s2));
+    TEST_ASSERT_EQ(0, s1.len + s2.len);
+    TEST_ASSERT_EQ(0, ringbuf_commit(&rb, 4));
+    TEST_ASSERT(ringbuf_empty(&rb));
+
+    TEST_PASS();
+  }
+#else
+  TEST_CASE("ringbuf reserve and commit") {
+    uint8_t buf[8];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(7, ringbuf_reserve(&rb, &s1, &s2));
+    TEST_ASSERT(s1.ptr == buf);
+    TEST_ASSERT_EQ(7, s1.len);
+    TEST_ASSERT_EQ(0, s2.len);
+
+    // nothing is visible before the commit
+    memcpy(s1.ptr, "abcde", 5);
+    TEST_ASSERT(ringbuf_empty(&rb));
+    TEST_ASSERT_EQ(5, ringbuf_commit(&rb, 5));
+    TEST_ASSERT_EQ(5, ringbuf_len(&rb));
+
+    uint8_t out[8] = {0};
+    ringbuf_pop(&rb, out, 4);
+    TEST_ASSERT_MEM_EQ("abcd", out, 4);
+
+    TEST_PASS();
+  }
+
+  TEST_CASE("ringbuf reserve across wrap") {
+    uint8_t buf[8];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    // move head to 6 and tail to 4
+    ringbuf_push(&rb, (uint8_t *)"abcdef", 6, RINGBUF_PUSH_DROP);
+    ringbuf_discard(&rb, 4);
+
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(5, ringbuf_reserve(&rb, &s1, &s2));
+    TEST_ASSERT(s1.ptr == buf + 6);
+    TEST_ASSERT_EQ(2, s1.len);
+    TEST_ASSERT(s2.ptr == buf);
+    TEST_ASSERT_EQ(3, s2.len);
+
+    memcpy(s1.ptr, "gh", 2);
+    memcpy(s2.ptr, "ijk", 3);
+    // committing more than was free is clamped
+    TEST_ASSERT_EQ(5, ringbuf_commit(&rb, 6));
+    TEST_ASSERT(ringbuf_full(&rb));
+
+    uint8_t out[8] = {0};
+    TEST_ASSERT_EQ(7, ringbuf_pop(&rb, out, sizeof(out)));
+    TEST_ASSERT_MEM_EQ("efghijk", out, 7);
+
+    // full ring has nothing to reserve
+    ringbuf_push(&rb, (uint8_t *)"1234567", 7, RINGBUF_PUSH_DROP);
+    TEST_ASSERT_EQ(0, ringbuf_reserve(&rb, &s1, &s2));
+    TEST_ASSERT_EQ(0, s1.len + s2.len);
+
+    TEST_PASS();
+  }
+#endif
+}
+
 int main(void) {
   TEST_TITLE("ringbuffer tests");
 
@@ -330,6 +461,8 @@ int main(void) {
   test_ringbuf_full();
   test_ringbuf_edge_cases();
   test_ringbuf_large_data();
+  test_ringbuf_peek_spans();
+  test_ringbuf_reserve_commit();
 
   TEST_SUMMARY();
 }
@@ -0,0 +1,188 @@
+//
+// unit tests for the multi-producer ringbuf with concurrent producers
+//
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea.h"
+#include "tiny_nmea/internal/ringbuf.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#if !TINY_NMEA_ENABLE_MULTI_PRODUCER
+#error "test_ringbuf_mpsc must be built with TINY_NMEA_ENABLE_MULTI_PRODUCER=1"
+#endif
+
+#define MPSC_PRODUCERS 4
+#define MPSC_RECORDS 20000
+#define MPSC_RECORD_LEN 8
+
+// give up instead of hanging if a push is lost
+#define MPSC_TIMEOUT_SEC 20
+
+static ringbuf_t rb;
+static uint8_t ring[250];  // not a power of two, records straddle the wrap
+
+typedef struct {
+  uint8_t id;
+} producer_arg_t;
+
+// record is the producer id, a sequence number and a check byte
+static void make_record(uint8_t id, uint32_t seq, uint8_t *rec) {
+  rec[0] = id;
+  memcpy(&rec[1], &seq, sizeof(seq));
+  rec[5] = (uint8_t)(id * 37);
+  rec[6] = (uint8_t)seq;
+  rec[7] = (uint8_t)(id ^ seq ^ (seq >> 8) ^ (seq >> 16) ^ (seq >> 24));
+}
+
+static void *record_producer(void *arg) {
+  const uint8_t id = ((producer_arg_t *)arg)->id;
+  uint8_t rec[MPSC_RECORD_LEN];
+  for (uint32_t seq = 0; seq < MPSC_RECORDS; seq++) {
+    make_record(id, seq, rec);
+    while (ringbuf_push(&rb, rec, sizeof(rec), RINGBUF_PUSH_ATOMIC) == 0) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void test_mpsc_records(void) {
+  TEST_CASE("mpsc concurrent pushes stay whole and ordered") {
+    ringbuf_init(&rb, ring, sizeof(ring));
+
+    pthread_t threads[MPSC_PRODUCERS];
+    producer_arg_t args[MPSC_PRODUCERS];
+    for (uint8_t i = 0; i < MPSC_PRODUCERS; i++) {
+      args[i].id = i;
+      pthread_create(&threads[i], NULL, record_producer, &args[i]);
+    }
+
+    uint32_t expected[MPSC_PRODUCERS] = {0};
+    size_t received = 0;
+    bool bad = false;
+    const time_t start = time(NULL);
+    while (received < (size_t)MPSC_PRODUCERS * MPSC_RECORDS && !bad) {
+      if (ringbuf_len(&rb) < MPSC_RECORD_LEN) {
+        if (time(NULL) - start > MPSC_TIMEOUT_SEC) break;
+        sched_yield();
+        continue;
+      }
+
+      uint8_t rec[MPSC_RECORD_LEN], want[MPSC_RECORD_LEN];
+      ringbuf_pop(&rb, rec, sizeof(rec));
+      if (rec[0] >= MPSC_PRODUCERS) {
+        bad = true;
+        break;
+      }
+      make_record(rec[0], expected[rec[0]]++, want);
+      bad = memcmp(rec, want, sizeof(rec)) != 0;
+      received++;
+    }
+
+    for (size_t i = 0; i < MPSC_PRODUCERS; i++) pthread_join(threads[i], NULL);
+
+    TEST_ASSERT(!bad);
+    TEST_ASSERT_EQ((size_t)MPSC_PRODUCERS * MPSC_RECORDS, received);
+    TEST_ASSERT(ringbuf_empty(&rb));
+    TEST_PASS();
+  }
+}
+
+static tiny_nmea_ctx_t ctx;
+static uint8_t feed_ring[1024];
+static size_t type_count[TINY_NMEA_SENTENCE_COUNT];
+
+static const char *feed_sentences[] = {
+  "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n",
+  "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n",
+  "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n",
+};
+#define FEED_PRODUCERS 3
+#define FEED_SENTENCES 5000
+
+static void on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t st, void *user_data) {
+  (void)st;
+  (void)user_data;
+  type_count[result->type]++;
+}
+
+static void *sentence_producer(void *arg) {
+  const char *sentence = feed_sentences[((producer_arg_t *)arg)->id];
+  const size_t len = strlen(sentence);
+  for (size_t i = 0; i < FEED_SENTENCES; i++) {
+    while (tiny_nmea_feed(&ctx, (const uint8_t *)sentence, len) != TINY_NMEA_OK) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static void test_mpsc_feed(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_VTG
+  TEST_CASE("mpsc concurrent feeds parse cleanly") {
+    memset(type_count, 0, sizeof(type_count));
+    tiny_nmea_init_callbacks(&ctx, feed_ring, sizeof(feed_ring), on_parse, NULL, NULL, NULL);
+
+    pthread_t threads[FEED_PRODUCERS];
+    producer_arg_t args[FEED_PRODUCERS];
+    for (uint8_t i = 0; i < FEED_PRODUCERS; i++) {
+      args[i].id = i;
+      pthread_create(&threads[i], NULL, sentence_producer, &args[i]);
+    }
+
+    const time_t start = time(NULL);
+    while (ctx.stats.sentences_parsed < FEED_PRODUCERS * FEED_SENTENCES &&
+           time(NULL) - start <= MPSC_TIMEOUT_SEC) {
+      tiny_nmea_work(&ctx);
+      sched_yield();
+    }
+
+    for (size_t i = 0; i < FEED_PRODUCERS; i++) pthread_join(threads[i], NULL);
+
+    TEST_ASSERT_EQ(FEED_PRODUCERS * FEED_SENTENCES, ctx.stats.sentences_parsed);
+    TEST_ASSERT_EQ(FEED_SENTENCES, type_count[TINY_NMEA_SENTENCE_RMC]);
+    TEST_ASSERT_EQ(FEED_SENTENCES, type_count[TINY_NMEA_SENTENCE_GGA]);
+    TEST_ASSERT_EQ(FEED_SENTENCES, type_count[TINY_NMEA_SENTENCE_VTG]);
+    TEST_ASSERT_EQ(0, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(0, ctx.stats.parse_errors);
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_mpsc_feed_all_or_nothing(void) {
+  TEST_CASE("mpsc feed never splits a sentence") {
+    uint8_t small[64];
+    tiny_nmea_init(&ctx, small, sizeof(small));
+
+    const char *rmc = feed_sentences[0];
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_BUFFER_FULL, tiny_nmea_feed(&ctx, (const uint8_t *)rmc, strlen(rmc)));
+    TEST_ASSERT_EQ(0, ringbuf_len(&ctx.ringbuf));
+    TEST_PASS();
+  }
+}
+
+static void test_mpsc_init_size(void) {
+  TEST_CASE("mpsc init rejects a ring the indices can not reach") {
+    uint8_t small[64];
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_init(&ctx, small, RINGBUF_MAX_SIZE + 1));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_init(&ctx, small, sizeof(small)));
+    TEST_PASS();
+  }
+}
+
+int main(void) {
+  TEST_TITLE("multi-producer ringbuf tests");
+
+  test_mpsc_records();
+  test_mpsc_feed();
+  test_mpsc_feed_all_or_nothing();
+  test_mpsc_init_size();
+
+  TEST_SUMMARY();
+}
@@ -0,0 +1,210 @@
+//
+// unit tests for the power of two ringbuf with free running indices
+//
+
+#include "test.h"
+#include "tiny_nmea/internal/ringbuf.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if !TINY_NMEA_RINGBUF_POW2
+#error "test_ringbuf_pow2 must be built with TINY_NMEA_RINGBUF_POW2=1"
+#endif
+
+static void test_pow2_init(void) {
+  TEST_CASE("pow2 ringbuf rounds size down") {
+    uint8_t buf[100];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    TEST_ASSERT_EQ(64, rb.size);
+    TEST_ASSERT_EQ(63, rb.mask);
+    TEST_ASSERT_EQ(64, ringbuf_free(&rb));
+
+    ringbuf_init(&rb, buf, 64);
+    TEST_ASSERT_EQ(64, rb.size);
+    TEST_PASS();
+  }
+
+  TEST_CASE("pow2 ringbuf keeps sides on separate lines") {
+    TEST_ASSERT(offsetof(ringbuf_t, head) - offsetof(ringbuf_t, mask) >= TINY_NMEA_CACHE_LINE);
+    TEST_ASSERT(offsetof(ringbuf_t, tail) - offsetof(ringbuf_t, tail_cache) >= TINY_NMEA_CACHE_LINE);
+    TEST_ASSERT(sizeof(ringbuf_t) - offsetof(ringbuf_t, head_cache) >= TINY_NMEA_CACHE_LINE);
+    TEST_PASS();
+  }
+}
+
+static void test_pow2_full_capacity(void) {
+  TEST_CASE("pow2 ringbuf uses every slot") {
+    uint8_t buf[8];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    TEST_ASSERT_EQ(8, ringbuf_push(&rb, (uint8_t *)"abcdefghij", 10, RINGBUF_PUSH_DROP));
+    TEST_ASSERT(ringbuf_full(&rb));
+    TEST_ASSERT(!ringbuf_empty(&rb));
+    TEST_ASSERT_EQ(8, ringbuf_len(&rb));
+    TEST_ASSERT_EQ(0, ringbuf_free(&rb));
+    TEST_ASSERT_EQ(0, ringbuf_push(&rb, (uint8_t *)"x", 1, RINGBUF_PUSH_ATOMIC));
+
+    uint8_t out[8];
+    TEST_ASSERT_EQ(8, ringbuf_pop(&rb, out, sizeof(out)));
+    TEST_ASSERT_MEM_EQ("abcdefgh", out, 8);
+    TEST_ASSERT(ringbuf_empty(&rb));
+    TEST_PASS();
+  }
+
+  TEST_CASE("pow2 ringbuf wrap mode keeps the newest bytes") {
+    uint8_t buf[8];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    ringbuf_push(&rb, (uint8_t *)"abcdef", 6, RINGBUF_PUSH_DROP);
+    TEST_ASSERT_EQ(4, ringbuf_push(&rb, (uint8_t *)"WXYZ", 4, RINGBUF_PUSH_WRAP));
+    uint8_t out[8];
+    TEST_ASSERT_EQ(8, ringbuf_pop(&rb, out, sizeof(out)));
+    TEST_ASSERT_MEM_EQ("cdefWXYZ", out, 8);
+
+    TEST_ASSERT_EQ(8, ringbuf_push(&rb, (uint8_t *)"0123456789", 10, RINGBUF_PUSH_WRAP));
+    TEST_ASSERT_EQ(8, ringbuf_pop(&rb, out, sizeof(out)));
+    TEST_ASSERT_MEM_EQ("23456789", out, 8);
+    TEST_PASS();
+  }
+}
+
+static void test_pow2_index_wrap(void) {
+  // pokes raw indices, with multiple producers head carries a reservation
+  // tag in its upper half and the wrap is far out of reach through the api
+#if !TINY_NMEA_ENABLE_MULTI_PRODUCER
+  TEST_CASE("pow2 ringbuf across the index wrap") {
+    uint8_t buf[16];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    // start both sides just short of the end of the index range
+    const size_t start = SIZE_MAX - 5;
+    atomic_store(&rb.head, start);
+    atomic_store(&rb.tail, start);
+    rb.tail_cache = start;
+    rb.head_cache = start;
+
+    TEST_ASSERT_EQ(12, ringbuf_push(&rb, (uint8_t *)"hello, world", 12, RINGBUF_PUSH_DROP));
+    TEST_ASSERT_EQ(12, ringbuf_len(&rb));
+    TEST_ASSERT_EQ(4, ringbuf_free(&rb));
+
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(12, ringbuf_peek_spans(&rb, &s1, &s2));
+    TEST_ASSERT(s1.ptr == buf + (start & 15));
+    TEST_ASSERT_EQ(6, s1.len);
+    TEST_ASSERT_EQ(6, s2.len);
+
+    uint8_t b;
+    TEST_ASSERT(ringbuf_peek_byte(&rb, 7, &b));
+    TEST_ASSERT_EQ('w', b);
+
+    uint8_t out[12];
+    TEST_ASSERT_EQ(12, ringbuf_pop(&rb, out, sizeof(out)));
+    TEST_ASSERT_MEM_EQ("hello, world", out, 12);
+    TEST_ASSERT(ringbuf_empty(&rb));
+    TEST_ASSERT_EQ(6, atomic_load(&rb.tail));
+    TEST_PASS();
+  }
+#endif
+}
+
+// simple xorshift so the sequence of operations is reproducible
+static uint32_t rng_state = 12345;
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static void test_pow2_model(void) {
+  TEST_CASE("pow2 ringbuf matches a reference queue") {
+    uint8_t buf[64];
+    ringbuf_t rb;
+    ringbuf_init(&rb, buf, sizeof(buf));
+
+    // reference is a plain array, data is a running byte counter
+    static uint8_t model[1 << 20];
+    size_t model_head = 0, model_tail = 0;
+    uint8_t next = 0;
+    bool ok = true;
+
+    for (int op = 0; op < 100000 && ok; op++) {
+      const size_t n = rng() % 70;
+      uint8_t tmp[70];
+      switch (rng() % 4) {
+        case 0: {
+          for (size_t i = 0; i < n; i++) tmp[i] = (uint8_t)(next + i);
+          const size_t w = ringbuf_push(&rb, tmp, n, RINGBUF_PUSH_DROP);
+          ok = w == (n < 64 - (model_head - model_tail) ? n : 64 - (model_head - model_tail));
+          memcpy(model + model_head, tmp, w);
+          model_head += w;
+          next = (uint8_t)(next + w);
+          break;
+        }
+        case 1: {
+          ringbuf_span_t s1, s2;
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+          // no direct writes with multiple producers
+          ok = ringbuf_reserve(&rb, &s1, &s2) == 0;
+#else
+          const size_t free_space = ringbuf_reserve(&rb, &s1, &s2);
+          ok = free_space == 64 - (model_head - model_tail) && s1.len + s2.len == free_space;
+          const size_t w = n < free_space ? n : free_space;
+          for (size_t i = 0; i < w; i++) {
+            const uint8_t v = (uint8_t)(next + i);
+            if (i < s1.len) s1.ptr[i] = v; else s2.ptr[i - s1.len] = v;
+            model[model_head + i] = v;
+          }
+          ok = ok && ringbuf_commit(&rb, w) == w;
+          model_head += w;
+          next = (uint8_t)(next + w);
+#endif
+          break;
+        }
+        case 2: {
+          const size_t r = ringbuf_pop(&rb, tmp, n);
+          const size_t avail = model_head - model_tail;
+          ok = r == (n < avail ? n : avail) && memcmp(tmp, model + model_tail, r) == 0;
+          model_tail += r;
+          break;
+        }
+        default: {
+          ringbuf_span_t s1, s2;
+          const size_t avail = ringbuf_peek_spans(&rb, &s1, &s2);
+          ok = avail == model_head - model_tail &&
+               memcmp(s1.ptr, model + model_tail, s1.len) == 0 &&
+               memcmp(s2.ptr, model + model_tail + s1.len, s2.len) == 0;
+          model_tail += ringbuf_discard(&rb, n);
+          break;
+        }
+      }
+      if (model_head + 128 > sizeof(model)) {
+        // move the reference back to the start
+        memmove(model, model + model_tail, model_head - model_tail);
+        model_head -= model_tail;
+        model_tail = 0;
+      }
+    }
+
+    TEST_ASSERT(ok);
+    TEST_ASSERT_EQ(model_head - model_tail, ringbuf_len(&rb));
+    TEST_PASS();
+  }
+}
+
+int main(void) {
+  TEST_TITLE("power of two ringbuffer tests");
+
+  test_pow2_init();
+  test_pow2_full_capacity();
+  test_pow2_index_wrap();
+  test_pow2_model();
+
+  TEST_SUMMARY();
+}
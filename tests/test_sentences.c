@@ -5,12 +5,14 @@
 #include "test.h"
 #include "tiny_nmea/tiny_nmea.h"
 #include "tiny_nmea/internal/sentences.h"
+#include "tiny_nmea/internal/sentence_schema.h"
 
 #include <math.h>
 #include <string.h>
 
 // RMC tests
 
+#if TINY_NMEA_ENABLE_RMC
 static void test_parse_rmc(void) {
   TEST_CASE("parse RMC basic") {
     const char *sentence = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W";
@@ -62,9 +64,11 @@ static void test_parse_rmc(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // GGA tests
 
+#if TINY_NMEA_ENABLE_GGA
 static void test_parse_gga(void) {
   TEST_CASE("parse GGA basic") {
     const char *sentence = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,";
@@ -112,9 +116,11 @@ static void test_parse_gga(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // GSA tests
 
+#if TINY_NMEA_ENABLE_GSA
 static void test_parse_gsa(void) {
   TEST_CASE("parse GSA 3D fix") {
     const char *sentence = "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1";
@@ -166,9 +172,11 @@ static void test_parse_gsa(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // GSV tests
 
+#if TINY_NMEA_ENABLE_GSV
 static void test_parse_gsv(void) {
   TEST_CASE("parse GSV first message") {
     const char *sentence = "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00";
@@ -223,9 +231,11 @@ static void test_parse_gsv(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // VTG tests
 
+#if TINY_NMEA_ENABLE_VTG
 static void test_parse_vtg(void) {
   TEST_CASE("parse VTG basic") {
     const char *sentence = "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K";
@@ -267,9 +277,11 @@ static void test_parse_vtg(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // GLL tests
 
+#if TINY_NMEA_ENABLE_GLL
 static void test_parse_gll(void) {
   TEST_CASE("parse GLL basic") {
     const char *sentence = "$GPGLL,4916.45,N,12311.12,W,225444,A";
@@ -307,9 +319,11 @@ static void test_parse_gll(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // ZDA tests
 
+#if TINY_NMEA_ENABLE_ZDA
 static void test_parse_zda(void) {
   TEST_CASE("parse ZDA basic") {
     const char *sentence = "$GPZDA,160012.71,11,03,2004,-1,00";
@@ -345,9 +359,11 @@ static void test_parse_zda(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // GBS tests
 
+#if TINY_NMEA_ENABLE_GBS
 static void test_parse_gbs(void) {
   TEST_CASE("parse GBS basic") {
     const char *sentence = "$GPGBS,235503.00,1.6,1.4,3.2,03,,-21.4,3.8";
@@ -365,9 +381,11 @@ static void test_parse_gbs(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // GST tests
 
+#if TINY_NMEA_ENABLE_GST
 static void test_parse_gst(void) {
   TEST_CASE("parse GST basic") {
     const char *sentence = "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031";
@@ -385,10 +403,13 @@ static void test_parse_gst(void) {
     TEST_PASS();
   }
 }
+#endif
 
 // AIS tests
 
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
 static void test_parse_ais(void) {
+#if TINY_NMEA_ENABLE_VDM
   TEST_CASE("parse VDM basic") {
     const char *sentence = "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0";
     tiny_nmea_type_t result = {0};
@@ -405,7 +426,9 @@ static void test_parse_ais(void) {
 
     TEST_PASS();
   }
+#endif
 
+#if TINY_NMEA_ENABLE_VDM
   TEST_CASE("parse VDM multipart") {
     const char *sentence = "!AIVDM,2,1,3,B,55?MbV02>H97ac<H4eEK6@T4@Dn2222220j1p>1240Ht50,0";
     tiny_nmea_type_t result = {0};
@@ -417,7 +440,9 @@ static void test_parse_ais(void) {
 
     TEST_PASS();
   }
+#endif
 
+#if TINY_NMEA_ENABLE_VDO
   TEST_CASE("parse VDO") {
     const char *sentence = "!AIVDO,1,1,,A,1P000000000000000000000,0";
     tiny_nmea_type_t result = {0};
@@ -427,7 +452,9 @@ static void test_parse_ais(void) {
 
     TEST_PASS();
   }
+#endif
 }
+#endif
 
 // error handling tests
 
@@ -450,6 +477,7 @@ static void test_parse_errors(void) {
     TEST_PASS();
   }
 
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("parse too few fields RMC") {
     const char *sentence = "$GPRMC,123519,A,4807.038,N";
     tiny_nmea_type_t result = {0};
@@ -458,7 +486,9 @@ static void test_parse_errors(void) {
 
     TEST_PASS();
   }
+#endif
 
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("parse too few fields GGA") {
     const char *sentence = "$GPGGA,123519,4807.038,N";
     tiny_nmea_type_t result = {0};
@@ -467,11 +497,13 @@ static void test_parse_errors(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // multi-constellation tests
 
 static void test_multi_constellation(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("parse GN combined talker") {
     const char *sentence = "$GNRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W";
     tiny_nmea_type_t result = {0};
@@ -481,7 +513,9 @@ static void test_multi_constellation(void) {
 
     TEST_PASS();
   }
+#endif
 
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("parse GA Galileo") {
     const char *sentence = "$GAGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,";
     tiny_nmea_type_t result = {0};
@@ -491,7 +525,9 @@ static void test_multi_constellation(void) {
 
     TEST_PASS();
   }
+#endif
 
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("parse GB BeiDou") {
     const char *sentence = "$GBGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,";
     tiny_nmea_type_t result = {0};
@@ -501,23 +537,213 @@ static void test_multi_constellation(void) {
 
     TEST_PASS();
   }
+#endif
+}
+
+// schema tests, a made up proprietary heading sentence
+
+typedef struct {
+  tiny_nmea_time_t time;
+  tiny_nmea_float_t heading_deg;
+  uint8_t quality;
+} test_hdg_t;
+
+#define TEST_HDG_SCHEMA(X, T)                      \
+    X(T, 0, TIME,  time,        REQUIRED)          \
+    X(T, 1, FLOAT, heading_deg, OPTIONAL)          \
+    X(T, 2, U8,    quality,     OPTIONAL)
+
+TINY_NMEA_DEFINE_SCHEMA(test_hdg_schema, test_hdg_t, TEST_HDG_SCHEMA, 2, 3, NULL);
+
+// same fields listed out of order, rejected by the single pass decoder
+#define TEST_HDG_UNSORTED_SCHEMA(X, T)             \
+    X(T, 1, FLOAT, heading_deg, OPTIONAL)          \
+    X(T, 0, TIME,  time,        REQUIRED)
+
+TINY_NMEA_DEFINE_SCHEMA(test_hdg_unsorted_schema, test_hdg_t, TEST_HDG_UNSORTED_SCHEMA, 2, 3, NULL);
+
+static void test_parse_schema(void) {
+  TEST_CASE("parse custom schema") {
+    const char *fields = "123519,271.5,4";
+    test_hdg_t out;
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, handle_parse_schema(&test_hdg_schema, fields, strlen(fields), &out));
+    TEST_ASSERT_EQ(35, out.time.minutes);
+    TEST_ASSERT_EQ(2715, out.heading_deg.value);
+    TEST_ASSERT_EQ(10, out.heading_deg.scale);
+    TEST_ASSERT_EQ(4, out.quality);
+
+    TEST_PASS();
+  }
+
+  TEST_CASE("parse custom schema optional trailing field") {
+    const char *fields = "123519,";
+    test_hdg_t out;
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, handle_parse_schema(&test_hdg_schema, fields, strlen(fields), &out));
+    TEST_ASSERT_EQ(0, out.heading_deg.value);
+    TEST_ASSERT_EQ(0, out.quality);
+
+    TEST_PASS();
+  }
+
+  TEST_CASE("parse custom schema errors") {
+    test_hdg_t out;
+
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_INVALID_TIME, handle_parse_schema(&test_hdg_schema, "12x519,1.0", 10, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TOO_FEW_FIELDS, handle_parse_schema(&test_hdg_schema, "123519", 6, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_NULL_PTR, handle_parse_schema(NULL, "123519", 6, &out));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS,
+                   handle_parse_schema(&test_hdg_unsorted_schema, "123519,1.0", 10, &out));
+
+    TEST_PASS();
+  }
+}
+
+// lazy decoding tests
+
+static void test_lazy_fields(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("lazy RMC decodes on access") {
+    const char *sentence = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W";
+    tiny_nmea_lazy_t lazy = {0};
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_lazy_parse(sentence, strlen(sentence), &lazy));
+    TEST_ASSERT_EQ(TINY_NMEA_TALKER_GP, lazy.talker);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_RMC, lazy.type);
+    TEST_ASSERT_EQ(0, lazy.decoded);
+
+    tiny_nmea_coord_t lat;
+    TEST_ASSERT(tiny_nmea_lazy_latitude(&lazy, &lat));
+    TEST_ASSERT_EQ('N', lat.hemisphere);
+    TEST_ASSERT_EQ(4807038, lat.raw.value);
+    TEST_ASSERT_EQ(1u << TINY_NMEA_LAZY_LATITUDE, lazy.decoded);
+
+    tiny_nmea_float_t speed;
+    bool status = false;
+    TEST_ASSERT(tiny_nmea_lazy_speed_knots(&lazy, &speed));
+    TEST_ASSERT_EQ(224, speed.value);
+    TEST_ASSERT(tiny_nmea_lazy_status(&lazy, &status));
+    TEST_ASSERT(status);
+
+    // not carried by RMC
+    uint8_t sats;
+    TEST_ASSERT(!tiny_nmea_lazy_has(&lazy, TINY_NMEA_LAZY_SATELLITES));
+    TEST_ASSERT(!tiny_nmea_lazy_satellites(&lazy, &sats));
+
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_GGA
+  TEST_CASE("lazy GGA empty and invalid fields") {
+    const char *sentence = "$GPGGA,123519,,,,,0,xx,,,M,,M,,";
+    tiny_nmea_lazy_t lazy = {0};
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_lazy_parse(sentence, strlen(sentence), &lazy));
+
+    tiny_nmea_time_t time;
+    tiny_nmea_coord_t lon;
+    tiny_nmea_fix_quality_t fix;
+    uint8_t sats;
+    TEST_ASSERT(tiny_nmea_lazy_time(&lazy, &time));
+    TEST_ASSERT_EQ(35, time.minutes);
+    TEST_ASSERT(!tiny_nmea_lazy_longitude(&lazy, &lon));
+    TEST_ASSERT(tiny_nmea_lazy_fix_quality(&lazy, &fix));
+    TEST_ASSERT_EQ(TINY_NMEA_FIX_INVALID, fix);
+    TEST_ASSERT(!tiny_nmea_lazy_satellites(&lazy, &sats));
+
+    // failures are cached as well
+    TEST_ASSERT(lazy.decoded & (1u << TINY_NMEA_LAZY_SATELLITES));
+    TEST_ASSERT(!(lazy.valid & (1u << TINY_NMEA_LAZY_SATELLITES)));
+
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_ZDA
+  TEST_CASE("lazy ZDA date") {
+    const char *sentence = "$GPZDA,120000.00,15,01,2025,00,00";
+    tiny_nmea_lazy_t lazy = {0};
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_lazy_parse(sentence, strlen(sentence), &lazy));
+
+    tiny_nmea_date_t date;
+    TEST_ASSERT(tiny_nmea_lazy_date(&lazy, &date));
+    TEST_ASSERT_EQ(15, date.day);
+    TEST_ASSERT_EQ(1, date.month);
+    TEST_ASSERT_EQ(2025, date.year);
+
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_GGA
+  TEST_CASE("lazy decode all matches eager parse") {
+    const char *sentence = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,";
+    tiny_nmea_lazy_t lazy = {0};
+    tiny_nmea_type_t eager = {0};
+    tiny_nmea_type_t full = {0};
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_lazy_parse(sentence, strlen(sentence), &lazy));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_lazy_decode_all(&lazy, &full));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse(sentence, &eager));
+    TEST_ASSERT_EQ(eager.data.gga.satellites_used, full.data.gga.satellites_used);
+    TEST_ASSERT_EQ(eager.data.gga.altitude_m.value, full.data.gga.altitude_m.value);
+
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("lazy too few fields") {
+    const char *sentence = "$GPRMC,123519,A,4807.038,N";
+    tiny_nmea_lazy_t lazy = {0};
+
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TOO_FEW_FIELDS, tiny_nmea_lazy_parse(sentence, strlen(sentence), &lazy));
+
+    TEST_PASS();
+  }
+#endif
 }
 
 int main(void) {
   TEST_TITLE("sentence parsing tests");
 
+#if TINY_NMEA_ENABLE_RMC
   test_parse_rmc();
+#endif
+#if TINY_NMEA_ENABLE_GGA
   test_parse_gga();
+#endif
+#if TINY_NMEA_ENABLE_GSA
   test_parse_gsa();
+#endif
+#if TINY_NMEA_ENABLE_GSV
   test_parse_gsv();
+#endif
+#if TINY_NMEA_ENABLE_VTG
   test_parse_vtg();
+#endif
+#if TINY_NMEA_ENABLE_GLL
   test_parse_gll();
+#endif
+#if TINY_NMEA_ENABLE_ZDA
   test_parse_zda();
+#endif
+#if TINY_NMEA_ENABLE_GBS
   test_parse_gbs();
+#endif
+#if TINY_NMEA_ENABLE_GST
   test_parse_gst();
+#endif
+#if TINY_NMEA_ENABLE_VDM || TINY_NMEA_ENABLE_VDO
   test_parse_ais();
+#endif
   test_parse_errors();
   test_multi_constellation();
+  test_parse_schema();
+  test_lazy_fields();
 
   TEST_SUMMARY();
 }
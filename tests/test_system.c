@@ -4,6 +4,7 @@
 
 #include "test.h"
 #include "tiny_nmea/tiny_nmea.h"
+#include "tiny_nmea/internal/ringbuf.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -56,6 +57,7 @@ static void test_system_init(void) {
 }
 
 static void test_system_single_sentence(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("system single sentence") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -71,9 +73,11 @@ static void test_system_single_sentence(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_multiple_sentences(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSA
   TEST_CASE("system multiple sentences") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -92,9 +96,11 @@ static void test_system_multiple_sentences(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_incremental_feed(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system incremental feed") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -113,9 +119,11 @@ static void test_system_incremental_feed(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_chunked_feed(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("system chunked feed") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -143,11 +151,13 @@ static void test_system_chunked_feed(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // checksum tests
 
 static void test_system_checksum_valid(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("system valid checksum") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -161,9 +171,11 @@ static void test_system_checksum_valid(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_checksum_invalid(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("system invalid checksum") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -178,9 +190,70 @@ static void test_system_checksum_invalid(void) {
 
     TEST_PASS();
   }
+#endif
+
+#if TINY_NMEA_ENABLE_GLL
+  TEST_CASE("system invalid checksum keeps the next sentence") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+
+    // all lines land in the window at once, only the bad ones are dropped
+    const char *data =
+      "$GPGLL,4916.45,N,12311.12,W,225444,A*FF\r\n"
+      "$GPGLL,4916.45,N,12311.12,W,225444,A*3G\r\n"
+      "$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n";
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    TEST_ASSERT_EQ(1, parse_callback_count);
+    TEST_ASSERT_EQ(1, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(1, ctx.stats.parse_errors);
+
+    // same result whatever the feed size
+    for (size_t chunk = 1; chunk < 40; chunk += 7) {
+      reset_test_state();
+      tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+      for (size_t off = 0; off < strlen(data); off += chunk) {
+        size_t n = strlen(data) - off < chunk ? strlen(data) - off : chunk;
+        tiny_nmea_feed(&ctx, (const uint8_t *)&data[off], n);
+        tiny_nmea_work(&ctx);
+      }
+      TEST_ASSERT_EQ(1, parse_callback_count);
+      TEST_ASSERT_EQ(1, ctx.stats.checksum_errors);
+      TEST_ASSERT_EQ(1, ctx.stats.parse_errors);
+    }
+
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_system_checksum_incremental(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("system checksum folded across feeds") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+
+    // byte by byte, every work call only sees one new byte
+    const char *sentence = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*FF\r\n";
+    size_t len = strlen(sentence);
+    for (size_t i = 0; i < len; i++) {
+      tiny_nmea_feed(&ctx, (const uint8_t *)&sentence[i], 1);
+      tiny_nmea_work(&ctx);
+    }
+
+    TEST_ASSERT_EQ(0, parse_callback_count);
+    TEST_ASSERT_EQ(1, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(0x6A, ctx.computed_checksum);
+    TEST_ASSERT_EQ(0xFF, ctx.received_checksum);
+
+    TEST_PASS();
+  }
+#endif
 }
 
 static void test_system_no_checksum(void) {
+#if TINY_NMEA_ENABLE_RMC
   TEST_CASE("system sentence without checksum") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -194,11 +267,13 @@ static void test_system_no_checksum(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // line ending tests
 
 static void test_system_crlf(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system CRLF line ending") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -211,9 +286,11 @@ static void test_system_crlf(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_lf_only(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system LF only line ending") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -226,9 +303,11 @@ static void test_system_lf_only(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_cr_only(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system CR only line ending") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -241,11 +320,13 @@ static void test_system_cr_only(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // garbage handling tests
 
 static void test_system_garbage_before(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system garbage before sentence") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -259,9 +340,11 @@ static void test_system_garbage_before(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_garbage_between(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA
   TEST_CASE("system garbage between sentences") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -278,9 +361,11 @@ static void test_system_garbage_between(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_partial_sentence(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system partial sentence discarded") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -304,11 +389,13 @@ static void test_system_partial_sentence(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // AIS (exclamation start) tests
 
 static void test_system_ais_sentence(void) {
+#if TINY_NMEA_ENABLE_VDM
   TEST_CASE("system AIS sentence") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -323,9 +410,11 @@ static void test_system_ais_sentence(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_mixed_nmea_ais(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_VDM
   TEST_CASE("system mixed NMEA and AIS") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -342,11 +431,13 @@ static void test_system_mixed_nmea_ais(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // statistics tests
 
 static void test_system_statistics(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSA
   TEST_CASE("system statistics tracking") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -372,9 +463,11 @@ static void test_system_statistics(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 static void test_system_reset_stats(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system reset statistics") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -397,11 +490,26 @@ static void test_system_reset_stats(void) {
 
     TEST_PASS();
   }
+#endif
+
+#if !TINY_NMEA_ENABLE_INSTRUMENTATION
+  TEST_CASE("system instrumentation unsupported when compiled out") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+
+    tiny_nmea_instrumentation_t instr;
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_UNSUPPORTED, tiny_nmea_get_instrumentation(&ctx, &instr));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_UNSUPPORTED, tiny_nmea_reset_instrumentation(&ctx));
+
+    TEST_PASS();
+  }
+#endif
 }
 
 // century tracking tests
 
 static void test_system_century_from_zda(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_ZDA
   TEST_CASE("system century from ZDA") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -422,11 +530,13 @@ static void test_system_century_from_zda(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // buffer tests
 
 static void test_system_small_buffer(void) {
+#if TINY_NMEA_ENABLE_GGA
   TEST_CASE("system small ring buffer") {
     reset_test_state();
     uint8_t small_buf[128];
@@ -440,11 +550,13 @@ static void test_system_small_buffer(void) {
 
     TEST_PASS();
   }
+#endif
 }
 
 // real-world data simulation
 
 static void test_system_gps_burst(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSA && TINY_NMEA_ENABLE_GSV && TINY_NMEA_ENABLE_VTG && TINY_NMEA_ENABLE_GLL
   TEST_CASE("system GPS burst simulation") {
     reset_test_state();
     tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
@@ -469,6 +581,468 @@ static void test_system_gps_burst(void) {
 
     TEST_PASS();
   }
+#endif
+}
+
+// in-place framing tests
+
+static void test_system_feed_reserve(void) {
+#if TINY_NMEA_ENABLE_MULTI_PRODUCER
+  TEST_CASE("system zero-copy feed unavailable with multiple producers") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_UNSUPPORTED, tiny_nmea_feed_reserve(&ctx, &s1, &s2));
+    TEST_PASS();
+  }
+#elif TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA
+  TEST_CASE("system zero-copy feed reserve and commit") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+
+    const char *data =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+    const size_t len = strlen(data);
+
+    // receive in small reads, like read() would, so the ring wraps
+    for (int round = 0; round < 10; round++) {
+      size_t off = 0;
+      while (off < len) {
+        ringbuf_span_t s1, s2;
+        TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed_reserve(&ctx, &s1, &s2));
+        size_t n = len - off < 50 ? len - off : 50;
+        if (n > s1.len) n = s1.len;
+        memcpy(s1.ptr, data + off, n);
+        TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed_commit(&ctx, n));
+        off += n;
+      }
+      tiny_nmea_work(&ctx);
+    }
+
+    TEST_ASSERT_EQ(20, parse_callback_count);
+    TEST_ASSERT_EQ(0, error_callback_count);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GGA, last_result.type);
+
+    // a commit past the free space is refused
+    ringbuf_span_t s1, s2;
+    tiny_nmea_feed_reserve(&ctx, &s1, &s2);
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_feed_commit(&ctx, s1.len + s2.len + 1));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_feed_reserve(&ctx, NULL, &s2));
+
+    TEST_PASS();
+  }
+#endif
+}
+
+static size_t feed_callback_count;
+static size_t feed_callback_len;
+
+static void on_feed(const ringbuf_t *ringbuf, void *user_data) {
+  (void)user_data;
+  feed_callback_count++;
+  feed_callback_len = ringbuf_len(ringbuf);
+}
+
+static void test_system_feed_callback(void) {
+  TEST_CASE("system feed callback") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    feed_callback_count = 0;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_set_feed_callback(&ctx, on_feed, NULL));
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed(&ctx, (const uint8_t *)"$GPRMC,", 7));
+    TEST_ASSERT_EQ(1, feed_callback_count);
+    TEST_ASSERT_EQ(7, feed_callback_len);
+
+    // nothing landed, nothing to notify
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed(&ctx, (const uint8_t *)"", 0));
+    TEST_ASSERT_EQ(1, feed_callback_count);
+
+#if !TINY_NMEA_ENABLE_MULTI_PRODUCER
+    ringbuf_span_t s1, s2;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed_reserve(&ctx, &s1, &s2));
+    memcpy(s1.ptr, "123519", 6);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed_commit(&ctx, 6));
+    TEST_ASSERT_EQ(2, feed_callback_count);
+    TEST_ASSERT_EQ(13, feed_callback_len);
+#endif
+
+    tiny_nmea_set_feed_callback(&ctx, NULL, NULL);
+    tiny_nmea_feed(&ctx, (const uint8_t *)",A", 2);
+    TEST_ASSERT(feed_callback_count <= 2);
+
+    TEST_PASS();
+  }
+}
+
+static void test_system_in_place_burst(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_VDM
+  TEST_CASE("system in-place framing burst") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_set_framing_mode(&ctx, TINY_NMEA_FRAMING_IN_PLACE));
+
+    const char *data =
+      "garbage$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+      "!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n"
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*FF\r\n";
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    TEST_ASSERT_EQ(3, parse_callback_count);
+    TEST_ASSERT_EQ(1, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_VDM, last_result.type);
+
+    // every consumed byte is released back to the ringbuf
+    TEST_ASSERT_EQ(0, ringbuf_len(&ctx.ringbuf));
+
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_system_in_place_wrap(void) {
+#if TINY_NMEA_ENABLE_GGA
+  TEST_CASE("system in-place framing across ring wrap") {
+    reset_test_state();
+    uint8_t small_buf[128];
+    tiny_nmea_init_callbacks(&ctx, small_buf, sizeof(small_buf), on_parse, NULL, on_error, NULL);
+    tiny_nmea_set_framing_mode(&ctx, TINY_NMEA_FRAMING_IN_PLACE);
+
+    // 67 byte sentence in a 128 byte ring lands on every wrap offset eventually
+    const char *sentence = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+    size_t len = strlen(sentence);
+    size_t chunks[] = {1, 7, 13, 29, 67};
+
+    for (int i = 0; i < 50; i++) {
+      size_t pos = 0;
+      size_t chunk = chunks[i % 5];
+      while (pos < len) {
+        size_t n = (len - pos < chunk) ? len - pos : chunk;
+        TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_feed(&ctx, (const uint8_t *)sentence + pos, n));
+        tiny_nmea_work(&ctx);
+        pos += n;
+      }
+    }
+
+    TEST_ASSERT_EQ(50, parse_callback_count);
+    TEST_ASSERT_EQ(0, error_callback_count);
+    TEST_ASSERT_EQ(0, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(545, last_result.data.gga.altitude_m.value / last_result.data.gga.altitude_m.scale);
+
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_system_in_place_overlong(void) {
+#if TINY_NMEA_ENABLE_GGA
+  TEST_CASE("system in-place framing overlong sentence") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    tiny_nmea_set_framing_mode(&ctx, TINY_NMEA_FRAMING_IN_PLACE);
+
+    // no line end within the max sentence length, then a valid sentence
+    char data[300];
+    strcpy(data, "$GPGGA,");
+    for (int i = 0; i < 120; i++) {
+      data[7 + i] = '0';
+    }
+    strcpy(data + 127, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n");
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    TEST_ASSERT(ctx.stats.buffer_overflows > 0);
+    TEST_ASSERT_EQ(1, parse_callback_count);
+
+    TEST_PASS();
+  }
+#endif
+}
+
+// batch callback tests
+
+static size_t batch_calls = 0;
+static size_t batch_total = 0;
+static tiny_nmea_sentence_type_t batch_types[8];
+static uint32_t batch_last_parsed = 0;
+
+static void on_batch(const tiny_nmea_type_t *results, size_t count,
+                     const tiny_nmea_parser_statistics_t *st, void *user_data) {
+  (void)user_data;
+  for (size_t i = 0; i < count && batch_total + i < 8; i++) {
+    batch_types[batch_total + i] = results[i].type;
+  }
+  batch_calls++;
+  batch_total += count;
+  batch_last_parsed = st->sentences_parsed;
+}
+
+static void test_system_batch_callback(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSA
+  TEST_CASE("system batch callback") {
+    reset_test_state();
+    batch_calls = 0;
+    batch_total = 0;
+    tiny_nmea_type_t results[8];
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_set_batch_callback(&ctx, results, 8, on_batch, NULL));
+
+    const char *data =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+      "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n";
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    // one batch for the whole work call, parse callback bypassed
+    TEST_ASSERT_EQ(1, batch_calls);
+    TEST_ASSERT_EQ(3, batch_total);
+    TEST_ASSERT_EQ(0, parse_callback_count);
+    TEST_ASSERT_EQ(3, batch_last_parsed);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_RMC, batch_types[0]);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GGA, batch_types[1]);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GSA, batch_types[2]);
+
+    // nothing parsed, no empty batch
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(1, batch_calls);
+
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSA
+  TEST_CASE("system batch callback flushes when full") {
+    reset_test_state();
+    batch_calls = 0;
+    batch_total = 0;
+    tiny_nmea_type_t results[2];
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    tiny_nmea_set_batch_callback(&ctx, results, 2, on_batch, NULL);
+
+    const char *data =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+      "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39\r\n";
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    TEST_ASSERT_EQ(2, batch_calls);
+    TEST_ASSERT_EQ(3, batch_total);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GSA, batch_types[2]);
+
+    // disabling batch mode goes back to per sentence callbacks
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_set_batch_callback(&ctx, NULL, 0, on_batch, NULL));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_set_batch_callback(&ctx, NULL, 0, NULL, NULL));
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(3, parse_callback_count);
+
+    TEST_PASS();
+  }
+#endif
+}
+
+// lazy callback reads a few fields and leaves the rest undecoded
+static size_t lazy_calls = 0;
+static uint16_t lazy_last_year = 0;
+static int32_t lazy_last_alt = 0;
+static uint16_t lazy_last_decoded = 0;
+
+static void on_lazy(tiny_nmea_lazy_t *result, tiny_nmea_parser_statistics_t st, void *user_data) {
+  (void)st;
+  (void)user_data;
+  lazy_calls++;
+
+  tiny_nmea_date_t date;
+  tiny_nmea_float_t alt;
+  if (result->type == TINY_NMEA_SENTENCE_RMC && tiny_nmea_lazy_date(result, &date)) {
+    lazy_last_year = date.year;
+  }
+  if (result->type == TINY_NMEA_SENTENCE_GGA && tiny_nmea_lazy_altitude(result, &alt)) {
+    lazy_last_alt = alt.value;
+  }
+  lazy_last_decoded = result->decoded;
+}
+
+static void test_system_lazy_callback(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_ZDA
+  TEST_CASE("system lazy callback") {
+    reset_test_state();
+    lazy_calls = 0;
+    lazy_last_year = 0;
+    lazy_last_alt = 0;
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_set_lazy_callback(&ctx, on_lazy, NULL));
+
+    const char *data =
+      "$GPZDA,120000.00,15,01,2025,00,00*65\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPRMC,123519,A,4807.038,N\r\n";
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    // parse callback bypassed, too few fields still reported as an error
+    TEST_ASSERT_EQ(3, lazy_calls);
+    TEST_ASSERT_EQ(0, parse_callback_count);
+    TEST_ASSERT_EQ(3, ctx.stats.sentences_parsed);
+    TEST_ASSERT_EQ(1, ctx.stats.parse_errors);
+    TEST_ASSERT_EQ(1, error_callback_count);
+
+    // century from ZDA still applies to the lazily decoded RMC date
+    TEST_ASSERT_EQ(2094, lazy_last_year);
+    TEST_ASSERT_EQ(5454, lazy_last_alt);
+    TEST_ASSERT_EQ(1u << TINY_NMEA_LAZY_DATE, lazy_last_decoded);
+
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_system_sentence_filter(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSA && TINY_NMEA_ENABLE_GSV
+  TEST_CASE("system sentence filter") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_set_sentence_filter(&ctx,
+      TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_RMC) | TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_GGA)));
+
+    // filtered sentences are dropped before the checksum is checked
+    const char *data =
+      "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*FF\r\n"
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+      "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)data, strlen(data));
+    tiny_nmea_work(&ctx);
+
+    TEST_ASSERT_EQ(2, parse_callback_count);
+    TEST_ASSERT_EQ(2, ctx.stats.sentences_filtered);
+    TEST_ASSERT_EQ(0, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_GGA, last_result.type);
+
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GSV
+  TEST_CASE("system sentence filter chunked and cut short") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    tiny_nmea_set_sentence_filter(&ctx, TINY_NMEA_SENTENCE_BIT(TINY_NMEA_SENTENCE_RMC));
+
+    // gsv cut short by the next start char
+    const char *data =
+      "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n"
+      "$GPGSV,2,2,08,15,30,050,47,19"
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n";
+
+    size_t len = strlen(data);
+    for (size_t i = 0; i < len; i += 5) {
+      size_t chunk = (len - i < 5) ? len - i : 5;
+      tiny_nmea_feed(&ctx, (const uint8_t *)data + i, chunk);
+      tiny_nmea_work(&ctx);
+    }
+
+    TEST_ASSERT_EQ(1, parse_callback_count);
+    TEST_ASSERT_EQ(2, ctx.stats.sentences_filtered);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_RMC, last_result.type);
+
+    TEST_PASS();
+  }
+#endif
+}
+
+// in-place buffer parsing
+
+static void test_system_parse_buffer(void) {
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_ZDA
+  TEST_CASE("system parse buffer") {
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+
+    const char *data =
+      "garbage$GPZDA,120000.00,15,01,2025,00,00*65\r\n"
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n"
+      "$GPRMC,120001,A,4807.038,N,01131.000,E,022.4,084.4,150125,003.1,W*68\r\n"
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6B\r\n"
+      "$GPGGA,123519,4807.038,N,01131.0";
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse_buffer(&ctx, (const uint8_t *)data, strlen(data)));
+    TEST_ASSERT_EQ(3, parse_callback_count);
+    TEST_ASSERT_EQ(1, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(TINY_NMEA_SENTENCE_RMC, last_result.type);
+    TEST_ASSERT_EQ(2025, last_result.data.rmc.date.year);
+
+    // the ringbuf was never used and the cut off tail is gone
+    TEST_ASSERT_EQ(0, ringbuf_len(&ctx.ringbuf));
+    TEST_ASSERT_EQ(0, ctx.window_len);
+    TEST_ASSERT(ctx.src == NULL);
+
+    // feeding afterwards carries on normally
+    const char *gga = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*4F\r\n";
+    tiny_nmea_feed(&ctx, (const uint8_t *)gga, strlen(gga));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(4, parse_callback_count);
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_parse_buffer(&ctx, NULL, 0));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_parse_buffer(&ctx, NULL, 1));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_parse_buffer(NULL, (const uint8_t *)gga, 1));
+    TEST_PASS();
+  }
+#endif
+
+#if TINY_NMEA_ENABLE_RMC && TINY_NMEA_ENABLE_GGA && TINY_NMEA_ENABLE_GSV && TINY_NMEA_ENABLE_GLL && TINY_NMEA_ENABLE_VDM
+  TEST_CASE("system parse buffer matches feed and work") {
+    // long enough to need many window refills
+    char data[4096];
+    size_t len = 0;
+    const char *lines[] = {
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n",
+      "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75\r\n",
+      "!AIVDM,1,1,,A,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A\r\n",
+      "$GPGLL,4916.45,N,12311.12,W,225444,A*31\r\n",
+      "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,47.0,M,,*00\r\n",
+    };
+    for (size_t i = 0; len + 100 < sizeof(data); i++) {
+      const char *l = lines[i % 5];
+      memcpy(&data[len], l, strlen(l));
+      len += strlen(l);
+    }
+
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    for (size_t off = 0; off < len; off += 100) {
+      size_t n = len - off < 100 ? len - off : 100;
+      tiny_nmea_feed(&ctx, (const uint8_t *)&data[off], n);
+      tiny_nmea_work(&ctx);
+    }
+    tiny_nmea_parser_statistics_t fed = ctx.stats;
+    int fed_count = parse_callback_count;
+
+    reset_test_state();
+    tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, on_error, NULL);
+    tiny_nmea_parse_buffer(&ctx, (const uint8_t *)data, len);
+
+    TEST_ASSERT(fed_count > 40);
+    TEST_ASSERT_EQ(fed_count, parse_callback_count);
+    TEST_ASSERT_EQ(fed.sentences_parsed, ctx.stats.sentences_parsed);
+    TEST_ASSERT_EQ(fed.checksum_errors, ctx.stats.checksum_errors);
+    TEST_ASSERT_EQ(fed.parse_errors, ctx.stats.parse_errors);
+    TEST_PASS();
+  }
+#endif
 }
 
 int main(void) {
@@ -481,6 +1055,7 @@ int main(void) {
   test_system_chunked_feed();
   test_system_checksum_valid();
   test_system_checksum_invalid();
+  test_system_checksum_incremental();
   test_system_no_checksum();
   test_system_crlf();
   test_system_lf_only();
@@ -495,6 +1070,15 @@ int main(void) {
   test_system_century_from_zda();
   test_system_small_buffer();
   test_system_gps_burst();
+  test_system_feed_reserve();
+  test_system_feed_callback();
+  test_system_in_place_burst();
+  test_system_in_place_wrap();
+  test_system_in_place_overlong();
+  test_system_batch_callback();
+  test_system_lazy_callback();
+  test_system_sentence_filter();
+  test_system_parse_buffer();
 
   TEST_SUMMARY();
 }
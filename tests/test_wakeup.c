@@ -0,0 +1,255 @@
+//
+// unit tests for the blocking consumer wakeup
+//
+
+// needed for clock_gettime and nanosleep with -std=c11
+#define _POSIX_C_SOURCE 200809L
+
+#include "test.h"
+#include "tiny_nmea/tiny_nmea_wakeup.h"
+#include "tiny_nmea/internal/ringbuf.h"
+
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+
+#define WAKEUP_SENTENCES 500
+
+#define RMC_LINE "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n"
+
+static const char *rmc = RMC_LINE;
+// two lines back to back, for feeds that run past the end of one
+static const char rmc_pair[] = RMC_LINE RMC_LINE;
+
+static tiny_nmea_ctx_t ctx;
+static uint8_t ring_buffer[1024];
+static atomic_uint parsed;
+
+static void on_parse(const tiny_nmea_type_t *result, tiny_nmea_parser_statistics_t stats, void *user_data) {
+  (void)result;
+  (void)stats;
+  (void)user_data;
+  atomic_fetch_add(&parsed, 1);
+}
+
+static void reset_ctx(void) {
+  tiny_nmea_init_callbacks(&ctx, ring_buffer, sizeof(ring_buffer), on_parse, NULL, NULL, NULL);
+  atomic_store(&parsed, 0);
+}
+
+static double now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e3 + (double)ts.tv_nsec / 1e6;
+}
+
+static void sleep_ms(long ms) {
+  struct timespec ts = {.tv_sec = ms / 1000, .tv_nsec = (ms % 1000) * 1000000};
+  nanosleep(&ts, NULL);
+}
+
+static bool fd_ready(int fd) {
+  struct pollfd pfd = {.fd = fd, .events = POLLIN, .revents = 0};
+  return poll(&pfd, 1, 0) > 0;
+}
+
+// a full ring drops the tail of a feed, so only feed once it fits
+static void feed_whole(const uint8_t *data, size_t len) {
+  while (ringbuf_free(&ctx.ringbuf) < len) sleep_ms(1);
+  tiny_nmea_feed(&ctx, data, len);
+}
+
+static void test_wakeup_init(void) {
+  TEST_CASE("wakeup init rejects bad args") {
+    reset_ctx();
+    tiny_nmea_wakeup_t w;
+
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_wakeup_init(NULL, &ctx, 1));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_wakeup_init(&w, NULL, 1));
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_wakeup_init(&w, &ctx, sizeof(ring_buffer) + 1));
+
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_init(&w, &ctx, 0));
+    TEST_ASSERT(tiny_nmea_wakeup_fd(&w) >= 0);
+    tiny_nmea_wakeup_deinit(&w);
+    TEST_ASSERT_EQ(TINY_NMEA_INVALID_ARGS, tiny_nmea_wakeup_wait(&w, 0));
+    TEST_ASSERT(ctx.feed_callback == NULL);
+    TEST_PASS();
+  }
+}
+
+static void test_wakeup_timeout(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("wakeup wait times out without data") {
+    reset_ctx();
+    tiny_nmea_wakeup_t w;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_init(&w, &ctx, 1));
+
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TIMEOUT, tiny_nmea_wakeup_wait(&w, 0));
+    const double start = now_ms();
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TIMEOUT, tiny_nmea_wakeup_wait(&w, 20));
+    TEST_ASSERT(now_ms() - start >= 19.0);
+
+    // buffered data ends the wait right away
+    tiny_nmea_feed(&ctx, (const uint8_t *)rmc, strlen(rmc));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_wait(&w, -1));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(1, atomic_load(&parsed));
+
+    tiny_nmea_wakeup_deinit(&w);
+    TEST_PASS();
+  }
+#endif
+}
+
+static void test_wakeup_watermark(void) {
+  TEST_CASE("wakeup waits for the watermark") {
+    reset_ctx();
+    tiny_nmea_wakeup_t w;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_init(&w, &ctx, 100));
+
+    tiny_nmea_feed(&ctx, (const uint8_t *)rmc_pair, 50);
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TIMEOUT, tiny_nmea_wakeup_wait(&w, 10));
+
+    // event loop style, armed below the watermark the fd stays quiet
+    TEST_ASSERT(!tiny_nmea_wakeup_arm(&w));
+    tiny_nmea_feed(&ctx, (const uint8_t *)rmc_pair + 50, 20);
+    TEST_ASSERT(!fd_ready(tiny_nmea_wakeup_fd(&w)));
+
+    // crossing it signals once
+    tiny_nmea_feed(&ctx, (const uint8_t *)rmc_pair + 70, 40);
+    TEST_ASSERT(fd_ready(tiny_nmea_wakeup_fd(&w)));
+    tiny_nmea_wakeup_clear(&w);
+    TEST_ASSERT(!fd_ready(tiny_nmea_wakeup_fd(&w)));
+    tiny_nmea_feed(&ctx, (const uint8_t *)"$", 1);
+    TEST_ASSERT(!fd_ready(tiny_nmea_wakeup_fd(&w)));
+
+    TEST_ASSERT(tiny_nmea_wakeup_arm(&w));
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_wait(&w, 0));
+
+    tiny_nmea_wakeup_deinit(&w);
+    TEST_PASS();
+  }
+}
+
+static void test_wakeup_in_place(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("wakeup ignores the partial sentence in-place framing holds") {
+    reset_ctx();
+    tiny_nmea_set_framing_mode(&ctx, TINY_NMEA_FRAMING_IN_PLACE);
+    tiny_nmea_wakeup_t w;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_init(&w, &ctx, 1));
+
+    // the start of a sentence stays in the ring after the work
+    tiny_nmea_feed(&ctx, (const uint8_t *)rmc, 30);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_wait(&w, 0));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(30, ringbuf_len(&ctx.ringbuf));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TIMEOUT, tiny_nmea_wakeup_wait(&w, 20));
+    TEST_ASSERT(!tiny_nmea_wakeup_arm(&w));
+    TEST_ASSERT(!fd_ready(tiny_nmea_wakeup_fd(&w)));
+
+    // the rest of it does count
+    tiny_nmea_feed(&ctx, (const uint8_t *)rmc + 30, strlen(rmc) - 30);
+    TEST_ASSERT(fd_ready(tiny_nmea_wakeup_fd(&w)));
+    tiny_nmea_wakeup_clear(&w);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_wait(&w, 0));
+    tiny_nmea_work(&ctx);
+    TEST_ASSERT_EQ(1, atomic_load(&parsed));
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TIMEOUT, tiny_nmea_wakeup_wait(&w, 0));
+
+    tiny_nmea_wakeup_deinit(&w);
+    TEST_PASS();
+  }
+#endif
+}
+
+static void *kick_main(void *arg) {
+  sleep_ms(20);
+  tiny_nmea_wakeup_wake(arg);
+  return NULL;
+}
+
+static void test_wakeup_wake(void) {
+  TEST_CASE("wakeup wake ends a wait without data") {
+    reset_ctx();
+    tiny_nmea_wakeup_t w;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_init(&w, &ctx, 1));
+
+    pthread_t kicker;
+    pthread_create(&kicker, NULL, kick_main, &w);
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_wait(&w, -1));
+    pthread_join(kicker, NULL);
+
+    // the kick is used up
+    TEST_ASSERT_EQ(TINY_NMEA_ERR_TIMEOUT, tiny_nmea_wakeup_wait(&w, 0));
+
+    tiny_nmea_wakeup_deinit(&w);
+    TEST_PASS();
+  }
+}
+
+typedef struct {
+  tiny_nmea_wakeup_t *w;
+  atomic_bool stop;
+  unsigned waits;
+} consumer_arg_t;
+
+static void *consumer_main(void *arg) {
+  consumer_arg_t *c = arg;
+  for (;;) {
+    tiny_nmea_wakeup_wait(c->w, -1);
+    const bool stop = atomic_load(&c->stop);
+    tiny_nmea_work(&ctx);
+    c->waits++;
+    if (stop) break;
+  }
+  return NULL;
+}
+
+static void test_wakeup_threads(void) {
+#if TINY_NMEA_ENABLE_RMC
+  TEST_CASE("wakeup blocked consumer sees every feed") {
+    reset_ctx();
+    tiny_nmea_wakeup_t w;
+    TEST_ASSERT_EQ(TINY_NMEA_OK, tiny_nmea_wakeup_init(&w, &ctx, 1));
+
+    consumer_arg_t c = {.w = &w, .waits = 0};
+    atomic_init(&c.stop, false);
+    pthread_t consumer;
+    pthread_create(&consumer, NULL, consumer_main, &c);
+
+    const size_t len = strlen(rmc);
+    for (size_t i = 0; i < WAKEUP_SENTENCES; i++) {
+      // split feeds so the consumer also wakes on partial sentences
+      feed_whole((const uint8_t *)rmc, 30);
+      feed_whole((const uint8_t *)rmc + 30, len - 30);
+      if (i % 50 == 0) sleep_ms(1);
+    }
+
+    atomic_store(&c.stop, true);
+    tiny_nmea_wakeup_wake(&w);
+    pthread_join(consumer, NULL);
+
+    TEST_ASSERT_EQ(WAKEUP_SENTENCES, atomic_load(&parsed));
+    TEST_ASSERT(c.waits > 0);
+
+    tiny_nmea_wakeup_deinit(&w);
+    TEST_PASS();
+  }
+#endif
+}
+
+int main(void) {
+  TEST_TITLE("wakeup tests");
+
+  test_wakeup_init();
+  test_wakeup_timeout();
+  test_wakeup_watermark();
+  test_wakeup_in_place();
+  test_wakeup_wake();
+  test_wakeup_threads();
+
+  TEST_SUMMARY();
+}